@@ -1,4 +1,4 @@
-QT += core gui sql widgets svg network multimedia multimediawidgets serialport charts
+QT += core gui sql widgets svg network multimedia multimediawidgets serialport charts concurrent
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++17
@@ -18,6 +18,10 @@ include(../common/protocol/protocol.pri)
 # 公共日志模块
 include(../common/logging/logging.pri)
 
+# 与音视频模块共用的视频编解码器（录像回放解码分块差分帧）
+SOURCES += ../videoplusplusplus/videocodec.cpp
+HEADERS += ../videoplusplusplus/videocodec.h
+
 # 源文件
 SOURCES += \
     # 主程序入口
@@ -35,6 +39,7 @@ SOURCES += \
     src/presentation/pages/setting_page/setting_page.cpp \
     src/presentation/pages/log_page/audio_pipe.cpp \
     src/presentation/pages/log_page/log_main_window.cpp \
+    src/presentation/pages/log_page/mtr_decoder.cpp \
     src/presentation/pages/log_page/mtr_reader.cpp \
     src/presentation/main_window/home_main_window.cpp \
     src/presentation/utils/theme.cpp \
@@ -70,6 +75,7 @@ HEADERS += \
     src/presentation/pages/setting_page/setting_page.h \
     src/presentation/pages/log_page/audio_pipe.h \
     src/presentation/pages/log_page/log_main_window.h \
+    src/presentation/pages/log_page/mtr_decoder.h \
     src/presentation/pages/log_page/mtr_reader.h \
     src/presentation/main_window/home_main_window.h \
     src/presentation/utils/theme.h \
@@ -170,7 +170,12 @@ bool Ticket::isValid() const
     return id_ > 0 && !title_.isEmpty() && !description_.isEmpty() && creatorId_ > 0;
 }
 
-QString Ticket::getValidationError() const
+bool Ticket::isValidSummary() const
+{
+    return id_ > 0 && !title_.isEmpty() && creatorId_ > 0;
+}
+
+QString Ticket::getValidationError(bool summary) const
 {
     if (id_ <= 0) {
         return "工单ID无效";
@@ -180,7 +185,7 @@ QString Ticket::getValidationError() const
         return "工单标题不能为空";
     }
     
-    if (description_.isEmpty()) {
+    if (!summary && description_.isEmpty()) {
         return "工单描述不能为空";
     }
     
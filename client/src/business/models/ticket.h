@@ -79,7 +79,9 @@ public:
     
     // 验证方法
     bool isValid() const;
-    QString getValidationError() const;
+    // 列表和搜索只返回工单摘要，不含描述（详情另行获取）
+    bool isValidSummary() const;
+    QString getValidationError(bool summary = false) const;
     
     // 状态判断
     bool isCreated() const { return status_ == "created"; }
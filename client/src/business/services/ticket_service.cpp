@@ -5,6 +5,11 @@
 TicketService::TicketService(QObject *parent)
     : QObject(parent)
     , networkClient_(nullptr)
+    , listLimit_(-1)
+    , hasMoreTickets_(false)
+    , listRequestPending_(false)
+    , listRequestSeq_(0)
+    , appendNextList_(false)
 {
     LogManager::getInstance()->info(LogModule::TICKET, LogLayer::BUSINESS, 
                                    "TicketService", "工单服务初始化完成");
@@ -226,6 +231,38 @@ QList<Ticket> TicketService::getAllTickets(int limit, int offset)
     return QList<Ticket>();
 }
 
+bool TicketService::searchTickets(const QString& text, int limit)
+{
+    const QString query = text.trimmed();
+    if (query.isEmpty()) {
+        setError("搜索内容为空");
+        return false;
+    }
+    
+    LogManager::getInstance()->debug(LogModule::TICKET, LogLayer::BUSINESS, 
+                                    "TicketService", QString("搜索工单: %1").arg(query));
+    
+    sendSearchTicketsRequest(query, limit);
+    return listRequestPending_;
+}
+
+bool TicketService::loadMoreTickets()
+{
+    if (!hasMoreTickets_ || listRequestPending_ || nextCursor_.isEmpty()) {
+        return false;
+    }
+    
+    LogManager::getInstance()->debug(LogModule::TICKET, LogLayer::BUSINESS, 
+                                    "TicketService", QString("加载下一页工单，已加载: %1").arg(loadedTickets_.size()));
+    
+    if (!listQuery_.isEmpty()) {
+        sendSearchTicketsRequest(listQuery_, listLimit_, nextCursor_);
+    } else {
+        sendGetTicketListRequest(listStatus_, listLimit_, 0, nextCursor_);
+    }
+    return listRequestPending_;
+}
+
 bool TicketService::updateTicketStatus(const QString& ticketId, const QString& newStatus)
 {
     if (ticketId.isEmpty()) {
@@ -546,7 +583,8 @@ void TicketService::sendGetTicketDetailRequest(const QString& ticketId, int user
                                     "TicketService", QString("获取工单详情请求已发送: 工单ID=%1, 用户ID=%2, 用户类型=%3").arg(ticketId).arg(userId).arg(userType));
 }
 
-void TicketService::sendGetTicketListRequest(const QString& status, int limit, int offset)
+void TicketService::sendGetTicketListRequest(const QString& status, int limit, int offset,
+                                             const QString& cursor)
 {
     if (!networkClient_) {
         setError("网络客户端未初始化");
@@ -565,7 +603,8 @@ void TicketService::sendGetTicketListRequest(const QString& status, int limit, i
     }
     
     // 通过网络客户端发送获取工单列表请求
-    bool success = networkClient_->sendGetTicketListRequest(status, limit, offset);
+    // 列表与搜索共用序号：后发的请求使之前未返回的响应作废
+    bool success = networkClient_->sendGetTicketListRequest(status, limit, offset, cursor, ++listRequestSeq_);
     if (!success) {
         setError("发送获取工单列表请求失败");
         LogManager::getInstance()->error(LogModule::TICKET, LogLayer::BUSINESS, 
@@ -574,10 +613,45 @@ void TicketService::sendGetTicketListRequest(const QString& status, int limit, i
         return;
     }
     
+    // 不带游标的请求是一次新的查询，响应将替换已加载列表
+    listStatus_ = status;
+    listQuery_.clear();
+    listLimit_ = limit;
+    appendNextList_ = !cursor.isEmpty();
+    listRequestPending_ = true;
+    
     LogManager::getInstance()->debug(LogModule::TICKET, LogLayer::BUSINESS, 
                                     "TicketService", "获取工单列表请求已发送");
 }
 
+void TicketService::sendSearchTicketsRequest(const QString& text, int limit, const QString& cursor)
+{
+    if (!networkClient_ || !networkClient_->isConnected()) {
+        setError(networkClient_ ? "未连接到服务器" : "网络客户端未初始化");
+        LogManager::getInstance()->error(LogModule::TICKET, LogLayer::BUSINESS, 
+                                        "TicketService", lastError_);
+        emit ticketListFailed(lastError_);
+        return;
+    }
+    
+    if (!networkClient_->sendSearchTicketsRequest(text, limit, cursor, ++listRequestSeq_)) {
+        setError("发送搜索工单请求失败");
+        LogManager::getInstance()->error(LogModule::TICKET, LogLayer::BUSINESS, 
+                                        "TicketService", "发送搜索工单请求失败");
+        emit ticketListFailed(lastError_);
+        return;
+    }
+    
+    // 搜索结果与列表共用分页状态
+    listQuery_ = text;
+    listLimit_ = limit;
+    appendNextList_ = !cursor.isEmpty();
+    listRequestPending_ = true;
+    
+    LogManager::getInstance()->debug(LogModule::TICKET, LogLayer::BUSINESS, 
+                                    "TicketService", "搜索工单请求已发送");
+}
+
 void TicketService::sendUpdateStatusRequest(const QString& ticketId, const QString& newStatus)
 {
     LogManager::getInstance()->info(LogModule::TICKET, LogLayer::BUSINESS, 
@@ -776,10 +850,30 @@ void TicketService::onGetTicketListResponse(const QJsonObject& response)
     LogManager::getInstance()->debug(LogModule::TICKET, LogLayer::BUSINESS, 
                                     "TicketService", "收到获取工单列表响应");
     
-    // TODO: 解析获取工单列表响应
+    // 搜索发出后才到达的旧列表响应（或反之）不能覆盖当前结果；不带序号的响应来自旧版服务器
+    // 成功响应的序号在顶层，错误响应的序号在 data 中
+    const QJsonValue requestSeq = response.contains("request_seq")
+                                ? response.value("request_seq")
+                                : response.value("data").toObject().value("request_seq");
+    if (!requestSeq.isUndefined() && requestSeq.toInt() != listRequestSeq_) {
+        LogManager::getInstance()->debug(LogModule::TICKET, LogLayer::BUSINESS, 
+                                        "TicketService", QString("丢弃过期的工单列表响应，序号: %1")
+                                        .arg(requestSeq.toInt()));
+        return;
+    }
+    
+    listRequestPending_ = false;
+    
     QList<Ticket> tickets;
     if (parseTicketListResponse(response, tickets)) {
-        emit ticketListReceived(tickets);
+        if (appendNextList_) {
+            loadedTickets_.append(tickets);
+        } else {
+            loadedTickets_ = tickets;
+        }
+        nextCursor_ = response.value("next_cursor").toString();
+        hasMoreTickets_ = response.value("has_more").toBool() && !nextCursor_.isEmpty();
+        emit ticketListReceived(loadedTickets_);
     } else {
         emit ticketListFailed(lastError_);
     }
@@ -927,14 +1021,15 @@ bool TicketService::parseTicketListResponse(const QJsonObject& response, QList<T
                 LogManager::getInstance()->debug(LogModule::TICKET, LogLayer::BUSINESS, 
                                                 "TicketService", QString("解析工单对象: %1").arg(QString(QJsonDocument(ticketObj).toJson())));
                 
+                // 列表行是工单摘要，不含描述
                 Ticket ticket(ticketObj);
-                if (ticket.isValid()) {
+                if (ticket.isValidSummary()) {
                     tickets.append(ticket);
                     LogManager::getInstance()->debug(LogModule::TICKET, LogLayer::BUSINESS, 
                                                     "TicketService", QString("工单验证通过: %1").arg(ticket.getTitle()));
                 } else {
                     LogManager::getInstance()->warning(LogModule::TICKET, LogLayer::BUSINESS, 
-                                                      "TicketService", QString("工单验证失败: %1").arg(ticket.getValidationError()));
+                                                      "TicketService", QString("工单验证失败: %1").arg(ticket.getValidationError(true)));
                 }
             }
         }
@@ -34,6 +34,13 @@ public:
     QList<Ticket> getTicketsByAssignee(int assigneeId, int limit = -1, int offset = 0);
     QList<Ticket> getAllTickets(int limit = -1, int offset = 0);
     
+    // 全文搜索标题/描述/类别，结果按相关度排序，通过 ticketListReceived 发出（可继续 loadMoreTickets）
+    bool searchTickets(const QString& text, int limit = -1);
+    
+    // 分页加载：沿用上一次列表查询的条件请求下一页，结果追加后通过 ticketListReceived 发出
+    bool loadMoreTickets();
+    bool hasMoreTickets() const { return hasMoreTickets_; }
+    
     // 工单状态管理
     bool updateTicketStatus(const QString& ticketId, const QString& newStatus);
     bool closeTicket(const QString& ticketId);
@@ -110,7 +117,9 @@ private:
     void sendDeleteTicketRequest(int ticketId);
     void sendGetTicketRequest(int ticketId);
     void sendGetTicketDetailRequest(const QString& ticketId, int userId, int userType);
-    void sendGetTicketListRequest(const QString& status = QString(), int limit = -1, int offset = 0);
+    void sendGetTicketListRequest(const QString& status = QString(), int limit = -1, int offset = 0,
+                                  const QString& cursor = QString());
+    void sendSearchTicketsRequest(const QString& text, int limit, const QString& cursor = QString());
     void sendUpdateStatusRequest(const QString& ticketId, const QString& newStatus);
     void sendAssignTicketRequest(int ticketId, int assigneeId);
     void sendJoinTicketRequest(const QString& ticketId, const QString& role);
@@ -128,6 +137,17 @@ private:
     // 网络客户端引用
     NetworkClient* networkClient_;
     
+    // 工单列表分页状态
+    QString listStatus_;            // 当前列表的查询条件
+    QString listQuery_;             // 当前列表为搜索结果时的搜索词
+    int listLimit_;
+    QString nextCursor_;            // 服务器返回的下一页游标
+    bool hasMoreTickets_;
+    bool listRequestPending_;
+    int listRequestSeq_;            // 最近一次列表/搜索请求的序号，序号不符的响应已过期，直接丢弃
+    bool appendNextList_;           // 下一个列表响应是否追加到已加载列表
+    QList<Ticket> loadedTickets_;   // 已加载的全部工单
+    
 public:
     // 设置网络客户端
     void setNetworkClient(NetworkClient* client);
@@ -13,6 +13,7 @@ NetworkClient::NetworkClient(QObject *parent)
     , messageHandler_(nullptr)
     , heartbeatTimer_(nullptr)
     , isConnected_(false)
+    , protocolVersion_(ProtocolConstants::PROTOCOL_VERSION_LEGACY)
 {
     // 创建连接管理器
     connectionManager_ = new ConnectionManager(this);
@@ -109,6 +110,7 @@ bool NetworkClient::sendLoginRequest(const QString& username, const QString& pas
                                     QString("准备发送登录请求: 用户名=%1, 用户类型=%2").arg(username).arg(userType));
     
     QJsonObject data = MessageBuilder::buildLoginMessage(username, password, userType);
+    data["protocolVersion"] = ProtocolConstants::PROTOCOL_VERSION;
     
     LogManager::getInstance()->debug(LogModule::NETWORK, LogLayer::NETWORK, "NetworkClient", 
                                     QString("登录消息构建完成: %1").arg(QJsonDocument(data).toJson(QJsonDocument::Compact).constData()));
@@ -121,6 +123,35 @@ bool NetworkClient::sendLoginRequest(const QString& username, const QString& pas
     return result;
 }
 
+bool NetworkClient::sendVideoFrame(const QString& roomId, const MediaFrameHeader& header, const QByteArray& payload)
+{
+    if (protocolVersion_ >= ProtocolConstants::PROTOCOL_VERSION_BINARY_MEDIA) {
+        return connectionManager_->sendPacket(buildMediaPacket(MSG_VIDEO_FRAME_BIN, header, payload));
+    }
+    
+    QJsonObject data = MessageBuilder::buildVideoFrameMessage(roomId, QString::number(header.frameSeq),
+                                                              header.width, header.height, header.fps,
+                                                              header.timestamp, header.isKeyFrame());
+    return connectionManager_->sendMessage(MSG_VIDEO_FRAME, data, payload);
+}
+
+bool NetworkClient::sendAudioFrame(const QString& roomId, const MediaFrameHeader& header, const QByteArray& payload)
+{
+    if (protocolVersion_ >= ProtocolConstants::PROTOCOL_VERSION_BINARY_MEDIA) {
+        return connectionManager_->sendPacket(buildMediaPacket(MSG_AUDIO_FRAME_BIN, header, payload));
+    }
+    
+    QJsonObject data = MessageBuilder::buildAudioFrameMessage(roomId, QString::number(header.frameSeq),
+                                                              int(header.sampleRate), header.channels,
+                                                              header.timestamp);
+    return connectionManager_->sendMessage(MSG_AUDIO_FRAME, data, payload);
+}
+
+int NetworkClient::getProtocolVersion() const
+{
+    return protocolVersion_;
+}
+
 bool NetworkClient::sendRegisterRequest(const QString& username, const QString& password, 
                                        const QString& email, const QString& phone, int userType)
 {
@@ -160,7 +191,8 @@ bool NetworkClient::sendLeaveTicketRequest(const QString& ticketId)
     return sendMessage(MSG_LEAVE_WORKORDER, data);
 }
 
-bool NetworkClient::sendGetTicketListRequest(const QString& status, int limit, int offset)
+bool NetworkClient::sendGetTicketListRequest(const QString& status, int limit, int offset,
+                                             const QString& cursor, int requestSeq)
 {
     QJsonObject data;
     if (!status.isEmpty()) {
@@ -172,10 +204,34 @@ bool NetworkClient::sendGetTicketListRequest(const QString& status, int limit, i
     if (offset > 0) {
         data["offset"] = offset;
     }
+    if (!cursor.isEmpty()) {
+        data["cursor"] = cursor;
+    }
+    if (requestSeq > 0) {
+        data["request_seq"] = requestSeq;
+    }
     data["timestamp"] = QDateTime::currentMSecsSinceEpoch();
     return sendMessage(MSG_LIST_WORKORDERS, data);
 }
 
+bool NetworkClient::sendSearchTicketsRequest(const QString& query, int limit, const QString& cursor,
+                                             int requestSeq)
+{
+    QJsonObject data;
+    data["query"] = query;
+    if (limit > 0) {
+        data["limit"] = limit;
+    }
+    if (!cursor.isEmpty()) {
+        data["cursor"] = cursor;
+    }
+    if (requestSeq > 0) {
+        data["request_seq"] = requestSeq;
+    }
+    data["timestamp"] = QDateTime::currentMSecsSinceEpoch();
+    return sendMessage(MSG_SEARCH_WORKORDERS, data);
+}
+
 bool NetworkClient::sendGetTicketDetailRequest(const QString& ticketId, int userId, int userType)
 {
     QJsonObject data = MessageBuilder::buildGetWorkOrderMessage(ticketId, userId, userType);
@@ -284,6 +340,7 @@ void NetworkClient::logMessage(quint16 type, const QJsonObject& data, bool isOut
         case MSG_LEAVE_WORKORDER: messageType = "离开工单"; break;
         case MSG_UPDATE_WORKORDER: messageType = "更新工单"; break;
         case MSG_LIST_WORKORDERS: messageType = "获取工单列表"; break;
+        case MSG_SEARCH_WORKORDERS: messageType = "搜索工单"; break;
         case MSG_GET_WORKORDER: messageType = "获取工单详情"; break;
         case MSG_DELETE_WORKORDER: messageType = "删除工单"; break;
         case MSG_TEXT: messageType = "文本消息"; break;
@@ -309,6 +366,7 @@ void NetworkClient::onConnected()
 
 void NetworkClient::onDisconnected()
 {
+    protocolVersion_ = ProtocolConstants::PROTOCOL_VERSION_LEGACY;
     isConnected_ = false;
     connectionStatus_ = "已断开";
     stopHeartbeat();
@@ -336,6 +394,10 @@ void NetworkClient::onMessageReceived(quint16 type, const QJsonObject& data, con
     // 根据消息类型分发到相应的信号
     switch (type) {
         case MSG_LOGIN:
+            // 记录服务器协商的协议版本（旧服务器不返回该字段）
+            if (data.value("code").toInt(-1) == 0) {
+                protocolVersion_ = data.value("protocolVersion").toInt(ProtocolConstants::PROTOCOL_VERSION_LEGACY);
+            }
             emit loginResponse(data);
             break;
         case MSG_REGISTER:
@@ -354,6 +416,8 @@ void NetworkClient::onMessageReceived(quint16 type, const QJsonObject& data, con
             emit leaveTicketResponse(data);
             break;
         case MSG_LIST_WORKORDERS:
+        case MSG_SEARCH_WORKORDERS:
+            // 搜索结果与分页列表格式相同，走同一处理流程
             emit getTicketListResponse(data);
             break;
         case MSG_GET_WORKORDER:
@@ -35,13 +35,22 @@ public:
                                const QString& expertUsername, const QJsonObject& deviceInfo = QJsonObject());
     bool sendJoinTicketRequest(const QString& ticketId, const QString& role);
     bool sendLeaveTicketRequest(const QString& ticketId);
-    bool sendGetTicketListRequest(const QString& status = QString(), int limit = -1, int offset = 0);
+    // requestSeq > 0 时随请求发送，服务器在响应中原样带回，用于识别过期的列表响应
+    bool sendGetTicketListRequest(const QString& status = QString(), int limit = -1, int offset = 0,
+                                  const QString& cursor = QString(), int requestSeq = 0);
+    bool sendSearchTicketsRequest(const QString& query, int limit = -1, const QString& cursor = QString(),
+                                  int requestSeq = 0);
     bool sendGetTicketDetailRequest(const QString& ticketId, int userId, int userType);
     bool sendUpdateTicketRequest(const QJsonObject& ticketData);
     bool sendUpdateStatusRequest(const QString& ticketId, const QString& newStatus);
     bool sendAssignTicketRequest(int ticketId, int assigneeId);
     bool sendDeleteTicketRequest(int ticketId);
     
+    // 媒体帧发送：按登录时协商的协议版本选择二进制帧头或JSON帧头
+    bool sendVideoFrame(const QString& roomId, const MediaFrameHeader& header, const QByteArray& payload);
+    bool sendAudioFrame(const QString& roomId, const MediaFrameHeader& header, const QByteArray& payload);
+    int getProtocolVersion() const;
+    
     // 状态查询
     QString getLastError() const;
     QString getConnectionStatus() const;
@@ -104,6 +113,7 @@ private:
     QString lastError_;
     bool isConnected_;
     QString connectionStatus_;
+    int protocolVersion_;  // 登录时协商的协议版本
     
 
 };
@@ -144,6 +144,24 @@ bool ConnectionManager::sendMessage(quint16 type, const QJsonObject& data, const
     }
 }
 
+bool ConnectionManager::sendPacket(const QByteArray& packet)
+{
+    if (!isConnected_ || !socket_) {
+        lastError_ = "未连接到服务器";
+        return false;
+    }
+    
+    // 媒体帧热路径：不记录逐包日志，也不强制flush，由事件循环写出
+    qint64 bytesWritten = socket_->write(packet);
+    if (bytesWritten != packet.size()) {
+        lastError_ = QString("发送数据不完整: %1/%2 字节").arg(bytesWritten).arg(packet.size());
+        LogManager::getInstance()->error(LogModule::NETWORK, LogLayer::NETWORK, "ConnectionManager", lastError_);
+        return false;
+    }
+    
+    return true;
+}
+
 QString ConnectionManager::getLastError() const
 {
     return lastError_;
@@ -211,7 +229,7 @@ void ConnectionManager::setupReconnectTimer()
 
 void ConnectionManager::clearReceiveBuffer()
 {
-    receiveBuffer_.clear();
+    receiveFramer_.clear();
 }
 
 void ConnectionManager::processReceivedData()
@@ -219,7 +237,7 @@ void ConnectionManager::processReceivedData()
     QVector<Packet> packets;
     
     // 使用协议模块解析数据包
-    if (drainPackets(receiveBuffer_, packets)) {
+    if (receiveFramer_.drain(packets)) {
         for (const Packet& packet : packets) {
             // 验证消息
             if (!MessageValidator::validatePacket(packet)) {
@@ -239,6 +257,15 @@ void ConnectionManager::processReceivedData()
                                            .arg(packet.type).arg(toJsonBytes(packet.json).size()).arg(packet.bin.size()));
         }
     }
+    
+    // 包长度非法时数据流已无法继续解析，断开连接（按自动重连设置重新连接）
+    if (receiveFramer_.hasError()) {
+        lastError_ = "收到长度非法的数据包";
+        LogManager::getInstance()->error(LogModule::NETWORK, LogLayer::NETWORK, "ConnectionManager", 
+                                        "收到长度非法的数据包，断开连接");
+        receiveFramer_.clear();
+        socket_->abort();
+    }
 }
 
 void ConnectionManager::logConnectionEvent(const QString& event, const QString& details)
@@ -293,17 +320,14 @@ void ConnectionManager::onSocketError(QAbstractSocket::SocketError error)
 
 void ConnectionManager::onSocketReadyRead()
 {
-    // 读取所有可用数据
-    QByteArray newData = socket_->readAll();
-    if (newData.isEmpty()) {
+    // 读取所有可用数据，直接写入拆包缓冲
+    qint64 received = receiveFramer_.readFrom(socket_);
+    if (received <= 0) {
         return;
     }
     
-    // 追加到接收缓冲区
-    receiveBuffer_.append(newData);
-    
     LogManager::getInstance()->debug(LogModule::NETWORK, LogLayer::NETWORK, "ConnectionManager", 
-                                    QString("接收到 %1 字节数据").arg(newData.size()));
+                                    QString("接收到 %1 字节数据").arg(received));
     
     // 处理接收到的数据
     processReceivedData();
@@ -24,6 +24,7 @@ public:
     
     // 消息发送
     bool sendMessage(quint16 type, const QJsonObject& data, const QByteArray& binary = QByteArray());
+    bool sendPacket(const QByteArray& packet);  // 发送已打包好的数据（如二进制帧头的媒体包）
     
     // 状态查询
     QString getLastError() const;
@@ -70,8 +71,8 @@ private:
     bool isConnected_;
     QString lastError_;
     
-    // 接收缓冲区
-    QByteArray receiveBuffer_;
+    // 接收缓冲区（增量拆包器）
+    PacketFramer receiveFramer_;
     
     // 重连设置
     bool autoReconnectEnabled_;
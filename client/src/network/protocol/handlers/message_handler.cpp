@@ -85,6 +85,7 @@ void MessageHandler::handleMessage(quint16 type, const QJsonObject& data, const
         case MSG_LEAVE_WORKORDER:
         case MSG_UPDATE_WORKORDER:
         case MSG_LIST_WORKORDERS:
+        case MSG_SEARCH_WORKORDERS:
             routeWorkOrderMessage(type, data);
             break;
             
@@ -95,6 +96,8 @@ void MessageHandler::handleMessage(quint16 type, const QJsonObject& data, const
         case MSG_SCREENSHOT:
         case MSG_VIDEO_FRAME:
         case MSG_AUDIO_FRAME:
+        case MSG_VIDEO_FRAME_BIN:
+        case MSG_AUDIO_FRAME_BIN:
         case MSG_VIDEO_CONTROL:
         case MSG_AUDIO_CONTROL:
         case MSG_CONTROL:
@@ -163,6 +166,7 @@ void MessageHandler::routeWorkOrderMessage(quint16 type, const QJsonObject& data
             workOrderHandler_->handleUpdateWorkOrderResponse(data);
             break;
         case MSG_LIST_WORKORDERS:
+        case MSG_SEARCH_WORKORDERS:
             workOrderHandler_->handleListWorkOrdersResponse(data);
             break;
         default:
@@ -198,6 +202,12 @@ void MessageHandler::routeOtherMessage(quint16 type, const QJsonObject& data, co
         case MSG_AUDIO_FRAME:
             otherHandler_->handleAudioFrameMessage(data, binary);
             break;
+        case MSG_VIDEO_FRAME_BIN:
+            otherHandler_->handleBinaryVideoFrame(binary);
+            break;
+        case MSG_AUDIO_FRAME_BIN:
+            otherHandler_->handleBinaryAudioFrame(binary);
+            break;
         case MSG_VIDEO_CONTROL:
             otherHandler_->handleVideoControlMessage(data);
             break;
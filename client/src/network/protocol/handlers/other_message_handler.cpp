@@ -131,6 +131,36 @@ void OtherMessageHandler::handleAudioFrameMessage(const QJsonObject& data, const
                     .arg(roomId).arg(frameId).arg(sampleRate).arg(channels).arg(binary.size()));
 }
 
+void OtherMessageHandler::handleBinaryVideoFrame(const QByteArray& binary)
+{
+    // 定长帧头直接解码，不经过JSON
+    MediaFrameHeader header;
+    if (!decodeMediaHeader(binary.constData(), binary.size(), header)) {
+        LogManager::getInstance()->error(LogModule::NETWORK, LogLayer::NETWORK, "OtherMessageHandler", "视频帧头长度无效");
+        return;
+    }
+    
+    const int payloadSize = binary.size() - ProtocolConstants::MEDIA_HEADER_SIZE;
+    LogManager::getInstance()->debug(LogModule::NETWORK, LogLayer::NETWORK, "OtherMessageHandler", 
+                    QString("收到视频帧: %1 (%2x%3, %4fps, %5%6字节)")
+                    .arg(header.frameSeq).arg(header.width).arg(header.height).arg(header.fps)
+                    .arg(header.isKeyFrame() ? "关键帧, " : "").arg(payloadSize));
+}
+
+void OtherMessageHandler::handleBinaryAudioFrame(const QByteArray& binary)
+{
+    MediaFrameHeader header;
+    if (!decodeMediaHeader(binary.constData(), binary.size(), header)) {
+        LogManager::getInstance()->error(LogModule::NETWORK, LogLayer::NETWORK, "OtherMessageHandler", "音频帧头长度无效");
+        return;
+    }
+    
+    const int payloadSize = binary.size() - ProtocolConstants::MEDIA_HEADER_SIZE;
+    LogManager::getInstance()->debug(LogModule::NETWORK, LogLayer::NETWORK, "OtherMessageHandler", 
+                    QString("收到音频帧: %1 (%2Hz, %3通道, %4字节)")
+                    .arg(header.frameSeq).arg(header.sampleRate).arg(header.channels).arg(payloadSize));
+}
+
 void OtherMessageHandler::handleVideoControlMessage(const QJsonObject& data)
 {
     LogManager::getInstance()->info(LogModule::NETWORK, LogLayer::NETWORK, "OtherMessageHandler", "处理视频控制消息");
@@ -29,6 +29,8 @@ public:
     // 音视频消息处理
     void handleVideoFrameMessage(const QJsonObject& data, const QByteArray& binary);
     void handleAudioFrameMessage(const QJsonObject& data, const QByteArray& binary);
+    void handleBinaryVideoFrame(const QByteArray& binary);  // 协议版本2：二进制帧头 + 负载
+    void handleBinaryAudioFrame(const QByteArray& binary);
     void handleVideoControlMessage(const QJsonObject& data);
     void handleAudioControlMessage(const QJsonObject& data);
     
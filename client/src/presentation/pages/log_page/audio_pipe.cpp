@@ -23,6 +23,11 @@ void AudioPipe1::append(const QByteArray &data) {
     m_buffer.append(data);
 }
 
+void AudioPipe1::clear() {
+    QMutexLocker lock(&m_mutex);
+    m_buffer.clear();
+}
+
 qint64 AudioPipe1::readData(char *data, qint64 maxlen) {
     QMutexLocker lock(&m_mutex);
     if (!m_running || m_buffer.isEmpty()) return 0;
@@ -14,6 +14,7 @@ public:
     void start();
     void stop();
     void append(const QByteArray &data);
+    void clear();   // drop queued audio, e.g. after seeking
 
     qint64 readData(char *data, qint64 maxlen) override;
     qint64 writeData(const char *data, qint64 len) override;
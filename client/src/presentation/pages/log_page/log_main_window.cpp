@@ -22,6 +22,9 @@ LogMainWindow::LogMainWindow(QWidget *parent)
     connect(ui->btnPlay,  &QPushButton::clicked, this, &LogMainWindow::play);
     connect(ui->btnPause, &QPushButton::clicked, this, &LogMainWindow::pause);
     connect(ui->btnStop,  &QPushButton::clicked, this, &LogMainWindow::stopPlayback);
+
+    // 拖动、点击滑块都直接跳转，帧索引让跳转无需顺序扫描
+    connect(ui->slider, &QAbstractSlider::actionTriggered, this, &LogMainWindow::onSliderAction);
 }
 
 LogMainWindow::~LogMainWindow() {
@@ -55,6 +58,7 @@ void LogMainWindow::openFile() {
     connect(m_reader, &MtrReader1::audioChunkReady,  this, &LogMainWindow::onAudioChunk);
     connect(m_reader, &MtrReader1::textMessageReady, this, &LogMainWindow::onTextLine);
     connect(m_reader, &MtrReader1::progress,         this, &LogMainWindow::onProgress);
+    connect(m_reader, &MtrReader1::seeked,           this, &LogMainWindow::onSeeked);
     connect(m_reader, &MtrReader1::errorOccured,     this, &LogMainWindow::onError);
 
     m_reader->openFile(path);
@@ -67,7 +71,7 @@ void LogMainWindow::pause()  { if (m_reader) m_reader->requestPause(true); }
 void LogMainWindow::stopPlayback() {
     if (m_reader) {
         m_reader->requestStop();
-        m_reader->wait(200);
+        m_reader->wait();   // decode tasks read from the reader's file mapping
         m_reader->deleteLater();
         m_reader = nullptr;
     }
@@ -159,10 +163,23 @@ void LogMainWindow::onProgress(quint64 ts) {
         quint64 dur = m_trailerEnd - m_headerStart;
         ui->lblTime->setText(msToHMS(cur) + " / " + msToHMS(dur));
         ui->slider->setRange(0, static_cast<int>(dur));
-        ui->slider->setValue(static_cast<int>(cur));
+        if (!ui->slider->isSliderDown())
+            ui->slider->setValue(static_cast<int>(cur));
     }
 }
 
+void LogMainWindow::onSliderAction(int) {
+    // 时长未知（旧文件尚未读到结束帧）时滑块范围无意义
+    if (!m_reader || !m_headerStart || !m_trailerEnd) return;
+    m_reader->seek(m_headerStart + static_cast<quint64>(ui->slider->sliderPosition()));
+}
+
+void LogMainWindow::onSeeked(quint64) {
+    // 跳转前缓冲的声音和文字已不对应当前位置
+    if (m_pipe) m_pipe->clear();
+    ui->listText->clear();
+}
+
 void LogMainWindow::onError(const QString &msg) {
     QMessageBox::warning(this, tr("Error"), msg);
 }
@@ -34,6 +34,8 @@ private slots:
     void onAudioChunk(const QByteArray &pcm, const QAudioFormat &fmt, quint64 ts);
     void onTextLine(const QString &line, quint64 ts);
     void onProgress(quint64 ts);
+    void onSeeked(quint64 ts);
+    void onSliderAction(int action);
     void onError(const QString &msg);
 
 private:
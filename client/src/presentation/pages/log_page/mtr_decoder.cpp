@@ -0,0 +1,73 @@
+#include "mtr_decoder.h"
+
+#include "../../../../../videoplusplusplus/videocodec.h"
+
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+
+MtrStreamDecoder::MtrStreamDecoder(QThreadPool *pool, MtrDecodeCallback deliver)
+    : m_pool(pool), m_deliver(std::move(deliver)) {}
+
+MtrStreamDecoder::~MtrStreamDecoder() {
+    cancel();
+}
+
+void MtrStreamDecoder::submit(const MtrDecodeJob &job) {
+    QMutexLocker lock(&m_mutex);
+    m_jobs.enqueue(job);
+    if (m_running) return;
+
+    // one drain task per stream at a time keeps the frames of a stream in order
+    m_running = true;
+    QtConcurrent::run(m_pool, [this]() { drain(); });
+}
+
+void MtrStreamDecoder::cancel() {
+    QMutexLocker lock(&m_mutex);
+    m_jobs.clear();
+    while (m_running) m_idle.wait(&m_mutex);
+    m_canvas = QImage();
+    if (m_tileDecoder) m_tileDecoder->reset();
+    m_seedTileDecoder = false;
+}
+
+void MtrStreamDecoder::drain() {
+    for (;;) {
+        MtrDecodeJob job;
+        {
+            QMutexLocker lock(&m_mutex);
+            if (m_jobs.isEmpty()) {
+                m_running = false;
+                m_idle.wakeAll();
+                return;
+            }
+            job = m_jobs.dequeue();
+        }
+
+        const bool ok = decode(job.data, job.codec);
+        // the delivered image shares pixels with the canvas; the next delta detaches it
+        if (!job.silent) m_deliver(job.seq, job.generation, ok ? m_canvas : QImage());
+    }
+}
+
+bool MtrStreamDecoder::decode(const QByteArray &data, quint8 codec) {
+    if (codec != quint8(VideoCodec::TILE_DELTA)) {
+        // v2 recordings may hold other image formats, so let Qt detect it
+        QImage img;
+        if (!img.loadFromData(data)) return false;
+        m_canvas = img.convertToFormat(QImage::Format_RGB32);
+        m_seedTileDecoder = true;
+        return true;
+    }
+
+    if (!m_tileDecoder) m_tileDecoder.reset(new TileDeltaDecoder);
+    // a JPEG reference written when recording started mid-stream precedes the deltas
+    if (m_seedTileDecoder) {
+        m_tileDecoder->setReference(m_canvas);
+        m_seedTileDecoder = false;
+    }
+
+    // drop our reference first so the decoder patches its canvas in place
+    m_canvas = QImage();
+    return m_tileDecoder->decode(data, false, m_canvas);
+}
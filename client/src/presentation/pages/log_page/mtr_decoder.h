@@ -0,0 +1,61 @@
+// MtrDecoder.h
+#ifndef MTRDECODER_H
+#define MTRDECODER_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QMutex>
+#include <QQueue>
+#include <QWaitCondition>
+#include <functional>
+#include <memory>
+
+class QThreadPool;
+class TileDeltaDecoder;
+
+struct MtrDecodeJob {
+    quint64 seq = 0;          // playback order, used by the reader to reorder results
+    quint64 generation = 0;   // bumped on seek so stale results can be dropped
+    QByteArray data;          // may be a raw view into the mapped file
+    quint8 codec = 0;
+    bool silent = false;      // only advance the picture (seek catch-up), deliver nothing
+};
+
+// Called on a pool thread with the picture after the job, or a null image if decoding failed
+using MtrDecodeCallback = std::function<void(quint64 seq, quint64 generation, const QImage &img)>;
+
+// Decodes one stream's video frames on a shared thread pool.
+// Tile-delta frames depend on the previous picture, so jobs of one stream run strictly
+// in order; different streams run in parallel.
+class MtrStreamDecoder {
+public:
+    MtrStreamDecoder(QThreadPool *pool, MtrDecodeCallback deliver);
+    ~MtrStreamDecoder();
+
+    void submit(const MtrDecodeJob &job);
+
+    // Drop queued jobs, wait for the running one and forget the picture
+    void cancel();
+
+private:
+    void drain();
+    // JPEG (codec 0) or tile-delta (codec 1) payload applied to m_canvas
+    bool decode(const QByteArray &data, quint8 codec);
+
+    QThreadPool *m_pool;
+    MtrDecodeCallback m_deliver;
+
+    QMutex m_mutex;
+    QWaitCondition m_idle;
+    QQueue<MtrDecodeJob> m_jobs;
+    bool m_running = false;
+    // only touched by the running drain task, or while idle
+    QImage m_canvas;
+    std::unique_ptr<TileDeltaDecoder> m_tileDecoder;   // the live receiver's decoder (videocodec.h)
+    bool m_seedTileDecoder = false;                     // m_canvas came from a JPEG frame
+
+    MtrStreamDecoder(const MtrStreamDecoder &) = delete;
+    MtrStreamDecoder &operator=(const MtrStreamDecoder &) = delete;
+};
+
+#endif // MTRDECODER_H
@@ -1,12 +1,63 @@
 #include "mtr_reader.h"
+#include "mtr_decoder.h"
 
+#include <QFile>
 #include <QJsonDocument>
-#include <QImage>
+#include <QJsonArray>
 #include <QElapsedTimer>
-#include <QThread>
 #include <QVariant>
+#include <QtEndian>
+#include <algorithm>
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Container layout (videoplusplusplus/videorecorder.h, MtrFormat), little endian
+const quint32 MTR_FOOTER_MAGIC = 0x5852544D; // "MTRX"
+const int MTR_FRAME_HEADER_SIZE = 38;
+const int MTR_INDEX_ENTRY_SIZE = 24;
+const int MTR_FOOTER_SIZE = 16;
+const quint8 MTR_FLAG_KEY_FRAME = 0x01;
+const quint8 MTR_FLAG_SCREEN = 0x02;
+
+// MsgType values used in recordings
+const quint16 MSG_VIDEO_FRAME = 1;
+const quint16 MSG_AUDIO_FRAME = 2;
+const quint16 MSG_SCREEN_FRAME = 7;
+const quint16 MSG_TEXT_MESSAGE = 10;
+const quint16 MSG_RECORD_STOP = 13;
+const quint16 MSG_RECORD_DATA = 14;   // v3 stream declaration
+
+// Pipeline tuning
+const int LOOKAHEAD_FRAMES = 256;         // parsed records queued ahead of the play head
+const int LOOKAHEAD_VIDEO = 16;           // of which video frames (each holds a decoded picture)
+const qint64 LOOKAHEAD_MS = 1000;         // media time parsed ahead of the play head
+const qint64 LATE_DROP_MS = 100;          // a late picture is skipped if a newer one is ready
+const qint64 PREFETCH_BYTES = 8 << 20;    // pages requested ahead of the parse position
+
+bool isVideoType(quint16 type) {
+    return type == MSG_VIDEO_FRAME || type == MSG_SCREEN_FRAME;
+}
+
+bool isJsonType(quint16 type) {
+    return type == MSG_TEXT_MESSAGE || type == MSG_RECORD_STOP || type == MSG_RECORD_DATA;
+}
+
+QByteArray rawView(const uchar *p, qint64 len) {
+    return QByteArray::fromRawData(reinterpret_cast<const char *>(p), int(len));
+}
+
+} // namespace
+
+MtrReader1::MtrReader1(QObject *parent) : QThread(parent) {
+    // one task per stream at most; four stream kinds are recorded
+    m_decodePool.setMaxThreadCount(qBound(2, QThread::idealThreadCount(), 4));
+}
 
-MtrReader1::MtrReader1(QObject *parent) : QThread(parent) {}
 MtrReader1::~MtrReader1() {
     requestStop();
     wait(500);
@@ -24,44 +75,31 @@ void MtrReader1::requestPause(bool p) {
     m_pause = p;
 }
 
-bool MtrReader1::readExact(QFile &f, char *buf, qint64 len) {
-    qint64 got = 0;
-    while (got < len) {
-        qint64 n = f.read(buf + got, len - got);
-        if (n <= 0) return false;
-        got += n;
-    }
+bool MtrReader1::readBytes(qint64 &pos, qint64 len, const uchar *&out) {
+    if (len < 0 || pos < 0 || len > m_size - pos) return false;
+    out = m_data + pos;
+    pos += len;
     return true;
 }
 
-bool MtrReader1::readUint16LE(QFile &f, quint16 &out) {
-    char b[2];
-    if (!readExact(f, b, 2)) return false;
-    out = (quint8)b[0] | (quint16((quint8)b[1]) << 8);
+bool MtrReader1::readUint16LE(qint64 &pos, quint16 &out) {
+    const uchar *p = nullptr;
+    if (!readBytes(pos, 2, p)) return false;
+    out = qFromLittleEndian<quint16>(p);
     return true;
 }
 
-bool MtrReader1::readUint32LE(QFile &f, quint32 &out) {
-    char b[4];
-    if (!readExact(f, b, 4)) return false;
-    out = (quint32(quint8(b[0]))      ) |
-          (quint32(quint8(b[1])) <<  8) |
-          (quint32(quint8(b[2])) << 16) |
-          (quint32(quint8(b[3])) << 24);
+bool MtrReader1::readUint32LE(qint64 &pos, quint32 &out) {
+    const uchar *p = nullptr;
+    if (!readBytes(pos, 4, p)) return false;
+    out = qFromLittleEndian<quint32>(p);
     return true;
 }
 
-bool MtrReader1::readUint64LE(QFile &f, quint64 &out) {
-    char b[8];
-    if (!readExact(f, b, 8)) return false;
-    out = (quint64(quint8(b[0]))      ) |
-          (quint64(quint8(b[1])) <<  8) |
-          (quint64(quint8(b[2])) << 16) |
-          (quint64(quint8(b[3])) << 24) |
-          (quint64(quint8(b[4])) << 32) |
-          (quint64(quint8(b[5])) << 40) |
-          (quint64(quint8(b[6])) << 48) |
-          (quint64(quint8(b[7])) << 56);
+bool MtrReader1::readUint64LE(qint64 &pos, quint64 &out) {
+    const uchar *p = nullptr;
+    if (!readBytes(pos, 8, p)) return false;
+    out = qFromLittleEndian<quint64>(p);
     return true;
 }
 
@@ -77,111 +115,511 @@ bool MtrReader1::parseMeta(const QByteArray &raw, FrameMeta &outMeta, QString &e
     return true;
 }
 
+bool MtrReader1::readFrame(qint64 &pos, MtrFrame &frame, QString &err) {
+    err.clear();
+    if (pos >= m_size) return false;
+    return m_version >= 3 ? readFrameV3(pos, frame, err) : readFrameV2(pos, frame, err);
+}
+
+bool MtrReader1::readFrameV3(qint64 &pos, MtrFrame &frame, QString &err) {
+    const uchar *h = nullptr;
+    if (!readBytes(pos, MTR_FRAME_HEADER_SIZE, h)) { err = "EOF in frame header"; return false; }
+
+    frame.type = qFromLittleEndian<quint16>(h);
+    frame.timestamp = qFromLittleEndian<quint64>(h + 2);
+    frame.stream = qFromLittleEndian<quint16>(h + 10);
+    frame.flags = h[12];
+    frame.codec = h[13];
+    frame.param1 = qFromLittleEndian<quint32>(h + 26);
+    frame.param2 = qFromLittleEndian<quint32>(h + 30);
+    const quint32 dataLen = qFromLittleEndian<quint32>(h + 34);
+
+    const uchar *data = nullptr;
+    if (dataLen > (200u << 20)) { err = "Unreasonable data size"; return false; }
+    if (!readBytes(pos, dataLen, data)) { err = "EOF in data"; return false; }
+    frame.data = rawView(data, dataLen);
+
+    if (isJsonType(frame.type)) frame.json = QJsonDocument::fromJson(frame.data).object();
+    return true;
+}
+
+bool MtrReader1::readFrameV2(qint64 &pos, MtrFrame &frame, QString &err) {
+    quint32 metaLen = 0;
+    quint32 dataLen = 0;
+    const uchar *meta = nullptr;
+    const uchar *data = nullptr;
+
+    if (!readUint16LE(pos, frame.type)) { err = "EOF at frame type"; return false; }
+    if (!readUint64LE(pos, frame.timestamp)) { err = "EOF at timestamp"; return false; }
+    if (!readUint32LE(pos, metaLen))   { err = "EOF at metadataLength"; return false; }
+    if (metaLen > (20u << 20)) { err = "Unreasonable metadata size"; return false; }
+    if (!readBytes(pos, metaLen, meta)) { err = "EOF in metadata"; return false; }
+    if (!readUint32LE(pos, dataLen)) { err = "EOF at dataLength"; return false; }
+    if (dataLen > (200u << 20)) { err = "Unreasonable data size"; return false; }
+    if (!readBytes(pos, dataLen, data)) { err = "EOF in data"; return false; }
+    frame.data = rawView(data, dataLen);
+
+    FrameMeta fm;
+    if (metaLen && !parseMeta(rawView(meta, metaLen), fm, err)) return false;
+    // text messages were written without metadata; their JSON is the payload
+    frame.json = (metaLen == 0 && frame.type == MSG_TEXT_MESSAGE)
+               ? QJsonDocument::fromJson(frame.data).object() : fm.json;
+
+    if (fm.type == "video" || isVideoType(frame.type)) {
+        const QString name = fm.json.value("streamName").toString();
+        const int streamType = fm.json.value("streamType").toInt(-1);
+        const bool isScreen = fm.json.value("isScreen").toBool(frame.type == MSG_SCREEN_FRAME);
+        frame.type = frame.type == MSG_SCREEN_FRAME ? MSG_SCREEN_FRAME : MSG_VIDEO_FRAME;
+        frame.stream = streamIdForName(name, streamType, isScreen);
+        frame.codec = quint8(fm.json.value("codec").toInt(0));
+        frame.flags = (fm.json.value("keyFrame").toBool(true) ? MTR_FLAG_KEY_FRAME : 0)
+                    | (isScreen ? MTR_FLAG_SCREEN : 0);
+        frame.param1 = quint32(fm.json.value("width").toInt());
+        frame.param2 = quint32(fm.json.value("height").toInt());
+    } else if (fm.type == "audio") {
+        frame.param1 = quint32(fm.json.value("sampleRate").toInt(44100));
+        frame.param2 = quint32(fm.json.value("channelCount").toInt(2))
+                     | (quint32(fm.json.value("sampleSize").toInt(16)) << 8);
+    }
+    return true;
+}
+
+void MtrReader1::registerStream(quint16 id, const QJsonObject &declaration) {
+    MtrStream stream;
+    stream.name = declaration.value("name").toString();
+    stream.type = declaration.value("streamType").toInt(-1);
+    stream.isScreen = declaration.value("isScreen").toBool(false);
+    m_streams.insert(id, stream);
+}
+
+quint16 MtrReader1::streamIdForName(const QString &name, int type, bool isScreen) {
+    const QString key = name.isEmpty() ? QString::number(type) : name;
+    auto it = m_streamIdsByName.constFind(key);
+    if (it != m_streamIdsByName.constEnd()) return it.value();
+
+    const quint16 id = quint16(m_streamIdsByName.size());
+    m_streamIdsByName.insert(key, id);
+    MtrStream stream;
+    stream.name = name;
+    stream.type = type;
+    stream.isScreen = isScreen;
+    m_streams.insert(id, stream);
+    return id;
+}
+
+void MtrReader1::emitTrailer(const QJsonObject &trailer) {
+    if (m_trailerSeen) return;
+    m_trailerSeen = true;
+    emit trailerRead(trailer);
+}
+
+bool MtrReader1::loadIndex() {
+    if (m_size < m_framesStart + MTR_FOOTER_SIZE) return false;
+
+    const uchar *footer = m_data + m_size - MTR_FOOTER_SIZE;
+    const quint64 indexOffset = qFromLittleEndian<quint64>(footer);
+    const quint32 count = qFromLittleEndian<quint32>(footer + 8);
+    const quint32 magic = qFromLittleEndian<quint32>(footer + 12);
+    if (magic != MTR_FOOTER_MAGIC || count > (64u << 20)) return false;
+    if (indexOffset < quint64(m_framesStart)
+        || indexOffset + quint64(count) * MTR_INDEX_ENTRY_SIZE + MTR_FOOTER_SIZE != quint64(m_size)) return false;
+
+    m_index.resize(int(count));
+    const uchar *p = m_data + indexOffset;
+    for (MtrIndexEntry &entry : m_index) {
+        entry.timestamp = qFromLittleEndian<quint64>(p);
+        entry.offset = qFromLittleEndian<quint64>(p + 8);
+        entry.type = qFromLittleEndian<quint16>(p + 16);
+        entry.stream = qFromLittleEndian<quint16>(p + 18);
+        entry.flags = p[20];
+        p += MTR_INDEX_ENTRY_SIZE;
+    }
+
+    // the trailer carries every stream declaration, so seeking never depends on having
+    // passed the in-band declarations
+    for (int i = m_index.size() - 1; i >= 0; --i) {
+        if (m_index[i].type != MSG_RECORD_STOP) continue;
+        qint64 pos = qint64(m_index[i].offset);
+        MtrFrame trailer; QString err;
+        if (readFrame(pos, trailer, err)) {
+            for (const QJsonValue &v : trailer.json.value("streams").toArray()) {
+                const QJsonObject declaration = v.toObject();
+                registerStream(quint16(declaration.value("id").toInt()), declaration);
+            }
+            emitTrailer(trailer.json);
+        }
+        break;
+    }
+
+    buildStreamTables();
+    return true;
+}
+
+bool MtrReader1::buildIndexByScan() {
+    m_index.clear();
+
+    qint64 pos = m_framesStart;
+    for (;;) {
+        const qint64 offset = pos;
+        MtrFrame frame; QString err;
+        if (!readFrame(pos, frame, err)) break; // a truncated tail just ends the index
+
+        if (frame.type == MSG_RECORD_DATA) registerStream(frame.stream, frame.json);
+        m_index.append(MtrIndexEntry{frame.timestamp, quint64(offset), frame.type, frame.stream, frame.flags});
+        if (frame.type == MSG_RECORD_STOP) {
+            emitTrailer(frame.json);
+            break;
+        }
+    }
+
+    buildStreamTables();
+    return true;
+}
+
+void MtrReader1::buildStreamTables() {
+    m_streamFrames.clear();
+    m_keyFrames.clear();
+    quint64 lastTimestamp = 0;
+    for (int i = 0; i < m_index.size(); ++i) {
+        MtrIndexEntry &entry = m_index[i];
+        // older writers stamped frames on the producer threads, so file order was not
+        // always timestamp order; clamp to keep the index sorted for seekTo's binary search
+        entry.timestamp = qMax(entry.timestamp, lastTimestamp);
+        lastTimestamp = entry.timestamp;
+        if (!isVideoType(entry.type)) continue;
+        m_streamFrames[entry.stream].append(i);
+        if (entry.flags & MTR_FLAG_KEY_FRAME) m_keyFrames[entry.stream].append(i);
+    }
+}
+
+bool MtrReader1::seekTo(quint64 target, qint64 &parsePos) {
+    if (m_index.isEmpty()) return false;
+
+    // frames are indexed in file order with non-decreasing timestamps (see buildStreamTables)
+    auto at = std::lower_bound(m_index.cbegin(), m_index.cend(), target,
+                               [](const MtrIndexEntry &e, quint64 ts) { return e.timestamp < ts; });
+    const int pos = int(at - m_index.cbegin());
+
+    // Rebuild the picture each stream shows at the target: its decoder replays the records
+    // from the stream's last key frame up to its last frame before the target. Streams
+    // catch up in parallel; only the final picture of each is delivered.
+    cancelDecoding();
+    const quint64 generation = currentGeneration();
+    QVector<int> shown;     // index position of the picture each stream shows
+    QVector<quint64> seqs;
+
+    for (auto it = m_streamFrames.cbegin(); it != m_streamFrames.cend(); ++it) {
+        const QVector<int> &frames = it.value();
+        const auto end = std::lower_bound(frames.cbegin(), frames.cend(), pos);
+        if (end == frames.cbegin()) continue;
+        const int last = *(end - 1);
+
+        const QVector<int> keys = m_keyFrames.value(it.key());
+        const auto key = std::upper_bound(keys.cbegin(), keys.cend(), last);
+        if (key == keys.cbegin()) continue;
+
+        MtrStreamDecoder *decoder = decoderFor(it.key());
+        for (auto i = std::lower_bound(frames.cbegin(), end, *(key - 1)); i != end; ++i) {
+            qint64 framePos = qint64(m_index[*i].offset);
+            MtrFrame frame; QString err;
+            if (!readFrame(framePos, frame, err)) return false;
+
+            MtrDecodeJob job;
+            job.seq = m_nextSeq++;
+            job.generation = generation;
+            job.data = frame.data;
+            job.codec = frame.codec;
+            job.silent = *i != last;
+            decoder->submit(job);
+            if (!job.silent) {
+                shown.append(last);
+                seqs.append(job.seq);
+            }
+        }
+    }
+
+    for (int i = 0; i < shown.size(); ++i) {
+        QImage img;
+        while (!takeResult(seqs[i], img, 50)) {
+            if (m_stop) return false;
+        }
+        const MtrIndexEntry &entry = m_index[shown[i]];
+        if (!img.isNull()) emitVideo(img, entry.timestamp, entry.stream, entry.flags);
+    }
+
+    parsePos = pos < m_index.size() ? qint64(m_index[pos].offset) : m_size;
+    m_prefetchedTo = 0;
+    return true;
+}
+
+void MtrReader1::emitVideo(const QImage &img, quint64 ts, quint16 stream, quint8 flags) {
+    const MtrStream info = m_streams.value(stream);
+    emit videoFrameReady(img, ts, info.name, info.type, (flags & MTR_FLAG_SCREEN) != 0);
+}
+
+void MtrReader1::playFrame(const MtrFrame &frame) {
+    if (frame.type == MSG_AUDIO_FRAME) {
+        QAudioFormat fmt; fmt.setCodec("audio/pcm");
+        fmt.setSampleRate(int(frame.param1));
+        fmt.setChannelCount(int(frame.param2 & 0xff));
+        const int ss = int((frame.param2 >> 8) & 0xff);
+        fmt.setSampleSize(ss);
+        fmt.setByteOrder(QAudioFormat::LittleEndian);
+        fmt.setSampleType(ss == 8 ? QAudioFormat::UnSignedInt : QAudioFormat::SignedInt);
+        // deep copy: the receiver may outlive the mapping
+        emit audioChunkReady(QByteArray(frame.data.constData(), frame.data.size()), fmt, frame.timestamp);
+    } else if (frame.type == MSG_TEXT_MESSAGE) {
+        QString user = frame.json.value("userName").toString();
+        QString content = frame.json.value("content").toString();
+        QString line = QString("[%1] %2: %3").arg(QString::number(frame.timestamp), user, content);
+        emit textMessageReady(line, frame.timestamp);
+    }
+}
+
+bool MtrReader1::scheduleNext(qint64 &parsePos, bool &end, QString &err) {
+    MtrFrame frame;
+    if (!readFrame(parsePos, frame, err)) {
+        end = true; // err is empty at the end of a file without trailer
+        return err.isEmpty();
+    }
+    prefetch(parsePos);
+
+    if (frame.type == MSG_RECORD_STOP) {
+        emitTrailer(frame.json);
+        end = true;
+        return true;
+    }
+    if (frame.type == MSG_RECORD_DATA) {
+        registerStream(frame.stream, frame.json);
+        return true;
+    }
+
+    Scheduled item;
+    item.frame = frame;
+    if (isVideoType(frame.type)) {
+        item.seq = m_nextSeq++;
+        MtrDecodeJob job;
+        job.seq = item.seq;
+        job.generation = currentGeneration();
+        job.data = frame.data;
+        job.codec = frame.codec;
+        decoderFor(frame.stream)->submit(job);
+        item.frame.data.clear();
+        ++m_scheduledVideo;
+    }
+    m_schedule.enqueue(item);
+    return true;
+}
+
+void MtrReader1::prefetch(qint64 pos) {
+    if (pos < m_prefetchedTo) return;
+    m_prefetchedTo = pos + PREFETCH_BYTES / 2;
+#ifdef Q_OS_UNIX
+    // the mapping starts at offset 0, so page-aligned offsets are page-aligned addresses
+    static const qint64 page = qMax<qint64>(4096, sysconf(_SC_PAGESIZE));
+    const qint64 start = pos / page * page;
+    const qint64 len = qMin(PREFETCH_BYTES, m_size - start);
+    if (len > 0) madvise(const_cast<uchar *>(m_data) + start, size_t(len), MADV_WILLNEED);
+#endif
+}
+
+MtrStreamDecoder *MtrReader1::decoderFor(quint16 stream) {
+    MtrStreamDecoder *&decoder = m_decoders[stream];
+    if (!decoder) {
+        decoder = new MtrStreamDecoder(&m_decodePool, [this](quint64 seq, quint64 generation, const QImage &img) {
+            deliverResult(seq, generation, img);
+        });
+    }
+    return decoder;
+}
+
+void MtrReader1::deliverResult(quint64 seq, quint64 generation, const QImage &img) {
+    QMutexLocker lock(&m_resultMutex);
+    if (generation != m_generation) return; // decoded before a seek
+    m_results.insert(seq, img);
+    m_resultReady.wakeAll();
+}
+
+bool MtrReader1::takeResult(quint64 seq, QImage &out, int waitMs) {
+    QMutexLocker lock(&m_resultMutex);
+    if (!m_results.contains(seq) && waitMs > 0) m_resultReady.wait(&m_resultMutex, ulong(waitMs));
+    auto it = m_results.find(seq);
+    if (it == m_results.end()) return false;
+    out = it.value();
+    m_results.erase(it);
+    return true;
+}
+
+bool MtrReader1::hasNewerPicture(quint16 stream) {
+    QMutexLocker lock(&m_resultMutex);
+    for (int i = 1; i < m_schedule.size(); ++i) {
+        const Scheduled &item = m_schedule.at(i);
+        if (isVideoType(item.frame.type) && item.frame.stream == stream) {
+            auto it = m_results.constFind(item.seq);
+            if (it != m_results.constEnd() && !it.value().isNull()) return true;
+        }
+    }
+    return false;
+}
+
+quint64 MtrReader1::currentGeneration() {
+    QMutexLocker lock(&m_resultMutex);
+    return m_generation;
+}
+
+void MtrReader1::cancelDecoding() {
+    {
+        QMutexLocker lock(&m_resultMutex);
+        ++m_generation;
+        m_results.clear();
+    }
+    for (MtrStreamDecoder *decoder : m_decoders) decoder->cancel();
+    m_schedule.clear();
+    m_scheduledVideo = 0;
+}
+
 void MtrReader1::run() {
     m_stop = false;
     m_pause = false;
+    m_trailerSeen = false;
+    m_index.clear();
+    m_streams.clear();
+    m_streamIdsByName.clear();
+    m_schedule.clear();
+    m_scheduledVideo = 0;
+    m_prefetchedTo = 0;
 
     QFile f(m_path);
     if (!f.open(QIODevice::ReadOnly)) {
         emit errorOccured(QString("Failed to open file: %1").arg(m_path));
         return;
     }
+    m_size = f.size();
+    uchar *map = m_size > 0 ? f.map(0, m_size) : nullptr;
+    if (!map) {
+        emit errorOccured(QString("Failed to map file: %1").arg(m_path));
+        return;
+    }
+    m_data = map;
 
     // --- Read FileHeader ---
+    qint64 pos = 0;
     quint32 headerLength = 0;
-    if (!readUint32LE(f, headerLength)) {
+    const uchar *headerRaw = nullptr;
+    QJsonObject headerObj;
+    if (!readUint32LE(pos, headerLength)) {
         emit errorOccured("Corrupt header length");
-        return;
-    }
-    if (headerLength == 0 || headerLength > (50u << 20)) {
+    } else if (headerLength == 0 || headerLength > (50u << 20)) {
         emit errorOccured("Unreasonable header length");
-        return;
-    }
-    QByteArray headerRaw(headerLength, 0);
-    if (!readExact(f, headerRaw.data(), headerRaw.size())) {
+    } else if (!readBytes(pos, headerLength, headerRaw)) {
         emit errorOccured("Failed to read header JSON");
-        return;
+    } else {
+        QJsonParseError pe{};
+        QJsonDocument hdoc = QJsonDocument::fromJson(rawView(headerRaw, headerLength), &pe);
+        if (pe.error != QJsonParseError::NoError || !hdoc.isObject()) {
+            emit errorOccured("Header JSON invalid");
+            headerRaw = nullptr;
+        } else {
+            headerObj = hdoc.object();
+        }
     }
-    QJsonParseError pe{};
-    QJsonDocument hdoc = QJsonDocument::fromJson(headerRaw, &pe);
-    if (pe.error != QJsonParseError::NoError || !hdoc.isObject()) {
-        emit errorOccured("Header JSON invalid");
+    if (!headerRaw) {
+        m_data = nullptr;
+        f.unmap(map);
         return;
     }
-    QJsonObject headerObj = hdoc.object();
     emit headerRead(headerObj);
 
+    // 3.x: binary frame headers and a footer index; 2.x: JSON metadata per frame
+    m_version = qMax(2, headerObj.value("version").toString().section('.', 0, 0).toInt());
+    m_framesStart = pos;
+
+    // v2 files and v3 files cut short (no footer) get their index from one header scan
+    if (!(m_version >= 3 && loadIndex())) buildIndexByScan();
+
     // Timing base
     quint64 baseStart = static_cast<quint64>(headerObj.value("startTime").toDouble(0.0));
     bool haveBase = baseStart != 0;
 
     QElapsedTimer wall; wall.start();
-    quint64 firstTs = 0; // first frame ts observed
-
-    while (!m_stop && !f.atEnd()) {
-        if (m_pause) { QThread::msleep(10); continue; }
-
-        quint16 frameType = 0;
-        quint64 timestamp = 0;
-        quint32 metaLen = 0;
-        quint32 dataLen = 0;
-
-        if (!readUint16LE(f, frameType)) break; // likely EOF
-        if (!readUint64LE(f, timestamp)) { emit errorOccured("EOF at timestamp"); break; }
-        if (!readUint32LE(f, metaLen))   { emit errorOccured("EOF at metadataLength"); break; }
-        if (metaLen > (20u << 20)) { emit errorOccured("Unreasonable metadata size"); break; }
-        QByteArray metaRaw(metaLen, 0);
-        if (!readExact(f, metaRaw.data(), metaRaw.size())) { emit errorOccured("EOF in metadata"); break; }
-        if (!readUint32LE(f, dataLen)) { emit errorOccured("EOF at dataLength"); break; }
-        if (dataLen > (200u << 20)) { emit errorOccured("Unreasonable data size"); break; }
-        QByteArray dataRaw;
-        if (dataLen) {
-            dataRaw.resize(int(dataLen));
-            if (!readExact(f, dataRaw.data(), dataRaw.size())) { emit errorOccured("EOF in data"); break; }
+    bool wasPaused = false;
+    quint64 lastTs = baseStart;
+    qint64 parsePos = m_framesStart;
+    bool parsedEnd = false;
+
+    while (!m_stop) {
+        const qint64 target = m_seekTarget.exchange(-1);
+        if (target >= 0) {
+            if (!seekTo(quint64(target), parsePos)) {
+                if (!m_stop) emit errorOccured("Seek failed");
+                break;
+            }
+            // pace from the new position
+            parsedEnd = false;
+            baseStart = lastTs = quint64(target);
+            haveBase = true;
+            wall.restart();
+            emit seeked(lastTs);
+            emit progress(lastTs);
+            continue;
         }
 
-        // Trailer? (frameType == 13)
-        if (frameType == 13) {
-            QString err; FrameMeta fm;
-            if (!parseMeta(metaRaw, fm, err)) { emit errorOccured(err); break; }
-            emit trailerRead(fm.json);
-            break;
+        if (m_pause) { wasPaused = true; QThread::msleep(10); continue; }
+        if (wasPaused) {
+            // resume where playback stopped instead of racing to catch up
+            wasPaused = false;
+            baseStart = lastTs;
+            wall.restart();
         }
 
-        QString err; FrameMeta fm;
-        if (!parseMeta(metaRaw, fm, err)) { emit errorOccured(err); break; }
-        if (firstTs == 0) firstTs = timestamp;
-        if (!haveBase) baseStart = firstTs; // fallback to first frame time
+        // Prefetch: parse ahead of the play head and start decoding
+        QString err;
+        const double horizon = double(LOOKAHEAD_MS) * m_speed;
+        while (!parsedEnd && m_schedule.size() < LOOKAHEAD_FRAMES && m_scheduledVideo < LOOKAHEAD_VIDEO
+               && (m_schedule.isEmpty() || !haveBase
+                   || double(qint64(m_schedule.last().frame.timestamp - baseStart))
+                      < double(wall.elapsed()) * m_speed + horizon)) {
+            if (!scheduleNext(parsePos, parsedEnd, err)) break;
+            if (!haveBase && !m_schedule.isEmpty()) { // fallback to first frame time
+                baseStart = m_schedule.head().frame.timestamp;
+                haveBase = true;
+                wall.restart();
+            }
+        }
+        if (!err.isEmpty()) { emit errorOccured(err); break; }
 
-        // realtime pacing against wall clock
-        qint64 logicalMs = qint64(double(timestamp - baseStart) / m_speed);
-        qint64 nowMs = wall.elapsed();
-        if (logicalMs > nowMs) QThread::msleep(quint32(qMin<qint64>(logicalMs - nowMs, 50)));
+        if (m_schedule.isEmpty()) {
+            if (parsedEnd) QThread::msleep(20); // stay open for seeking until stopped
+            continue;
+        }
 
-        if (fm.type == "video") {
-            const QString streamName = fm.json.value("streamName").toString();
-            const int streamType = fm.json.value("streamType").toInt(-1);
-            const bool isScreen = fm.json.value("isScreen").toBool(false);
+        // Reorder: emit the head in file order once it is due and, for video, decoded
+        const Scheduled &head = m_schedule.head();
+        const qint64 dueMs = qint64(double(qint64(head.frame.timestamp - baseStart)) / m_speed);
+        const qint64 nowMs = wall.elapsed();
+        if (dueMs > nowMs) { QThread::msleep(quint32(qMin<qint64>(dueMs - nowMs, 10))); continue; }
 
+        if (isVideoType(head.frame.type)) {
             QImage img;
-            img.loadFromData(dataRaw, "JPG"); // assume JPEG still image
-            if (!img.isNull()) emit videoFrameReady(img, timestamp, streamName, streamType, isScreen);
-        } else if (fm.type == "audio") {
-            QAudioFormat fmt; fmt.setCodec("audio/pcm");
-            fmt.setSampleRate(fm.json.value("sampleRate").toInt(44100));
-            fmt.setChannelCount(fm.json.value("channelCount").toInt(2));
-            int ss = fm.json.value("sampleSize").toInt(16);
-            fmt.setSampleSize(ss);
-            fmt.setByteOrder(QAudioFormat::LittleEndian);
-            fmt.setSampleType(ss == 8 ? QAudioFormat::UnSignedInt : QAudioFormat::SignedInt);
-            emit audioChunkReady(dataRaw, fmt, timestamp);
-        } else if (fm.type == "text") {
-            QString user = fm.json.value("userName").toString();
-            QString content = fm.json.value("content").toString();
-            QString line = QString("[%1] %2: %3").arg(QString::number(timestamp), user, content);
-            emit textMessageReady(line, timestamp);
+            if (!takeResult(head.seq, img, 5)) continue; // still decoding
+            const Scheduled item = m_schedule.dequeue();
+            --m_scheduledVideo;
+            // behind schedule: skip pictures that a ready newer one would replace at once
+            if (!img.isNull() && !(nowMs - dueMs > LATE_DROP_MS && hasNewerPicture(item.frame.stream)))
+                emitVideo(img, item.frame.timestamp, item.frame.stream, item.frame.flags);
+            lastTs = item.frame.timestamp;
+        } else {
+            const Scheduled item = m_schedule.dequeue();
+            playFrame(item.frame);
+            lastTs = item.frame.timestamp;
         }
-
-        emit progress(timestamp);
+        emit progress(lastTs);
     }
+
+    // decoders read straight from the mapping
+    cancelDecoding();
+    qDeleteAll(m_decoders);
+    m_decoders.clear();
+    m_data = nullptr;
+    f.unmap(map);
 }
@@ -3,16 +3,55 @@
 #define MTRREADER_H
 
 #include <QThread>
-#include <QFile>
+#include <QThreadPool>
 #include <QJsonObject>
 #include <QAudioFormat>
+#include <QHash>
+#include <QImage>
+#include <QMutex>
+#include <QQueue>
+#include <QVector>
+#include <QWaitCondition>
 #include <atomic>
 
+class MtrStreamDecoder;
+
 struct FrameMeta {
     QString type; // "video" | "audio" | "text"
     QJsonObject json;
 };
 
+// One frame record, normalized from either container version
+struct MtrFrame {
+    quint16 type = 0;          // MsgType
+    quint64 timestamp = 0;     // wall clock when the frame was written (ms)
+    quint16 stream = 0xFFFF;   // stream id from the file (v3) or assigned while reading (v2)
+    quint8 flags = 0;          // key frame / screen
+    quint8 codec = 0;
+    quint32 param1 = 0;        // video width, audio sample rate
+    quint32 param2 = 0;        // video height, audio channels | sample bits << 8
+    QJsonObject json;          // v2 metadata, or the JSON payload of text/stream/trailer records
+    QByteArray data;           // raw view into the mapped file
+};
+
+struct MtrStream {
+    QString name;
+    int type = -1;
+    bool isScreen = false;
+};
+
+// Frame index entry: read from the v3 footer, or built by one header scan for older files
+struct MtrIndexEntry {
+    quint64 timestamp;
+    quint64 offset;
+    quint16 type;
+    quint16 stream;
+    quint8 flags;
+};
+
+// Playback engine: the file is memory-mapped and parsed ahead of the play head, video frames
+// are decoded on a thread pool (streams in parallel, each stream in order), and this thread
+// emits every frame in file order when it is due.
 class MtrReader1 : public QThread {
     Q_OBJECT
 public:
@@ -24,6 +63,10 @@ public:
     void requestPause(bool p);
     void setSpeed(double s) { m_speed = s <= 0 ? 1.0 : s; }
 
+    // Jump to an absolute timestamp (ms, same clock as header startTime); any thread,
+    // the latest request wins
+    void seek(quint64 ts) { m_seekTarget = qint64(ts); }
+
 signals:
     void headerRead(QJsonObject header);
     void trailerRead(QJsonObject trailer);
@@ -34,23 +77,83 @@ signals:
     void textMessageReady(const QString &line, quint64 ts);
 
     void progress(quint64 lastTs);
+    void seeked(quint64 ts);
     void errorOccured(const QString &msg);
 
 protected:
     void run() override;
 
 private:
-    bool readExact(QFile &f, char *buf, qint64 len);
-    bool readUint16LE(QFile &f, quint16 &out);
-    bool readUint32LE(QFile &f, quint32 &out);
-    bool readUint64LE(QFile &f, quint64 &out);
+    // A parsed frame waiting for its due time; video frames wait for their decode result
+    struct Scheduled {
+        quint64 seq = 0;
+        MtrFrame frame;
+    };
+
+    // Bounds-checked reads from the mapped file, advancing pos
+    bool readBytes(qint64 &pos, qint64 len, const uchar *&out);
+    bool readUint16LE(qint64 &pos, quint16 &out);
+    bool readUint32LE(qint64 &pos, quint32 &out);
+    bool readUint64LE(qint64 &pos, quint64 &out);
 
     bool parseMeta(const QByteArray &raw, FrameMeta &outMeta, QString &err);
 
+    // Returns false at end of file (err empty) or on a corrupt record (err set)
+    bool readFrame(qint64 &pos, MtrFrame &frame, QString &err);
+    bool readFrameV2(qint64 &pos, MtrFrame &frame, QString &err);
+    bool readFrameV3(qint64 &pos, MtrFrame &frame, QString &err);
+
+    bool loadIndex();
+    bool buildIndexByScan();
+    void buildStreamTables();
+    bool seekTo(quint64 target, qint64 &parsePos);
+
+    void registerStream(quint16 id, const QJsonObject &declaration);
+    quint16 streamIdForName(const QString &name, int type, bool isScreen);
+    void emitTrailer(const QJsonObject &trailer);
+    void emitVideo(const QImage &img, quint64 ts, quint16 stream, quint8 flags);
+    void playFrame(const MtrFrame &frame);
+
+    // Parse the next record at parsePos into the schedule and hand video to its decoder
+    bool scheduleNext(qint64 &parsePos, bool &end, QString &err);
+    void prefetch(qint64 pos);
+
+    MtrStreamDecoder *decoderFor(quint16 stream);
+    void deliverResult(quint64 seq, quint64 generation, const QImage &img);
+    bool takeResult(quint64 seq, QImage &out, int waitMs);
+    bool hasNewerPicture(quint16 stream);
+    quint64 currentGeneration();
+    void cancelDecoding();
+
     QString m_path;
     std::atomic_bool m_stop{false};
     std::atomic_bool m_pause{false};
+    std::atomic<qint64> m_seekTarget{-1};
     double m_speed = 1.0;
+
+    const uchar *m_data = nullptr;   // mapped file, valid while run() executes
+    qint64 m_size = 0;
+    qint64 m_prefetchedTo = 0;
+
+    int m_version = 2;
+    qint64 m_framesStart = 0;
+    bool m_trailerSeen = false;
+    QVector<MtrIndexEntry> m_index;
+    QHash<quint16, QVector<int>> m_streamFrames; // stream -> positions of its video frames in m_index
+    QHash<quint16, QVector<int>> m_keyFrames;    // stream -> positions of its key frames in m_index
+    QHash<quint16, MtrStream> m_streams;
+    QHash<QString, quint16> m_streamIdsByName;   // v2 files have no stream ids
+
+    QThreadPool m_decodePool;
+    QHash<quint16, MtrStreamDecoder *> m_decoders;
+    QQueue<Scheduled> m_schedule;
+    int m_scheduledVideo = 0;
+    quint64 m_nextSeq = 0;
+
+    QMutex m_resultMutex;
+    QWaitCondition m_resultReady;
+    QHash<quint64, QImage> m_results;            // seq -> decoded picture (null if it failed)
+    quint64 m_generation = 0;                    // guarded by m_resultMutex
 };
 
 #endif // MTRREADER_H
@@ -10,12 +10,15 @@
 #include <QFile>
 #include <QCoreApplication>
 #include <QTimer>
+#include <QScrollBar>
+#include <QLineEdit>
 
 #include <QDebug>
 
 TicketPage::TicketPage(const QString& name, bool isExpert, QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::TicketPage)
+    , loadingMore_(false)
     , name(name)
     , isExpert(isExpert)
     , ticketService_(nullptr)
@@ -26,6 +29,20 @@ TicketPage::TicketPage(const QString& name, bool isExpert, QWidget *parent)
     ui->btnAdd->setVisible(!isExpert);
     layout()->activate();
 
+    // 回车搜索，清空搜索框后恢复完整列表
+    connect(ui->searchEdit, &QLineEdit::returnPressed, this, [this]() {
+        searchTicket(this->isExpert, this->name);
+    });
+    connect(ui->searchEdit, &QLineEdit::textChanged, this, [this](const QString& text) {
+        if (text.isEmpty()) {
+            searchTicket(this->isExpert, this->name);
+        }
+    });
+
+    // 滚动到底部时加载下一页
+    connect(ui->ticketListWidget->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &TicketPage::onTicketListScrolled);
+
     // 初始时不自动搜索，等待TicketService设置后再搜索
 }
 
@@ -99,6 +116,7 @@ void TicketPage::searchTicket(bool isExpert, const QString& name){
     
     showLoading(true);
     ui->ticketListWidget->clear();
+    loadingMore_ = false;
     
     // 获取当前用户ID
     int userId = getCurrentUserId();
@@ -113,6 +131,13 @@ void TicketPage::searchTicket(bool isExpert, const QString& name){
         return;
     }
     
+    // 搜索框有内容时由服务器全文检索（范围与列表相同），否则获取完整列表
+    const QString searchText = ui->searchEdit->text().trimmed();
+    if (!searchText.isEmpty()) {
+        ticketService_->searchTickets(searchText);
+        return;
+    }
+    
     // 根据用户类型和名称获取工单列表
     if (!isExpert) {
         // 工厂用户：获取自己创建的工单
@@ -128,15 +153,35 @@ void TicketPage::searchTicket(bool isExpert, const QString& name){
 void TicketPage::onTicketListReceived(const QList<Ticket>& tickets)
 {
     showLoading(false);
-    ui->ticketListWidget->clear();
     
-    for (const Ticket& ticket : tickets) {
-        createTicketDialog(ticket);
+    // 下一页响应携带已加载的全部工单，只创建新增部分
+    int first = 0;
+    if (loadingMore_ && ui->ticketListWidget->count() <= tickets.size()) {
+        first = ui->ticketListWidget->count();
+    } else {
+        ui->ticketListWidget->clear();
+    }
+    loadingMore_ = false;
+    
+    for (int i = first; i < tickets.size(); ++i) {
+        createTicketDialog(tickets.at(i));
     }
 }
 
+void TicketPage::onTicketListScrolled(int value)
+{
+    QScrollBar* scrollBar = ui->ticketListWidget->verticalScrollBar();
+    if (loadingMore_ || !ticketService_ || value < scrollBar->maximum()
+        || !ticketService_->hasMoreTickets()) {
+        return;
+    }
+    
+    loadingMore_ = ticketService_->loadMoreTickets();
+}
+
 void TicketPage::onTicketListFailed(const QString& error)
 {
+    loadingMore_ = false;
     showLoading(false);
     QMessageBox::warning(this, "错误", QString("获取工单列表失败: %1").arg(error));
 }
@@ -40,6 +40,7 @@ private slots:
     // 工单服务响应处理
     void onTicketListReceived(const QList<Ticket>& tickets);
     void onTicketListFailed(const QString& error);
+    void onTicketListScrolled(int value);
     void onTicketDetailReceived(const Ticket& ticket);
     void onTicketDetailFailed(const QString& error);
     void onTicketDeleted(int ticketId);
@@ -55,6 +56,7 @@ private slots:
 
 private:
     Ui::TicketPage *ui;
+    bool loadingMore_;    // 正在加载下一页，响应到达时只追加新工单
 
     QStackedWidget *stackedWidget;
     TicketDialog *dialog;
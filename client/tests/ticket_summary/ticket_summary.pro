@@ -0,0 +1,18 @@
+QT += testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TEMPLATE = app
+
+TARGET = tst_ticket_summary
+
+INCLUDEPATH += ../../src/business/models
+
+SOURCES += \
+    tst_ticket_summary.cpp \
+    ../../src/business/models/ticket.cpp
+
+HEADERS += \
+    ../../src/business/models/ticket.h
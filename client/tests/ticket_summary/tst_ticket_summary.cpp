@@ -0,0 +1,69 @@
+#include <QtTest>
+#include "ticket.h"
+
+// 工单列表/搜索返回的摘要行（与服务端 WorkOrderSummary::toJson 一致，不含 description）
+class TicketSummaryTest : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QJsonObject summaryRow()
+    {
+        QJsonObject row;
+        row["id"] = 42;
+        row["ticket_id"] = "WO-20260101-0042";
+        row["title"] = "产线三号机振动异常";
+        row["creator_id"] = 7;
+        row["status"] = "assigned";
+        row["priority"] = "high";
+        row["category"] = "设备故障";
+        row["assigned_to"] = 9;
+        row["created_at"] = "2026-01-01T08:30:00";
+        row["updated_at"] = "2026-01-01T09:00:00";
+        return row;
+    }
+
+private slots:
+    void parsesSummaryRow()
+    {
+        const Ticket ticket(summaryRow());
+
+        QCOMPARE(ticket.getId(), 42);
+        QCOMPARE(ticket.getTicketId(), QString("WO-20260101-0042"));
+        QCOMPARE(ticket.getTitle(), QString("产线三号机振动异常"));
+        QCOMPARE(ticket.getCreatorId(), 7);
+        QCOMPARE(ticket.getAssigneeId(), 9);
+        QCOMPARE(ticket.getStatus(), QString("assigned"));
+        QCOMPARE(ticket.getPriority(), QString("high"));
+        QCOMPARE(ticket.getCreatedTime(), QDateTime(QDate(2026, 1, 1), QTime(8, 30)));
+        QVERIFY(ticket.getDescription().isEmpty());
+        QVERIFY(!ticket.getClosedTime().isValid());
+    }
+
+    void summaryRowIsValidWithoutDescription()
+    {
+        const Ticket ticket(summaryRow());
+
+        QVERIFY(ticket.isValidSummary());
+        QVERIFY(ticket.getValidationError(true).isEmpty());
+        // 完整工单仍要求描述
+        QVERIFY(!ticket.isValid());
+    }
+
+    void summaryRowRequiresTitleAndCreator()
+    {
+        QJsonObject row = summaryRow();
+        row.remove("title");
+        QVERIFY(!Ticket(row).isValidSummary());
+        QCOMPARE(Ticket(row).getValidationError(true), QString("工单标题不能为空"));
+
+        row = summaryRow();
+        row["creator_id"] = 0;
+        QVERIFY(!Ticket(row).isValidSummary());
+        QCOMPARE(Ticket(row).getValidationError(true), QString("创建者ID无效"));
+    }
+};
+
+QTEST_APPLESS_MAIN(TicketSummaryTest)
+
+#include "tst_ticket_summary.moc"
@@ -0,0 +1,245 @@
+#include "async_log_backend.h"
+#include "../managers/log_manager.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+
+// ---------------- LogRingBuffer ----------------
+
+LogRingBuffer::LogRingBuffer(int capacity)
+    : mask_(0)
+    , enqueuePos_(0)
+    , dequeuePos_(0)
+{
+    size_t size = 2;
+    while (size < size_t(qMax(capacity, 2))) {
+        size <<= 1;
+    }
+    mask_ = size - 1;
+
+    slots_.reset(new Slot[size]);
+    for (size_t i = 0; i < size; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool LogRingBuffer::tryPush(LogRecord &record)
+{
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot &slot = slots_[pos & mask_];
+        const size_t seq = slot.sequence.load(std::memory_order_acquire);
+        const intptr_t diff = intptr_t(seq) - intptr_t(pos);
+
+        if (diff == 0) {
+            // 槽位空闲，抢占写入位置
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.record = std::move(record);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // 写线程尚未取走该槽位：队列已满
+            return false;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool LogRingBuffer::tryPop(LogRecord &record)
+{
+    Slot &slot = slots_[dequeuePos_ & mask_];
+    const size_t seq = slot.sequence.load(std::memory_order_acquire);
+    if (intptr_t(seq) - intptr_t(dequeuePos_ + 1) < 0) {
+        return false;
+    }
+
+    record = std::move(slot.record);
+    slot.record = LogRecord();
+    slot.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+    ++dequeuePos_;
+    return true;
+}
+
+bool LogRingBuffer::isEmpty() const
+{
+    const Slot &slot = slots_[dequeuePos_ & mask_];
+    return intptr_t(slot.sequence.load(std::memory_order_acquire)) - intptr_t(dequeuePos_ + 1) < 0;
+}
+
+// ---------------- AsyncLogBackend ----------------
+
+AsyncLogBackend::AsyncLogBackend(const AsyncLogOptions &options, ConsoleLogger *console,
+                                 FileLogger *file, QObject *parent)
+    : QThread(parent)
+    , options_(options)
+    , queue_(options.capacity)
+    , consoleLogger_(console)
+    , fileLogger_(file)
+    , stopping_(false)
+    , writerSleeping_(false)
+    , droppedPending_(0)
+    , droppedTotal_(0)
+    , cachedSecond_(-1)
+{
+    setObjectName("async-log-writer");
+}
+
+AsyncLogBackend::~AsyncLogBackend()
+{
+    stop();
+}
+
+bool AsyncLogBackend::submit(LogLevel level, LogModule module, LogLayer layer,
+                             const QString &context, const QString &message)
+{
+    LogRecord record;
+    record.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    record.level = level;
+    record.module = module;
+    record.layer = layer;
+    record.context = context;
+    record.message = message;
+
+    const bool mayDrop = options_.overflowPolicy == LogOverflowPolicy::DROP
+                      && level < LogLevel::WARNING;
+
+    while (!queue_.tryPush(record)) {
+        if (mayDrop || stopping_.load(std::memory_order_acquire)) {
+            droppedPending_.fetch_add(1, std::memory_order_relaxed);
+            droppedTotal_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        // 等待写线程腾出空位
+        wakeWriter();
+        QThread::yieldCurrentThread();
+    }
+
+    wakeWriter();
+    return true;
+}
+
+void AsyncLogBackend::wakeWriter()
+{
+    // 与写线程的休眠检查配对，保证不会错过唤醒
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writerSleeping_.load(std::memory_order_relaxed)) {
+        QMutexLocker locker(&wakeMutex_);
+        wakeCondition_.wakeOne();
+    }
+}
+
+void AsyncLogBackend::stop()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    stopping_.store(true, std::memory_order_release);
+    {
+        QMutexLocker locker(&wakeMutex_);
+        wakeCondition_.wakeOne();
+    }
+    wait();
+}
+
+void AsyncLogBackend::run()
+{
+    QString batch;
+    batch.reserve(options_.flushBytes);
+
+    QElapsedTimer sinceFlush;
+    sinceFlush.start();
+
+    LogRecord record;
+    for (;;) {
+        // 一次最多处理一个队列容量，避免持续高负载下迟迟不刷新
+        int drained = 0;
+        while (drained < queue_.capacity() && queue_.tryPop(record)) {
+            appendRecord(record, batch);
+            ++drained;
+        }
+        appendDroppedNotice(batch);
+
+        const bool stopping = stopping_.load(std::memory_order_acquire);
+        if (!batch.isEmpty()
+            && (batch.size() >= options_.flushBytes
+                || sinceFlush.elapsed() >= options_.flushIntervalMs
+                || stopping)) {
+            flushBatch(batch);
+            sinceFlush.restart();
+        }
+
+        if (!queue_.isEmpty()) {
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+
+        // 队列为空：休眠到下一次刷新时间点或被生产者唤醒
+        const qint64 remaining = batch.isEmpty()
+                               ? options_.flushIntervalMs
+                               : qMax<qint64>(1, options_.flushIntervalMs - sinceFlush.elapsed());
+        QMutexLocker locker(&wakeMutex_);
+        writerSleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (queue_.isEmpty() && !stopping_.load(std::memory_order_acquire)) {
+            wakeCondition_.wait(&wakeMutex_, static_cast<unsigned long>(remaining));
+        }
+        writerSleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    appendDroppedNotice(batch);
+    if (!batch.isEmpty()) {
+        flushBatch(batch);
+    }
+}
+
+void AsyncLogBackend::appendRecord(const LogRecord &record, QString &batch)
+{
+    const QString line = LoggerBase::formatLine(formatTimestamp(record.timestampMs),
+                                                record.module, record.layer,
+                                                record.context, record.message);
+    if (consoleLogger_) {
+        consoleLogger_->outputLog(record.level, line);
+    }
+    batch += line;
+    batch += QLatin1Char('\n');
+}
+
+void AsyncLogBackend::appendDroppedNotice(QString &batch)
+{
+    const quint64 dropped = droppedPending_.exchange(0, std::memory_order_relaxed);
+    if (dropped == 0) {
+        return;
+    }
+
+    LogRecord notice;
+    notice.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    notice.level = LogLevel::WARNING;
+    notice.module = LogModule::SYSTEM;
+    notice.layer = LogLayer::BUSINESS;
+    notice.context = "AsyncLog";
+    notice.message = QString("日志队列已满，丢弃 %1 条日志").arg(dropped);
+    appendRecord(notice, batch);
+}
+
+void AsyncLogBackend::flushBatch(QString &batch)
+{
+    FileLogger *file = fileLogger_.load(std::memory_order_acquire);
+    if (file) {
+        file->writeBatch(batch);
+    }
+    batch.clear();
+}
+
+QString AsyncLogBackend::formatTimestamp(qint64 timestampMs)
+{
+    const qint64 second = timestampMs / 1000;
+    if (second != cachedSecond_) {
+        cachedSecond_ = second;
+        cachedSecondText_ = QDateTime::fromMSecsSinceEpoch(second * 1000).toString("yyyy-MM-dd hh:mm:ss");
+    }
+    return QString("%1.%2").arg(cachedSecondText_).arg(int(timestampMs % 1000), 3, 10, QLatin1Char('0'));
+}
@@ -0,0 +1,119 @@
+#ifndef ASYNC_LOG_BACKEND_H
+#define ASYNC_LOG_BACKEND_H
+
+#include "../base/logger_base.h"
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
+
+class ConsoleLogger;
+class FileLogger;
+
+// 队列满时的处理策略
+enum class LogOverflowPolicy {
+    DROP,   // 丢弃DEBUG/INFO并计数；WARNING及以上仍等待空位，保证错误日志不丢
+    BLOCK   // 所有级别都等待空位
+};
+
+// 异步日志参数
+struct AsyncLogOptions {
+    int capacity = 8192;                        // 环形队列容量（向上取2的幂）
+    LogOverflowPolicy overflowPolicy = LogOverflowPolicy::DROP;
+    int flushBytes = 64 * 1024;                 // 批量缓冲达到该大小即写出
+    int flushIntervalMs = 200;                  // 或距上次写出超过该时间
+};
+
+// 一条日志记录：生产者只拷贝（隐式共享的）字符串和时间戳，格式化在写线程完成
+struct LogRecord {
+    qint64 timestampMs = 0;
+    LogLevel level = LogLevel::INFO;
+    LogModule module = LogModule::SYSTEM;
+    LogLayer layer = LogLayer::BUSINESS;
+    QString context;
+    QString message;
+};
+
+// 有界多生产者单消费者环形队列（Vyukov算法，每个槽位带序号）
+class LogRingBuffer
+{
+public:
+    explicit LogRingBuffer(int capacity);
+
+    // 任意线程；队列满时返回false且不移动record
+    bool tryPush(LogRecord &record);
+
+    // 仅写线程
+    bool tryPop(LogRecord &record);
+    bool isEmpty() const;
+
+    int capacity() const { return int(mask_ + 1); }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> enqueuePos_;
+    alignas(64) size_t dequeuePos_;
+
+    LogRingBuffer(const LogRingBuffer&) = delete;
+    LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+};
+
+// 异步日志后端 - 单个写线程负责格式化、批量写文件并按大小/时间阈值刷新
+class AsyncLogBackend : public QThread
+{
+    Q_OBJECT
+
+public:
+    AsyncLogBackend(const AsyncLogOptions &options, ConsoleLogger *console,
+                    FileLogger *file, QObject *parent = nullptr);
+    ~AsyncLogBackend();
+
+    // 提交日志（任意线程），被丢弃时返回false
+    bool submit(LogLevel level, LogModule module, LogLayer layer,
+                const QString &context, const QString &message);
+
+    // 替换输出目标（日志文件重新打开后调用）
+    void setFileLogger(FileLogger *file) { fileLogger_.store(file, std::memory_order_release); }
+
+    // 写出剩余日志并结束写线程
+    void stop();
+
+    quint64 droppedCount() const { return droppedTotal_.load(std::memory_order_relaxed); }
+    const AsyncLogOptions &options() const { return options_; }
+
+protected:
+    void run() override;
+
+private:
+    void appendRecord(const LogRecord &record, QString &batch);
+    void appendDroppedNotice(QString &batch);
+    void flushBatch(QString &batch);
+    void wakeWriter();
+
+    // 时间戳前缀按秒缓存，同一秒内只拼接毫秒
+    QString formatTimestamp(qint64 timestampMs);
+
+    AsyncLogOptions options_;
+    LogRingBuffer queue_;
+    ConsoleLogger *consoleLogger_;
+    std::atomic<FileLogger*> fileLogger_;
+
+    std::atomic<bool> stopping_;
+    std::atomic<bool> writerSleeping_;
+    std::atomic<quint64> droppedPending_;  // 尚未在日志中报告的丢弃数
+    std::atomic<quint64> droppedTotal_;
+    QMutex wakeMutex_;
+    QWaitCondition wakeCondition_;
+
+    qint64 cachedSecond_;
+    QString cachedSecondText_;
+};
+
+#endif // ASYNC_LOG_BACKEND_H
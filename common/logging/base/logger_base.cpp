@@ -16,86 +16,96 @@ LoggerBase::~LoggerBase()
 void LoggerBase::debug(const QString &message)
 {
     if (currentLevel_ <= LogLevel::DEBUG) {
-        QString formattedMessage = formatMessage(LogLevel::DEBUG, "", message);
-        outputLog(LogLevel::DEBUG, formattedMessage);
+        submitLog(LogLevel::DEBUG, QString(), message);
     }
 }
 
 void LoggerBase::info(const QString &message)
 {
     if (currentLevel_ <= LogLevel::INFO) {
-        QString formattedMessage = formatMessage(LogLevel::INFO, "", message);
-        outputLog(LogLevel::INFO, formattedMessage);
+        submitLog(LogLevel::INFO, QString(), message);
     }
 }
 
 void LoggerBase::warning(const QString &message)
 {
     if (currentLevel_ <= LogLevel::WARNING) {
-        QString formattedMessage = formatMessage(LogLevel::WARNING, "", message);
-        outputLog(LogLevel::WARNING, formattedMessage);
+        submitLog(LogLevel::WARNING, QString(), message);
     }
 }
 
 void LoggerBase::error(const QString &message)
 {
     if (currentLevel_ <= LogLevel::ERROR) {
-        QString formattedMessage = formatMessage(LogLevel::ERROR, "", message);
-        outputLog(LogLevel::ERROR, formattedMessage);
+        submitLog(LogLevel::ERROR, QString(), message);
     }
 }
 
 void LoggerBase::critical(const QString &message)
 {
     if (currentLevel_ <= LogLevel::CRITICAL) {
-        QString formattedMessage = formatMessage(LogLevel::CRITICAL, "", message);
-        outputLog(LogLevel::CRITICAL, formattedMessage);
+        submitLog(LogLevel::CRITICAL, QString(), message);
     }
 }
 
 void LoggerBase::debug(const QString &context, const QString &message)
 {
     if (currentLevel_ <= LogLevel::DEBUG) {
-        QString formattedMessage = formatMessage(LogLevel::DEBUG, context, message);
-        outputLog(LogLevel::DEBUG, formattedMessage);
+        submitLog(LogLevel::DEBUG, context, message);
     }
 }
 
 void LoggerBase::info(const QString &context, const QString &message)
 {
     if (currentLevel_ <= LogLevel::INFO) {
-        QString formattedMessage = formatMessage(LogLevel::INFO, context, message);
-        outputLog(LogLevel::INFO, formattedMessage);
+        submitLog(LogLevel::INFO, context, message);
     }
 }
 
 void LoggerBase::warning(const QString &context, const QString &message)
 {
     if (currentLevel_ <= LogLevel::WARNING) {
-        QString formattedMessage = formatMessage(LogLevel::WARNING, context, message);
-        outputLog(LogLevel::WARNING, formattedMessage);
+        submitLog(LogLevel::WARNING, context, message);
     }
 }
 
 void LoggerBase::error(const QString &context, const QString &message)
 {
     if (currentLevel_ <= LogLevel::ERROR) {
-        QString formattedMessage = formatMessage(LogLevel::ERROR, context, message);
-        outputLog(LogLevel::ERROR, formattedMessage);
+        submitLog(LogLevel::ERROR, context, message);
     }
 }
 
 void LoggerBase::critical(const QString &context, const QString &message)
 {
     if (currentLevel_ <= LogLevel::CRITICAL) {
-        QString formattedMessage = formatMessage(LogLevel::CRITICAL, context, message);
-        outputLog(LogLevel::CRITICAL, formattedMessage);
+        submitLog(LogLevel::CRITICAL, context, message);
     }
 }
 
+void LoggerBase::submitLog(LogLevel level, const QString &context, const QString &message)
+{
+    outputLog(level, formatMessage(level, context, message));
+}
+
 QString LoggerBase::getModuleName() const
 {
-    switch (currentModule_) {
+    return moduleName(currentModule_);
+}
+
+QString LoggerBase::getLayerName() const
+{
+    return layerName(currentLayer_);
+}
+
+QString LoggerBase::getLevelName(LogLevel level) const
+{
+    return levelName(level);
+}
+
+QString LoggerBase::moduleName(LogModule module)
+{
+    switch (module) {
         case LogModule::USER: return "USER";
         case LogModule::TICKET: return "TICKET";
         case LogModule::WORKORDER: return "WORKORDER";
@@ -107,9 +117,9 @@ QString LoggerBase::getModuleName() const
     }
 }
 
-QString LoggerBase::getLayerName() const
+QString LoggerBase::layerName(LogLayer layer)
 {
-    switch (currentLayer_) {
+    switch (layer) {
         case LogLayer::DATA: return "DATA";
         case LogLayer::BUSINESS: return "BUSINESS";
         case LogLayer::NETWORK: return "NETWORK";
@@ -119,7 +129,7 @@ QString LoggerBase::getLayerName() const
     }
 }
 
-QString LoggerBase::getLevelName(LogLevel level) const
+QString LoggerBase::levelName(LogLevel level)
 {
     switch (level) {
         case LogLevel::DEBUG: return "DEBUG";
@@ -133,15 +143,18 @@ QString LoggerBase::getLevelName(LogLevel level) const
 
 QString LoggerBase::formatMessage(LogLevel level, const QString &context, const QString &message) const
 {
+    Q_UNUSED(level)
     QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd hh:mm:ss.zzz");
-    QString moduleName = getModuleName();
-    QString layerName = getLayerName();
-    QString levelName = getLevelName(level);
-    
-    QString formattedMessage = QString("[%1] [%2][%3] %4")
+    return formatLine(timestamp, currentModule_, currentLayer_, context, message);
+}
+
+QString LoggerBase::formatLine(const QString &timestamp, LogModule module, LogLayer layer,
+                               const QString &context, const QString &message)
+{
+    QString formattedMessage = QString("[%1] [%2][%3]")
         .arg(timestamp)
-        .arg(moduleName)
-        .arg(layerName);
+        .arg(moduleName(module))
+        .arg(layerName(layer));
     
     if (!context.isEmpty()) {
         formattedMessage += QString(" %1: %2").arg(context).arg(message);
@@ -50,6 +50,8 @@ public:
     // 设置模块和层级
     void setModule(LogModule module) { currentModule_ = module; }
     void setLayer(LogLayer layer) { currentLayer_ = layer; }
+    LogModule getModule() const { return currentModule_; }
+    LogLayer getLayer() const { return currentLayer_; }
 
     // 日志输出接口 - 直接调用，不使用宏
     virtual void debug(const QString &message);
@@ -65,7 +67,17 @@ public:
     virtual void error(const QString &context, const QString &message);
     virtual void critical(const QString &context, const QString &message);
 
+    // 名称转换与单行格式化（供异步写线程复用）
+    static QString moduleName(LogModule module);
+    static QString layerName(LogLayer layer);
+    static QString levelName(LogLevel level);
+    static QString formatLine(const QString &timestamp, LogModule module, LogLayer layer,
+                              const QString &context, const QString &message);
+
 protected:
+    // 级别检查通过后的日志提交，默认同步格式化并输出；异步模式下由子类转交写线程
+    virtual void submitLog(LogLevel level, const QString &context, const QString &message);
+
     // 获取模块名称
     QString getModuleName() const;
     
@@ -8,12 +8,14 @@ INCLUDEPATH += $$PWD
 HEADERS += \
     $$PWD/base/logger_base.h \
     $$PWD/managers/log_manager.h \
+    $$PWD/async/async_log_backend.h \
     $$PWD/config/log_config.h
 
 # 源文件
 SOURCES += \
     $$PWD/base/logger_base.cpp \
     $$PWD/managers/log_manager.cpp \
+    $$PWD/async/async_log_backend.cpp \
     $$PWD/config/log_config.cpp
 
 # 依赖的Qt模块
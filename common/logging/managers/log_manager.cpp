@@ -59,6 +59,7 @@ FileLogger::~FileLogger()
 
 void FileLogger::setLogFilePath(const QString &path)
 {
+    QMutexLocker locker(&fileMutex_);
     logFilePath_ = path;
     
     // 确保日志目录存在
@@ -92,19 +93,35 @@ void FileLogger::setLogFilePath(const QString &path)
 void FileLogger::outputLog(LogLevel level, const QString &formattedMessage)
 {
     Q_UNUSED(level)
+    QMutexLocker locker(&fileMutex_);
     if (logStream_ && logFile_ && logFile_->isOpen()) {
         *logStream_ << formattedMessage << "\n";
         logStream_->flush();
     }
 }
 
+void FileLogger::writeBatch(const QString &lines)
+{
+    QMutexLocker locker(&fileMutex_);
+    if (logStream_ && logFile_ && logFile_->isOpen()) {
+        *logStream_ << lines;
+        logStream_->flush();
+    }
+}
+
 // LogManager 实现
 LogManager::LogManager(QObject *parent)
     : QObject(parent)
     , globalLogLevel_(LogLevel::INFO)
     , consoleLogger_(nullptr)
     , fileLogger_(nullptr)
+    , asyncBackend_(nullptr)
+    , asyncSubmitters_(0)
+    , droppedBeforeDisable_(0)
 {
+    for (auto &slot : loggers_) {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
 }
 
 LogManager::~LogManager()
@@ -147,20 +164,25 @@ void LogManager::initialize(LogLevel level, const QString &logFilePath)
 
 LoggerBase* LogManager::getLogger(LogModule module, LogLayer layer)
 {
-    QString key = generateLoggerKey(module, layer);
-    
-    QMutexLocker locker(&loggersMutex_);
+    const int index = loggerIndex(module, layer);
+    if (index < 0 || index >= int(loggers_.size())) {
+        return nullptr;
+    }
     
-    if (!loggers_.contains(key)) {
-        loggers_[key] = createLogger(module, layer);
+    std::atomic<LoggerBase*> &slot = loggers_[index];
+    LoggerBase* logger = slot.load(std::memory_order_acquire);
+    if (logger) {
+        return logger;
     }
     
-    return loggers_[key];
-}
-
-QString LogManager::generateLoggerKey(LogModule module, LogLayer layer) const
-{
-    return QString("%1_%2").arg(static_cast<int>(module)).arg(static_cast<int>(layer));
+    // 首次使用时创建
+    QMutexLocker locker(&loggersMutex_);
+    logger = slot.load(std::memory_order_relaxed);
+    if (!logger) {
+        logger = createLogger(module, layer);
+        slot.store(logger, std::memory_order_release);
+    }
+    return logger;
 }
 
 LoggerBase* LogManager::createLogger(LogModule module, LogLayer layer)
@@ -180,6 +202,15 @@ LoggerBase* LogManager::createLogger(LogModule module, LogLayer layer)
         }
         
     protected:
+        void submitLog(LogLevel level, const QString &context, const QString &message) override
+        {
+            if (LogManager::getInstance()->submitAsync(level, getModule(), getLayer(), context, message)) {
+                return;
+            }
+            LoggerBase::submitLog(level, context, message);
+        }
+        
+
         void outputLog(LogLevel level, const QString &formattedMessage) override
         {
             if (consoleLogger_) {
@@ -195,7 +226,23 @@ LoggerBase* LogManager::createLogger(LogModule module, LogLayer layer)
         FileLogger* fileLogger_;
     };
     
-    return new CompositeLogger(module, layer, consoleLogger_, fileLogger_, this);
+    CompositeLogger* logger = new CompositeLogger(module, layer, consoleLogger_, fileLogger_, this);
+    logger->setLogLevel(globalLogLevel_.load(std::memory_order_relaxed));
+    return logger;
+}
+
+bool LogManager::submitAsync(LogLevel level, LogModule module, LogLayer layer,
+                             const QString &context, const QString &message)
+{
+    // 先登记再读取后端（均为顺序一致操作）：disableAsync 摘除后端后看到计数归零，
+    // 说明之后的提交者都会读到空指针
+    asyncSubmitters_.fetch_add(1);
+    AsyncLogBackend* backend = asyncBackend_.load();
+    if (backend) {
+        backend->submit(level, module, layer, context, message);
+    }
+    asyncSubmitters_.fetch_sub(1, std::memory_order_release);
+    return backend != nullptr;
 }
 
 // 直接调用日志方法实现 - 兼容客户端调用方式
@@ -286,7 +333,8 @@ void LogManager::setGlobalLogLevel(LogLevel level)
     
     // 更新所有日志器的级别
     QMutexLocker locker(&loggersMutex_);
-    for (auto logger : loggers_) {
+    for (auto &slot : loggers_) {
+        LoggerBase* logger = slot.load(std::memory_order_acquire);
         if (logger) {
             logger->setLogLevel(level);
         }
@@ -309,20 +357,65 @@ void LogManager::setLogFilePath(const QString &path)
     } else if (!path.isEmpty()) {
         fileLogger_ = new FileLogger(path, this);
         fileLogger_->setLogLevel(globalLogLevel_);
+        
+        AsyncLogBackend* backend = asyncBackend();
+        if (backend) {
+            backend->setFileLogger(fileLogger_);
+        }
     }
 }
 
+void LogManager::enableAsync(const AsyncLogOptions &options)
+{
+    disableAsync();
+    
+    AsyncLogBackend* backend = new AsyncLogBackend(options, consoleLogger_, fileLogger_);
+    backend->start(QThread::LowPriority);
+    asyncBackend_.store(backend, std::memory_order_release);
+    
+    info(LogModule::SYSTEM, LogLayer::BUSINESS, "LogManager",
+         QString("异步日志已启用 (容量: %1, 溢出策略: %2)")
+         .arg(options.capacity)
+         .arg(options.overflowPolicy == LogOverflowPolicy::DROP ? "drop" : "block"));
+}
+
+void LogManager::disableAsync()
+{
+    AsyncLogBackend* backend = asyncBackend_.exchange(nullptr);
+    if (!backend) {
+        return;
+    }
+    
+    // 等已读到旧后端的提交者入队完成，之后不会再有线程访问它
+    while (asyncSubmitters_.load(std::memory_order_acquire) != 0) {
+        QThread::yieldCurrentThread();
+    }
+    
+    // 先摘除后端再停止：写线程退出前会写完队列中剩余的日志
+    backend->stop();
+    droppedBeforeDisable_ += backend->droppedCount();
+    delete backend;
+}
+
+quint64 LogManager::droppedLogCount() const
+{
+    AsyncLogBackend* backend = asyncBackend();
+    return droppedBeforeDisable_ + (backend ? backend->droppedCount() : 0);
+}
+
 void LogManager::cleanup()
 {
+    disableAsync();
+    
     QMutexLocker locker(&loggersMutex_);
     
     // 清理所有日志器
-    for (auto logger : loggers_) {
+    for (auto &slot : loggers_) {
+        LoggerBase* logger = slot.exchange(nullptr, std::memory_order_acq_rel);
         if (logger) {
             delete logger;
         }
     }
-    loggers_.clear();
     
     // 清理控制台和文件日志器
     if (consoleLogger_) {
@@ -2,13 +2,21 @@
 #define LOG_MANAGER_H
 
 #include "../base/logger_base.h"
+#include "../async/async_log_backend.h"
 #include <QObject>
 #include <QMap>
 #include <QMutex>
 #include <QFile>
 #include <QTextStream>
+#include <array>
+#include <atomic>
 #include <utility>
 
+// 编译期最低日志级别（0=DEBUG ... 4=CRITICAL），低于该级别的LOG_*调用被整体消除
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
 // 控制台日志输出器
 class ConsoleLogger : public LoggerBase
 {
@@ -31,7 +39,11 @@ public:
     void setLogFilePath(const QString &path);
     void outputLog(LogLevel level, const QString &formattedMessage) override;
 
+    // 批量写入多行并只刷新一次（异步写线程使用）
+    void writeBatch(const QString &lines);
+
 private:
+    QMutex fileMutex_;
     QString logFilePath_;
     QFile *logFile_;
     QTextStream *logStream_;
@@ -52,6 +64,9 @@ public:
     // 获取指定模块和层级的日志器
     LoggerBase* getLogger(LogModule module, LogLayer layer);
     
+    // 级别是否开启（无锁，供LOG_*宏在构造消息前判断）
+    bool isEnabled(LogModule module, LogLayer layer, LogLevel level) const;
+    
     // 直接调用日志方法 - 兼容客户端调用方式
     void debug(LogModule module, LogLayer layer, const QString &message);
     void info(LogModule module, LogLayer layer, const QString &message);
@@ -88,6 +103,15 @@ public:
     // 设置日志文件路径
     void setLogFilePath(const QString &path);
     
+    // 异步日志：级别检查后只入队，由后台写线程格式化并批量写出
+    // 需在initialize之后调用；disableAsync 会等正在提交的线程完成后再释放后端
+    void enableAsync(const AsyncLogOptions &options = AsyncLogOptions());
+    void disableAsync();
+    bool isAsyncEnabled() const { return asyncBackend() != nullptr; }
+    // 返回的指针只能在调用 enableAsync/disableAsync 的线程中使用
+    AsyncLogBackend* asyncBackend() const { return asyncBackend_.load(std::memory_order_acquire); }
+    quint64 droppedLogCount() const;
+    
     // 清理资源
     void cleanup();
 
@@ -95,41 +119,74 @@ private:
     explicit LogManager(QObject *parent = nullptr);
     ~LogManager();
     
-    // 生成日志器键值
-    QString generateLoggerKey(LogModule module, LogLayer layer) const;
+    // 日志器表按(模块, 层级)平铺
+    static constexpr int kModuleCount = static_cast<int>(LogModule::PRESENTATION) + 1;
+    static constexpr int kLayerCount = static_cast<int>(LogLayer::API) + 1;
+    static constexpr int loggerIndex(LogModule module, LogLayer layer)
+    {
+        return static_cast<int>(module) * kLayerCount + static_cast<int>(layer);
+    }
     
     // 创建新的日志器
     LoggerBase* createLogger(LogModule module, LogLayer layer);
+    
+    // 交给异步后端；未启用时返回false，由调用方同步输出
+    bool submitAsync(LogLevel level, LogModule module, LogLayer layer,
+                     const QString &context, const QString &message);
 
 private:
     static LogManager* instance_;
     static QMutex mutex_;
     
-    LogLevel globalLogLevel_;
+    std::atomic<LogLevel> globalLogLevel_;
     QString logFilePath_;
     
-    QMap<QString, LoggerBase*> loggers_;
+    // 创建后只读，查找无需加锁；loggersMutex_仅用于首次创建和清理
+    std::array<std::atomic<LoggerBase*>, kModuleCount * kLayerCount> loggers_;
     ConsoleLogger* consoleLogger_;
     FileLogger* fileLogger_;
+    std::atomic<AsyncLogBackend*> asyncBackend_;
+    std::atomic<int> asyncSubmitters_;     // 正在使用后端的提交者，disableAsync 等其归零后才释放后端
+    quint64 droppedBeforeDisable_;
     
     QMutex loggersMutex_;
 };
 
 // 便捷宏定义 - 兼容服务端调用方式
+// 先判断级别再求值参数，级别未开启时消息字符串不会被构造
+#define LOG_AT_LEVEL(level, method, module, layer, ...) \
+    do { \
+        if (static_cast<int>(level) >= LOG_MIN_LEVEL \
+            && LogManager::getInstance()->isEnabled(module, layer, level)) { \
+            LogManager::getInstance()->method(module, layer, __VA_ARGS__); \
+        } \
+    } while (0)
+
 #define LOG_DEBUG(module, layer, ...) \
-    LogManager::getInstance()->debug(module, layer, __VA_ARGS__)
+    LOG_AT_LEVEL(LogLevel::DEBUG, debug, module, layer, __VA_ARGS__)
 
 #define LOG_INFO(module, layer, ...) \
-    LogManager::getInstance()->info(module, layer, __VA_ARGS__)
+    LOG_AT_LEVEL(LogLevel::INFO, info, module, layer, __VA_ARGS__)
 
 #define LOG_WARNING(module, layer, ...) \
-    LogManager::getInstance()->warning(module, layer, __VA_ARGS__)
+    LOG_AT_LEVEL(LogLevel::WARNING, warning, module, layer, __VA_ARGS__)
 
 #define LOG_ERROR(module, layer, ...) \
-    LogManager::getInstance()->error(module, layer, __VA_ARGS__)
+    LOG_AT_LEVEL(LogLevel::ERROR, error, module, layer, __VA_ARGS__)
 
 #define LOG_CRITICAL(module, layer, ...) \
-    LogManager::getInstance()->critical(module, layer, __VA_ARGS__)
+    LOG_AT_LEVEL(LogLevel::CRITICAL, critical, module, layer, __VA_ARGS__)
+
+inline bool LogManager::isEnabled(LogModule module, LogLayer layer, LogLevel level) const
+{
+    if (static_cast<int>(level) < LOG_MIN_LEVEL) {
+        return false;
+    }
+    const LoggerBase* logger = loggers_[loggerIndex(module, layer)].load(std::memory_order_acquire);
+    const LogLevel threshold = logger ? logger->getLogLevel()
+                                      : globalLogLevel_.load(std::memory_order_relaxed);
+    return threshold <= level;
+}
 
 // 模板实现
 template<typename... Args>
@@ -120,15 +120,18 @@ QJsonObject MessageBuilder::buildVideoFrameMessage(const QString& roomId,
                                                  int width,
                                                  int height,
                                                  int fps,
-                                                 qint64 timestamp)
+                                                 qint64 timestamp,
+                                                 bool keyFrame)
 {
+    // keyFrame：该帧能否独立解码，服务端拥塞丢帧时据此保留最新关键帧
     return QJsonObject{
         {"roomId", roomId},
         {"frameId", frameId},
         {"width", width},
         {"height", height},
         {"fps", fps},
-        {"timestamp", timestamp}
+        {"timestamp", timestamp},
+        {"keyFrame", keyFrame}
     };
 }
 
@@ -260,6 +263,30 @@ QJsonObject MessageBuilder::buildWorkOrderListResponse(const QJsonArray& workOrd
     };
 }
 
+QJsonObject MessageBuilder::buildWorkOrderListResponse(const QJsonArray& workOrders,
+                                                     int totalCount,
+                                                     const QString& nextCursor,
+                                                     bool hasMore)
+{
+    QJsonObject response = buildWorkOrderListResponse(workOrders, totalCount);
+    response["next_cursor"] = nextCursor;
+    response["has_more"] = hasMore;
+    return response;
+}
+
+QJsonObject MessageBuilder::buildWorkOrderSearchResponse(const QJsonArray& workOrders,
+                                                       const QString& query,
+                                                       const QString& nextCursor,
+                                                       bool hasMore)
+{
+    return QJsonObject{
+        {"work_orders", workOrders},
+        {"query", query},
+        {"next_cursor", nextCursor},
+        {"has_more", hasMore}
+    };
+}
+
 QJsonObject MessageBuilder::buildHeartbeatResponse(qint64 timestamp)
 {
     return QJsonObject{
@@ -55,7 +55,8 @@ public:
                                              int width,
                                              int height,
                                              int fps,
-                                             qint64 timestamp);
+                                             qint64 timestamp,
+                                             bool keyFrame = true);
     
     static QJsonObject buildAudioFrameMessage(const QString& roomId,
                                              const QString& frameId,
@@ -106,5 +107,17 @@ public:
     static QJsonObject buildWorkOrderListResponse(const QJsonArray& workOrders,
                                                  int totalCount);
     
+    // 分页响应：附带下一页游标
+    static QJsonObject buildWorkOrderListResponse(const QJsonArray& workOrders,
+                                                 int totalCount,
+                                                 const QString& nextCursor,
+                                                 bool hasMore);
+    
+    // 搜索响应：字段与分页列表响应一致，按相关度排序，不含总数
+    static QJsonObject buildWorkOrderSearchResponse(const QJsonArray& workOrders,
+                                                   const QString& query,
+                                                   const QString& nextCursor,
+                                                   bool hasMore);
+    
     static QJsonObject buildHeartbeatResponse(qint64 timestamp);
 };
@@ -1,4 +1,5 @@
 #include "message_parser.h"
+#include "../types/constants.h"
 
 // MessageParser 实现
 bool MessageParser::parseLoginMessage(const QJsonObject& data,
@@ -113,6 +114,32 @@ bool MessageParser::parseListWorkOrdersMessage(const QJsonObject& data,
     return true;
 }
 
+bool MessageParser::parseListWorkOrdersMessage(const QJsonObject& data,
+                                              QString& status,
+                                              QString& cursor,
+                                              int& limit)
+{
+    status = data["status"].toString();
+    cursor = data["cursor"].toString();
+    limit = qBound(1, data["limit"].toInt(ProtocolConstants::DEFAULT_WORKORDER_PAGE_SIZE),
+                   ProtocolConstants::MAX_WORKORDER_PAGE_SIZE);
+    
+    return true;
+}
+
+bool MessageParser::parseSearchWorkOrdersMessage(const QJsonObject& data,
+                                                QString& query,
+                                                QString& cursor,
+                                                int& limit)
+{
+    query = data["query"].toString().trimmed();
+    cursor = data["cursor"].toString();
+    limit = qBound(1, data["limit"].toInt(ProtocolConstants::DEFAULT_WORKORDER_PAGE_SIZE),
+                   ProtocolConstants::MAX_WORKORDER_PAGE_SIZE);
+    
+    return !query.isEmpty();
+}
+
 bool MessageParser::parseTextMessage(const QJsonObject& data,
                                     QString& roomId,
                                     QString& text,
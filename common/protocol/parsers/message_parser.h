@@ -50,6 +50,18 @@ public:
                                           int& limit,
                                           int& offset);
     
+    // 键集分页：cursor 为上一页响应中的 next_cursor，limit 限制在 [1, MAX_WORKORDER_PAGE_SIZE]
+    static bool parseListWorkOrdersMessage(const QJsonObject& data,
+                                          QString& status,
+                                          QString& cursor,
+                                          int& limit);
+    
+    // 全文搜索：分页参数同上
+    static bool parseSearchWorkOrdersMessage(const QJsonObject& data,
+                                            QString& query,
+                                            QString& cursor,
+                                            int& limit);
+    
     // 解析聊天消息
     static bool parseTextMessage(const QJsonObject& data,
                                 QString& roomId,
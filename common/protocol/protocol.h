@@ -22,6 +22,8 @@
 // 序列化
 #include "serialization/packet.h"
 #include "serialization/serializer.h"
+#include "serialization/packet_framer.h"
+#include "serialization/media_header.h"
 
 // 工具类
 #include "builders/message_builder.h"
@@ -11,9 +11,13 @@ HEADERS += $$PWD/types/enums.h \
            $$PWD/types/validation_rules.h
 
 # 序列化层
-SOURCES += $$PWD/serialization/serializer.cpp
+SOURCES += $$PWD/serialization/serializer.cpp \
+           $$PWD/serialization/packet_framer.cpp \
+           $$PWD/serialization/media_header.cpp
 HEADERS += $$PWD/serialization/packet.h \
-           $$PWD/serialization/serializer.h
+           $$PWD/serialization/serializer.h \
+           $$PWD/serialization/packet_framer.h \
+           $$PWD/serialization/media_header.h
 
 
 # 构建器层
@@ -0,0 +1,59 @@
+#include "media_header.h"
+#include "serializer.h"
+#include "../builders/message_builder.h"
+
+static const int kLenFieldSize = ProtocolConstants::LENGTH_FIELD_SIZE;
+static const int kTypeSize     = ProtocolConstants::TYPE_FIELD_SIZE;
+static const int kJsonSizeSize = ProtocolConstants::JSON_SIZE_FIELD_SIZE;
+static const int kHeaderSize   = kLenFieldSize + kTypeSize + kJsonSizeSize;
+
+QByteArray buildMediaPacket(quint16 type, const MediaFrameHeader& header, const QByteArray& payload)
+{
+    const int binSize = ProtocolConstants::MEDIA_HEADER_SIZE + payload.size();
+    const quint32 length = quint32(kTypeSize + kJsonSizeSize + binSize);
+
+    QByteArray out(kLenFieldSize + int(length), Qt::Uninitialized);
+    char* p = out.data();
+
+    qToBigEndian(length, p);
+    qToBigEndian(type, p + kLenFieldSize);
+    qToBigEndian(quint32(0), p + kLenFieldSize + kTypeSize);
+    encodeMediaHeader(header, p + kHeaderSize);
+    if (!payload.isEmpty()) {
+        std::memcpy(p + kHeaderSize + ProtocolConstants::MEDIA_HEADER_SIZE, payload.constData(), size_t(payload.size()));
+    }
+
+    return out;
+}
+
+bool readMediaPacketHeader(const QByteArray& raw, MediaFrameHeader& header)
+{
+    const int binSize = rawPacketBinSize(raw);
+    if (binSize < ProtocolConstants::MEDIA_HEADER_SIZE) return false;
+
+    return decodeMediaHeader(raw.constData() + raw.size() - binSize, binSize, header);
+}
+
+QByteArray mediaPacketToLegacy(const QByteArray& raw, const QString& roomId)
+{
+    const quint16 type = rawPacketType(raw);
+    MediaFrameHeader header;
+    if (!isBinaryMediaType(type) || !readMediaPacketHeader(raw, header)) {
+        return QByteArray();
+    }
+
+    const int binSize = rawPacketBinSize(raw);
+    const QByteArray payload = raw.right(binSize - ProtocolConstants::MEDIA_HEADER_SIZE);
+    const QString frameId = QString::number(header.frameSeq);
+
+    QJsonObject json;
+    if (type == MSG_VIDEO_FRAME_BIN) {
+        json = MessageBuilder::buildVideoFrameMessage(roomId, frameId, header.width, header.height,
+                                                      header.fps, header.timestamp, header.isKeyFrame());
+    } else {
+        json = MessageBuilder::buildAudioFrameMessage(roomId, frameId, int(header.sampleRate),
+                                                      header.channels, header.timestamp);
+    }
+
+    return buildPacket(legacyMediaType(type), json, payload);
+}
@@ -0,0 +1,120 @@
+#pragma once
+// ===============================================
+// common/protocol/serialization/media_header.h
+// 二进制媒体帧头定义（协议版本2）
+// 包结构: [uint32 length][uint16 type][uint32 jsonSize=0][MediaFrameHeader 28B][payload...]
+// 帧头为固定布局、大端序，编解码只做定长读写，不经过JSON
+// ===============================================
+
+#include <QtCore>
+#include <QtEndian>
+#include <cstring>
+#include "../types/enums.h"
+#include "../types/constants.h"
+
+// 媒体帧标志位
+enum MediaFrameFlag : quint8 {
+    MEDIA_FLAG_KEY_FRAME = 0x01   // 可独立解码的关键帧
+};
+
+// 媒体编码标识
+enum MediaCodec : quint8 {
+    MEDIA_CODEC_UNKNOWN = 0,
+    MEDIA_CODEC_JPEG    = 1,
+    MEDIA_CODEC_PCM     = 2
+};
+
+// 帧头（主机字节序）
+struct MediaFrameHeader {
+    quint8  headerVersion = 1;
+    quint8  flags = 0;
+    quint8  codec = MEDIA_CODEC_UNKNOWN;
+    quint8  channels = 0;      // 音频
+    quint32 frameSeq = 0;
+    qint64  timestamp = 0;     // 毫秒
+    quint16 width = 0;         // 视频
+    quint16 height = 0;        // 视频
+    quint32 sampleRate = 0;    // 音频
+    quint8  fps = 0;           // 视频
+
+    bool isKeyFrame() const { return (flags & MEDIA_FLAG_KEY_FRAME) != 0; }
+};
+
+// 线路上的帧头布局（大端序，紧凑排列）
+#pragma pack(push, 1)
+struct MediaFrameHeaderWire {
+    quint8  headerVersion;
+    quint8  flags;
+    quint8  codec;
+    quint8  channels;
+    quint32 frameSeq;
+    qint64  timestamp;
+    quint16 width;
+    quint16 height;
+    quint32 sampleRate;
+    quint8  fps;
+    quint8  reserved[3];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(MediaFrameHeaderWire) == ProtocolConstants::MEDIA_HEADER_SIZE,
+              "MediaFrameHeaderWire layout must match MEDIA_HEADER_SIZE");
+
+// 是否为二进制帧头的媒体消息
+inline bool isBinaryMediaType(quint16 type)
+{
+    return type == MSG_VIDEO_FRAME_BIN || type == MSG_AUDIO_FRAME_BIN;
+}
+
+// 二进制媒体消息对应的旧版（JSON）消息类型
+inline quint16 legacyMediaType(quint16 type)
+{
+    return type == MSG_AUDIO_FRAME_BIN ? quint16(MSG_AUDIO_FRAME) : quint16(MSG_VIDEO_FRAME);
+}
+
+// 编码帧头到out（至少MEDIA_HEADER_SIZE字节）
+inline void encodeMediaHeader(const MediaFrameHeader& header, char* out)
+{
+    MediaFrameHeaderWire wire;
+    wire.headerVersion = header.headerVersion;
+    wire.flags = header.flags;
+    wire.codec = header.codec;
+    wire.channels = header.channels;
+    wire.frameSeq = qToBigEndian(header.frameSeq);
+    wire.timestamp = qToBigEndian(header.timestamp);
+    wire.width = qToBigEndian(header.width);
+    wire.height = qToBigEndian(header.height);
+    wire.sampleRate = qToBigEndian(header.sampleRate);
+    wire.fps = header.fps;
+    std::memset(wire.reserved, 0, sizeof(wire.reserved));
+    std::memcpy(out, &wire, sizeof(wire));
+}
+
+// 从data解码帧头，数据不足时返回false
+inline bool decodeMediaHeader(const char* data, int size, MediaFrameHeader& header)
+{
+    if (!data || size < ProtocolConstants::MEDIA_HEADER_SIZE) return false;
+
+    MediaFrameHeaderWire wire;
+    std::memcpy(&wire, data, sizeof(wire));
+    header.headerVersion = wire.headerVersion;
+    header.flags = wire.flags;
+    header.codec = wire.codec;
+    header.channels = wire.channels;
+    header.frameSeq = qFromBigEndian(wire.frameSeq);
+    header.timestamp = qFromBigEndian(wire.timestamp);
+    header.width = qFromBigEndian(wire.width);
+    header.height = qFromBigEndian(wire.height);
+    header.sampleRate = qFromBigEndian(wire.sampleRate);
+    header.fps = wire.fps;
+    return true;
+}
+
+// 打包二进制媒体消息（一次分配，不经过JSON）
+QByteArray buildMediaPacket(quint16 type, const MediaFrameHeader& header, const QByteArray& payload);
+
+// 从原始包块中读取帧头
+bool readMediaPacketHeader(const QByteArray& raw, MediaFrameHeader& header);
+
+// 把二进制媒体包转换为旧版JSON媒体包（转发给只支持协议版本1的客户端）
+QByteArray mediaPacketToLegacy(const QByteArray& raw, const QString& roomId);
@@ -12,4 +12,7 @@ struct Packet {
     quint16 type = 0;
     QJsonObject json;
     QByteArray bin; // 可为空
+    // 原始线路数据：含长度前缀的完整包块，仅在转发模式下填充
+    // 从接收缓冲拷贝一次，之后发往各接收方时隐式共享同一份数据，转发时直接写出，无需重新打包
+    QByteArray raw;
 };
@@ -0,0 +1,218 @@
+#include "packet_framer.h"
+#include "serializer.h"
+#include "../types/constants.h"
+#include <cstring>
+#include <limits>
+
+static const int kLenFieldSize = ProtocolConstants::LENGTH_FIELD_SIZE;
+static const int kTypeSize     = ProtocolConstants::TYPE_FIELD_SIZE;
+static const int kJsonSizeSize = ProtocolConstants::JSON_SIZE_FIELD_SIZE;
+static const int kHeaderSize   = kLenFieldSize + kTypeSize + kJsonSizeSize;
+
+static inline quint32 readBE32(const char* p)
+{
+    const uchar* u = reinterpret_cast<const uchar*>(p);
+    return (quint32(u[0]) << 24) | (quint32(u[1]) << 16) | (quint32(u[2]) << 8) | quint32(u[3]);
+}
+
+static inline quint16 readBE16(const char* p)
+{
+    const uchar* u = reinterpret_cast<const uchar*>(p);
+    return quint16((quint16(u[0]) << 8) | quint16(u[1]));
+}
+
+PacketFramer::PacketFramer(bool relayMode, int initialCapacity)
+    : buffer_(qMax(initialCapacity, kHeaderSize), Qt::Uninitialized)
+    , readPos_(0)
+    , writePos_(0)
+    , relayMode_(relayMode)
+    , error_(false)
+{
+}
+
+void PacketFramer::append(const char* data, int size)
+{
+    if (!data || size <= 0 || error_) return;
+
+    if (!ensureWritable(size)) return;
+    std::memcpy(writePtr(), data, size_t(size));
+    writePos_ += size;
+}
+
+void PacketFramer::append(const QByteArray& data)
+{
+    append(data.constData(), data.size());
+}
+
+qint64 PacketFramer::readFrom(QIODevice* device)
+{
+    if (!device) return 0;
+
+    const qint64 available = device->bytesAvailable();
+    if (available <= 0) return 0;
+
+    // 出错后连接即将关闭，读出的数据直接丢弃
+    if (error_) {
+        device->readAll();
+        return 0;
+    }
+
+    const int size = int(qMin<qint64>(available, std::numeric_limits<int>::max()));
+    if (!ensureWritable(size)) return 0;
+    const qint64 n = device->read(writePtr(), size);
+    if (n > 0) {
+        writePos_ += int(n);
+    }
+    return n;
+}
+
+bool PacketFramer::nextView(PacketView& view)
+{
+    // 非法包逐个跳过，用循环而不是递归，连续的垃圾数据不会耗尽栈
+    for (;;) {
+        if (error_) return false;
+
+        const int unread = writePos_ - readPos_;
+        if (unread < kLenFieldSize) return false;
+
+        const char* block = buffer_.constData() + readPos_;
+        const quint32 length = readBE32(block);
+        if (length < quint32(kTypeSize + kJsonSizeSize)
+            || length > quint32(ProtocolConstants::MAX_PACKET_SIZE)) {
+            // 声明的长度过小时流已无法对齐；过大则是异常对端，不能为它无限扩大缓冲
+            fail();
+            return false;
+        }
+
+        const int totalNeed = kLenFieldSize + int(length);
+        if (unread < totalNeed) return false; // 半包，等待更多数据
+
+        const quint32 jsonSize = readBE32(block + kLenFieldSize + kTypeSize);
+        const int payloadBytes = totalNeed - kHeaderSize;
+
+        // 包已完整，无论是否合法都要消费
+        readPos_ += totalNeed;
+        if (readPos_ == writePos_) {
+            // 缓冲读空时游标归零，下次读入无需搬移
+            readPos_ = writePos_ = 0;
+        }
+
+        if (jsonSize > quint32(payloadBytes)) {
+            // 非法包，跳过后继续取下一个
+            continue;
+        }
+
+        view.type = readBE16(block + kLenFieldSize);
+        view.raw = block;
+        view.rawSize = totalNeed;
+        view.json = block + kHeaderSize;
+        view.jsonSize = int(jsonSize);
+        view.bin = view.json + jsonSize;
+        view.binSize = payloadBytes - int(jsonSize);
+        return true;
+    }
+}
+
+bool PacketFramer::next(Packet& out)
+{
+    PacketView view;
+    if (!nextView(view)) return false;
+
+    toPacket(view, out);
+    return true;
+}
+
+bool PacketFramer::drain(QVector<Packet>& out)
+{
+    bool produced = false;
+
+    PacketView view;
+    while (nextView(view)) {
+        Packet pkt;
+        toPacket(view, pkt);
+        out.push_back(std::move(pkt));
+        produced = true;
+    }
+
+    return produced;
+}
+
+int PacketFramer::bufferedBytes() const
+{
+    return writePos_ - readPos_;
+}
+
+void PacketFramer::clear()
+{
+    readPos_ = 0;
+    writePos_ = 0;
+    error_ = false;
+}
+
+void PacketFramer::fail()
+{
+    readPos_ = 0;
+    writePos_ = 0;
+    error_ = true;
+}
+
+char* PacketFramer::writePtr()
+{
+    return buffer_.data() + writePos_;
+}
+
+bool PacketFramer::ensureWritable(int size)
+{
+    if (buffer_.size() - writePos_ >= size) return true;
+
+    // 先把未读的半包移到开头，回收已消费的空间
+    const int unread = writePos_ - readPos_;
+    if (readPos_ > 0) {
+        if (unread > 0) {
+            std::memmove(buffer_.data(), buffer_.constData() + readPos_, size_t(unread));
+        }
+        readPos_ = 0;
+        writePos_ = unread;
+    }
+
+    // 仍然不够则按倍数扩容；按64位计算，超出int范围视为错误
+    if (buffer_.size() - writePos_ < size) {
+        const qint64 needed = qint64(writePos_) + size;
+        if (needed > std::numeric_limits<int>::max()) {
+            fail();
+            return false;
+        }
+        qint64 capacity = buffer_.size();
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+        buffer_.resize(int(qMin<qint64>(capacity, std::numeric_limits<int>::max())));
+    }
+    return true;
+}
+
+void PacketFramer::toPacket(const PacketView& view, Packet& out) const
+{
+    out.type = view.type;
+
+    if (relayMode_) {
+        out.raw = QByteArray(view.raw, view.rawSize);
+
+        if (isRelayMediaType(view.type)) {
+            // 媒体包只窥探路由字段，JSON与负载原样保留在raw中转发
+            const QString roomId = peekJsonField(view.json, view.jsonSize, "roomId");
+            if (!roomId.isEmpty()) {
+                out.json.insert("roomId", roomId);
+            }
+            return;
+        }
+    }
+
+    // JSON直接从缓冲内解析，不做中间拷贝
+    if (view.jsonSize > 0) {
+        out.json = fromJsonBytes(QByteArray::fromRawData(view.json, view.jsonSize));
+    }
+    if (view.binSize > 0) {
+        out.bin = QByteArray(view.bin, view.binSize);
+    }
+}
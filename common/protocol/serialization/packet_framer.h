@@ -0,0 +1,68 @@
+#pragma once
+// ===============================================
+// common/protocol/serialization/packet_framer.h
+// 增量拆包器定义
+// ===============================================
+
+#include <QtCore>
+#include "packet.h"
+
+// 一个完整包在接收缓冲中的视图（不拥有数据，下一次append/readFrom后失效）
+struct PacketView {
+    quint16 type = 0;
+    const char* raw = nullptr;   // 含长度前缀的完整包块
+    int rawSize = 0;
+    const char* json = nullptr;
+    int jsonSize = 0;
+    const char* bin = nullptr;
+    int binSize = 0;
+};
+
+// 增量拆包器：替代 drainPackets 的 left()/remove() 方式
+// - 接收缓冲带读/写游标，取包只移动读游标，不搬移剩余数据
+// - 只有尾部空间不足时才把未读的半包移到缓冲开头（每次读入至多一次）
+// - 包头直接按大端字节解析，JSON从缓冲内原地解析
+// - 声明的包长度非法（过小或超过 MAX_PACKET_SIZE）时进入错误状态，调用方应关闭连接
+class PacketFramer
+{
+public:
+    // relayMode含义同 drainPackets：保留原始包块，媒体包只窥探roomId
+    explicit PacketFramer(bool relayMode = false, int initialCapacity = 64 * 1024);
+
+    // 追加数据
+    void append(const char* data, int size);
+    void append(const QByteArray& data);
+
+    // 把设备中当前可读的数据直接读入缓冲，返回读取的字节数
+    qint64 readFrom(QIODevice* device);
+
+    // 取出下一个完整包的视图，数据不足时返回false
+    bool nextView(PacketView& view);
+
+    // 取出下一个完整包并复制为Packet，数据不足时返回false
+    bool next(Packet& out);
+
+    // 取出所有完整包，返回是否至少取出1个
+    bool drain(QVector<Packet>& out);
+
+    // 缓冲中尚未处理的字节数
+    int bufferedBytes() const;
+
+    // 数据流已无法继续拆包；此后读入的数据都被丢弃，直到 clear()
+    bool hasError() const { return error_; }
+
+    // 丢弃所有缓冲数据并清除错误状态（断线重连时使用）
+    void clear();
+
+private:
+    char* writePtr();
+    bool ensureWritable(int size);
+    void fail();
+    void toPacket(const PacketView& view, Packet& out) const;
+
+    QByteArray buffer_;
+    int readPos_;
+    int writePos_;
+    bool relayMode_;
+    bool error_;
+};
@@ -1,4 +1,6 @@
 #include "serializer.h"
+#include "../types/enums.h"
+#include <cstring>
 
 // 头字段大小常量（以便统一维护）
 static const int kLenFieldSize = ProtocolConstants::LENGTH_FIELD_SIZE; // uint32 length（大端）
@@ -30,7 +32,77 @@ QByteArray buildPacket(quint16 type,
     return out;
 }
 
-bool drainPackets(QByteArray& buffer, QVector<Packet>& out)
+bool isRelayMediaType(quint16 type)
+{
+    return type == MSG_VIDEO_FRAME || type == MSG_AUDIO_FRAME
+        || type == MSG_VIDEO_FRAME_BIN || type == MSG_AUDIO_FRAME_BIN;
+}
+
+int rawPacketBinSize(const QByteArray& raw)
+{
+    const int headerSize = kLenFieldSize + kTypeSize + kJsonSizeSize;
+    if (raw.size() < headerSize) return -1;
+
+    const uchar* p = reinterpret_cast<const uchar*>(raw.constData()) + kLenFieldSize + kTypeSize;
+    const quint32 jsonSize = (quint32(p[0]) << 24) | (quint32(p[1]) << 16) | (quint32(p[2]) << 8) | quint32(p[3]);
+    if (jsonSize > quint32(raw.size() - headerSize)) return -1;
+
+    return raw.size() - headerSize - int(jsonSize);
+}
+
+quint16 rawPacketType(const QByteArray& raw)
+{
+    if (raw.size() < kLenFieldSize + kTypeSize) return 0;
+
+    const uchar* p = reinterpret_cast<const uchar*>(raw.constData()) + kLenFieldSize;
+    return quint16((quint16(p[0]) << 8) | quint16(p[1]));
+}
+
+QString peekRawJsonField(const QByteArray& raw, const char* key)
+{
+    const int headerSize = kLenFieldSize + kTypeSize + kJsonSizeSize;
+    const int binSize = rawPacketBinSize(raw);
+    if (binSize < 0) return QString();
+
+    return peekJsonField(raw.constData() + headerSize, raw.size() - headerSize - binSize, key);
+}
+
+QString peekJsonField(const char* json, int size, const char* key)
+{
+    if (!json || size <= 0 || !key) return QString();
+
+    // 匹配模式："key":
+    const int keyLen = int(std::strlen(key));
+    const char* end = json + size;
+    for (const char* p = json; p + keyLen + 3 <= end; ++p) {
+        // 只接受对象起始或逗号后的键，避免误匹配字符串值中的内容
+        if (*p != '"' || (p != json && p[-1] != '{' && p[-1] != ',')) continue;
+        if (std::memcmp(p + 1, key, keyLen) != 0 || p[keyLen + 1] != '"' || p[keyLen + 2] != ':') continue;
+
+        const char* v = p + keyLen + 3;
+        while (v < end && (*v == ' ' || *v == '\t')) ++v;
+        if (v >= end) return QString();
+
+        if (*v == '"') {
+            // 字符串值：路由字段不包含转义字符，遇到转义则放弃窥探
+            const char* s = ++v;
+            while (v < end && *v != '"') {
+                if (*v == '\\') return QString();
+                ++v;
+            }
+            return v < end ? QString::fromUtf8(s, int(v - s)) : QString();
+        }
+
+        // 数字等标量值
+        const char* s = v;
+        while (v < end && *v != ',' && *v != '}') ++v;
+        return QString::fromUtf8(s, int(v - s)).trimmed();
+    }
+
+    return QString();
+}
+
+bool drainPackets(QByteArray& buffer, QVector<Packet>& out, bool relayMode)
 {
     bool produced = false;
 
@@ -72,6 +144,25 @@ bool drainPackets(QByteArray& buffer, QVector<Packet>& out)
             continue;
         }
 
+        Packet pkt;
+        pkt.type = type;
+
+        if (relayMode) {
+            pkt.raw = block;
+
+            if (isRelayMediaType(type)) {
+                // 媒体包只窥探路由字段，JSON与负载原样保留在raw中转发
+                const char* jsonStart = block.constData() + kLenFieldSize + kTypeSize + kJsonSizeSize;
+                const QString roomId = peekJsonField(jsonStart, int(jsonSize), "roomId");
+                if (!roomId.isEmpty()) {
+                    pkt.json.insert("roomId", roomId);
+                }
+                out.push_back(std::move(pkt));
+                produced = true;
+                continue;
+            }
+        }
+
         QByteArray jsonBytes(jsonSize, Qt::Uninitialized);
         if (jsonSize > 0) {
             ds.readRawData(jsonBytes.data(), jsonBytes.size());
@@ -82,8 +173,6 @@ bool drainPackets(QByteArray& buffer, QVector<Packet>& out)
             bin = block.right(binSize);
         }
 
-        Packet pkt;
-        pkt.type = type;
         pkt.json = fromJsonBytes(jsonBytes);
         pkt.bin  = bin;
         out.push_back(std::move(pkt));
@@ -25,6 +25,27 @@ QByteArray buildPacket(quint16 type,
                        const QByteArray& bin = QByteArray());
 
 // 拆包（在QTcpSocket::readyRead里，把readAll追加到buffer，然后调用drainPackets）
+// 注意：每个包都会拷贝并搬移剩余缓冲，长连接收包请使用PacketFramer（packet_framer.h）
 // - 解决粘包/半包；只要buffer里有完整包就会解析出来放进out
 // - 返回是否至少解析出1个完整包
-bool drainPackets(QByteArray& buffer, QVector<Packet>& out);
+// - relayMode为true时（服务端转发使用）：
+//   * 每个包都保留原始包块到Packet::raw，转发时直接写出
+//   * 实时媒体包（视频帧/音频帧）不做完整JSON解析，也不拆出bin，
+//     只从JSON中窥探路由所需的roomId字段
+bool drainPackets(QByteArray& buffer, QVector<Packet>& out, bool relayMode = false);
+
+// 是否为走原始包块转发路径（不解析JSON、不重新打包）的实时媒体消息
+bool isRelayMediaType(quint16 type);
+
+// 从原始包块中取得二进制负载长度（不拷贝数据），包块非法时返回-1
+int rawPacketBinSize(const QByteArray& raw);
+
+// 从原始包块中读取消息类型，包块非法时返回0
+quint16 rawPacketType(const QByteArray& raw);
+
+// 在原始包块的JSON部分窥探一个字段（规则同peekJsonField）
+QString peekRawJsonField(const QByteArray& raw, const char* key);
+
+// 在紧凑JSON中窥探一个字段的值（字符串或数字），不构建QJsonDocument
+// 仅用于路由字段，找不到时返回空字符串
+QString peekJsonField(const char* json, int size, const char* key);
@@ -16,6 +16,11 @@ namespace ProtocolConstants {
     static const int MAX_VIDEO_FRAME_SIZE = 1024 * 1024;  // 1MB
     static const int MAX_AUDIO_FRAME_SIZE = 64 * 1024;    // 64KB
     static const int MAX_FILE_SIZE = 10 * 1024 * 1024;    // 10MB
+    static const int MAX_PACKET_SIZE = 16 * 1024 * 1024;  // 单个包（长度字段之后）上限，超过视为协议错误
+    
+    // 工单列表分页
+    static const int DEFAULT_WORKORDER_PAGE_SIZE = 50;
+    static const int MAX_WORKORDER_PAGE_SIZE = 200;
     
     // 时间限制
     static const int HEARTBEAT_INTERVAL = 30;  // 30秒
@@ -25,4 +30,12 @@ namespace ProtocolConstants {
     static const int LENGTH_FIELD_SIZE = 4;    // uint32 length
     static const int TYPE_FIELD_SIZE = 2;      // uint16 type
     static const int JSON_SIZE_FIELD_SIZE = 4; // uint32 jsonSize
+    
+    // 协议版本（登录时协商）
+    static const int PROTOCOL_VERSION_LEGACY = 1;        // 媒体帧使用JSON描述
+    static const int PROTOCOL_VERSION_BINARY_MEDIA = 2;  // 媒体帧使用固定布局的二进制帧头
+    static const int PROTOCOL_VERSION = PROTOCOL_VERSION_BINARY_MEDIA;
+    
+    // 二进制媒体帧头大小（见 serialization/media_header.h）
+    static const int MEDIA_HEADER_SIZE = 28;
 }
@@ -22,6 +22,7 @@ enum MsgType : quint16 {
     MSG_LIST_WORKORDERS  = 14,  // 获取工单列表
     MSG_DELETE_WORKORDER = 15,  // 删除工单
     MSG_GET_WORKORDER    = 16,  // 获取工单详情
+    MSG_SEARCH_WORKORDERS = 17, // 全文搜索工单
     
     // 聊天类消息 (20-29)
     MSG_TEXT             = 20,  // 文本消息
@@ -34,6 +35,8 @@ enum MsgType : quint16 {
     MSG_AUDIO_FRAME      = 31,  // 音频帧
     MSG_VIDEO_CONTROL    = 32,  // 视频控制
     MSG_AUDIO_CONTROL    = 33,  // 音频控制
+    MSG_VIDEO_FRAME_BIN  = 34,  // 视频帧（二进制帧头，协议版本2）
+    MSG_AUDIO_FRAME_BIN  = 35,  // 音频帧（二进制帧头，协议版本2）
     
     // 控制类消息 (50-59)
     MSG_CONTROL          = 50,  // 通用控制指令
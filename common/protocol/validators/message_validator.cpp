@@ -1,4 +1,5 @@
 #include "message_validator.h"
+#include "../types/constants.h"
 #include <QRegularExpression>
 
 // MessageValidator 实现
@@ -102,10 +103,32 @@ bool MessageValidator::validateUpdateWorkOrderMessage(const QJsonObject& data, Q
 
 bool MessageValidator::validateListWorkOrdersMessage(const QJsonObject& data, QString& error)
 {
-    // 可选字段，不需要验证
+    // 字段均为可选，只检查类型
+    if (data.contains("cursor") && !data["cursor"].isString()) {
+        error = "Field 'cursor' must be a string";
+        return false;
+    }
+    if (data.contains("limit") && !data["limit"].isDouble()) {
+        error = "Field 'limit' must be a number";
+        return false;
+    }
+    
     return true;
 }
 
+bool MessageValidator::validateSearchWorkOrdersMessage(const QJsonObject& data, QString& error)
+{
+    if (!validateRequiredField(data, "query", error)) return false;
+    if (!data["query"].isString() || data["query"].toString().trimmed().isEmpty()) {
+        error = "Field 'query' must be a non-empty string";
+        return false;
+    }
+    if (!validateStringLength(data["query"].toString(), ValidationRules::MAX_TITLE_LENGTH, "query", error)) return false;
+    
+    // 分页字段与获取工单列表相同
+    return validateListWorkOrdersMessage(data, error);
+}
+
 bool MessageValidator::validateTextMessage(const QJsonObject& data, QString& error)
 {
     if (!validateRequiredField(data, "roomId", error)) return false;
@@ -220,8 +243,12 @@ bool MessageValidator::validatePacket(const Packet& packet)
         return false; // 无效的消息类型
     }
     
-    // 验证JSON数据不为空
-    if (packet.json.isEmpty()) {
+    // 验证JSON数据不为空（二进制帧头的媒体消息没有JSON，改为检查帧头长度）
+    if (packet.type == MSG_VIDEO_FRAME_BIN || packet.type == MSG_AUDIO_FRAME_BIN) {
+        if (packet.bin.size() < ProtocolConstants::MEDIA_HEADER_SIZE) {
+            return false;
+        }
+    } else if (packet.json.isEmpty()) {
         return false; // JSON数据不能为空
     }
     
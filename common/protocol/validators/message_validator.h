@@ -23,6 +23,7 @@ public:
     static bool validateLeaveWorkOrderMessage(const QJsonObject& data, QString& error);
     static bool validateUpdateWorkOrderMessage(const QJsonObject& data, QString& error);
     static bool validateListWorkOrdersMessage(const QJsonObject& data, QString& error);
+    static bool validateSearchWorkOrdersMessage(const QJsonObject& data, QString& error);
     
     // 验证聊天消息
     static bool validateTextMessage(const QJsonObject& data, QString& error);
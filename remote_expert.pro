@@ -6,6 +6,7 @@ TARGET = RemoteExpert
 # 定义子项目
 SUBDIRS = \
     client \
+    client/tests \
     server \
     videoplusplusplus
 
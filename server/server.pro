@@ -1,4 +1,4 @@
-QT += core sql widgets network
+QT += core sql widgets network concurrent
 QT -= gui
 
 CONFIG += c++17 console
@@ -13,6 +13,9 @@ DESTDIR = $$PWD/../bin
 # 编译警告设置
 DEFINES += QT_DEPRECATED_WARNINGS
 
+# 编译期最低日志级别（0=DEBUG ... 4=CRITICAL），发布构建可去掉DEBUG日志
+# DEFINES += LOG_MIN_LEVEL=1
+
 # 协议模块
 include(../common/protocol/protocol.pri)
 
@@ -26,17 +29,25 @@ SOURCES += \
     # 数据库层
     src/data/databasemanager.cpp \
     src/data/base/db_base.cpp \
+    src/data/base/connection_pool.cpp \
+    src/data/base/db_executor.cpp \
+    src/data/base/group_commit_writer.cpp \
+    src/data/base/unit_of_work.cpp \
     src/data/models/user_model.cpp \
     src/data/models/workorder_model.cpp \
     src/data/models/session_model.cpp \
     src/data/repositories/user_repository.cpp \
     src/data/repositories/workorder_repository.cpp \
     src/data/repositories/session_repository.cpp \
+    src/data/repositories/counter_repository.cpp \
     src/data/logging/db_logger.cpp \
     # 业务逻辑层
     src/business/exceptions/business_exception.cpp \
     src/business/logging/business_logger.cpp \
     src/business/managers/workorder_status_manager.cpp \
+    src/business/managers/session_activity_tracker.cpp \
+    src/business/managers/session_timer_wheel.cpp \
+    src/business/managers/user_cache.cpp \
     src/business/services/user_service.cpp \
     src/business/services/workorder_service.cpp \
     src/business/services/session_service.cpp \
@@ -46,6 +57,9 @@ SOURCES += \
     src/network/network_server.cpp \
     src/network/connection_manager.cpp \
     src/network/server/tcp_server.cpp \
+    src/network/server/io_worker.cpp \
+    src/network/server/io_worker_pool.cpp \
+    src/network/server/send_queue.cpp \
     src/network/protocol/message_router.cpp \
     src/network/protocol/protocol_handler.cpp \
     src/network/protocol/protocol_handlers/user_handler.cpp \
@@ -58,17 +72,25 @@ HEADERS += \
     # 数据库层
     src/data/databasemanager.h \
     src/data/base/db_base.h \
+    src/data/base/connection_pool.h \
+    src/data/base/db_executor.h \
+    src/data/base/group_commit_writer.h \
+    src/data/base/unit_of_work.h \
     src/data/models/user_model.h \
     src/data/models/workorder_model.h \
     src/data/models/session_model.h \
     src/data/repositories/user_repository.h \
     src/data/repositories/workorder_repository.h \
     src/data/repositories/session_repository.h \
+    src/data/repositories/counter_repository.h \
     src/data/logging/db_logger.h \
     # 业务逻辑层
     src/business/exceptions/business_exception.h \
     src/business/logging/business_logger.h \
     src/business/managers/workorder_status_manager.h \
+    src/business/managers/session_activity_tracker.h \
+    src/business/managers/session_timer_wheel.h \
+    src/business/managers/user_cache.h \
     src/business/services/user_service.h \
     src/business/services/workorder_service.h \
     src/business/services/session_service.h \
@@ -78,6 +100,9 @@ HEADERS += \
     src/network/network_server.h \
     src/network/connection_manager.h \
     src/network/server/tcp_server.h \
+    src/network/server/io_worker.h \
+    src/network/server/io_worker_pool.h \
+    src/network/server/send_queue.h \
     src/network/protocol/message_router.h \
     src/network/protocol/protocol_handler.h \
     src/network/protocol/protocol_handlers/user_handler.h \
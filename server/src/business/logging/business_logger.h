@@ -16,6 +16,12 @@ public:
     static void info(const QString &operation, const QString &message);
     static void debug(const QString &operation, const QString &message);
     
+    // 调试级别是否开启，用于跳过热路径上的消息构造
+    static bool isDebugEnabled()
+    {
+        return LogManager::getInstance()->isEnabled(LogModule::SYSTEM, LogLayer::BUSINESS, LogLevel::DEBUG);
+    }
+    
     // 业务操作日志
     static void businessOperationStart(const QString &operation, const QString &context = QString());
     static void businessOperationSuccess(const QString &operation, const QString &result = QString());
@@ -66,4 +72,8 @@ private:
     static QString formatSessionInfo(const QString &sessionId, int userId, const QString &roomId);
 };
 
+// 业务层惰性调试日志：级别未开启时不求值消息参数
+#define BUSINESS_LOG_DEBUG(operation, message) \
+    LOG_DEBUG(LogModule::SYSTEM, LogLayer::BUSINESS, operation, message)
+
 #endif // BUSINESS_LOGGER_H
@@ -0,0 +1,213 @@
+#include "session_activity_tracker.h"
+#include "../logging/business_logger.h"
+#include "../../data/repositories/session_repository.h"
+
+SessionActivityTracker::SessionActivityTracker(SessionRepository* sessionRepo, QObject *parent)
+    : QObject(parent)
+    , sessionRepo_(sessionRepo)
+    , wheel_(QDateTime::currentMSecsSinceEpoch())
+    , timeoutMinutes_(120)
+    , flushTimer_(new QTimer(this))
+    , flushIntervalSeconds_(5)
+{
+    // 定时把脏数据批量写回数据库（默认每5秒一次）
+    connect(flushTimer_, &QTimer::timeout, this, &SessionActivityTracker::onFlushTimer);
+    flushTimer_->start(flushIntervalSeconds_ * 1000);
+}
+
+SessionActivityTracker::~SessionActivityTracker()
+{
+    if (flushTimer_) {
+        flushTimer_->stop();
+    }
+    // 退出前把尚未写回的活动时间落盘
+    flush();
+}
+
+void SessionActivityTracker::track(const SessionModel& session)
+{
+    if (session.sessionId.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(&mutex_);
+
+    Entry entry;
+    entry.dbId = session.id;
+    entry.lastActivity = session.lastActivity.isValid() ? session.lastActivity : QDateTime::currentDateTime();
+    entry.expiresAt = session.expiresAt;
+    entry.dirty = false;
+    entries_.insert(session.sessionId, entry);
+    wheel_.schedule(session.sessionId, entryDeadline(entry, timeoutMinutes_));
+}
+
+void SessionActivityTracker::forget(const QString& sessionId)
+{
+    QMutexLocker locker(&mutex_);
+    entries_.remove(sessionId);
+    wheel_.cancel(sessionId);
+}
+
+bool SessionActivityTracker::contains(const QString& sessionId) const
+{
+    QMutexLocker locker(&mutex_);
+    return entries_.contains(sessionId);
+}
+
+SessionActivityTracker::TouchResult SessionActivityTracker::touch(const QString& sessionId, int timeoutMinutes)
+{
+    QMutexLocker locker(&mutex_);
+
+    auto it = entries_.find(sessionId);
+    if (it == entries_.end()) {
+        return TOUCH_UNKNOWN;
+    }
+
+    QDateTime now = QDateTime::currentDateTime();
+    if (isEntryExpired(it.value(), now, timeoutMinutes)) {
+        return TOUCH_EXPIRED;
+    }
+
+    it->lastActivity = now;
+    it->dirty = true;
+    return TOUCH_OK;
+}
+
+bool SessionActivityTracker::isExpired(const QString& sessionId, int timeoutMinutes, bool* known) const
+{
+    QMutexLocker locker(&mutex_);
+
+    auto it = entries_.constFind(sessionId);
+    if (it == entries_.constEnd()) {
+        if (known) *known = false;
+        return false;
+    }
+
+    if (known) *known = true;
+    return isEntryExpired(it.value(), QDateTime::currentDateTime(), timeoutMinutes);
+}
+
+QStringList SessionActivityTracker::collectExpired(int timeoutMinutes)
+{
+    QMutexLocker locker(&mutex_);
+    timeoutMinutes_ = timeoutMinutes;
+
+    const QDateTime now = QDateTime::currentDateTime();
+    QStringList expired;
+    for (const QString& sessionId : wheel_.advance(now.toMSecsSinceEpoch())) {
+        auto it = entries_.find(sessionId);
+        if (it == entries_.end()) {
+            continue;
+        }
+
+        if (isEntryExpired(it.value(), now, timeoutMinutes)) {
+            entries_.erase(it);
+            expired.append(sessionId);
+        } else {
+            // touch 只更新内存中的活动时间，不移动定时器，到点时再按最新期限登记
+            wheel_.schedule(sessionId, entryDeadline(it.value(), timeoutMinutes));
+        }
+    }
+    return expired;
+}
+
+void SessionActivityTracker::setFlushInterval(int seconds)
+{
+    if (seconds <= 0) {
+        BusinessLogger::warning("Session Activity Tracker", QString("Invalid flush interval: %1").arg(seconds));
+        return;
+    }
+
+    flushIntervalSeconds_ = seconds;
+    flushTimer_->start(flushIntervalSeconds_ * 1000);
+    BusinessLogger::info("Session Activity Tracker", QString("Flush interval set to %1 seconds").arg(seconds));
+}
+
+int SessionActivityTracker::getFlushInterval() const
+{
+    return flushIntervalSeconds_;
+}
+
+int SessionActivityTracker::flush()
+{
+    if (!sessionRepo_) {
+        return 0;
+    }
+
+    // 在锁内取出脏数据并清除标记，数据库写入在锁外进行
+    QHash<int, QDateTime> pending;
+    {
+        QMutexLocker locker(&mutex_);
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (it->dirty && it->dbId > 0) {
+                pending.insert(it->dbId, it->lastActivity);
+                it->dirty = false;
+            }
+        }
+    }
+
+    if (pending.isEmpty()) {
+        return 0;
+    }
+
+    if (!sessionRepo_->updateLastActivityBatch(pending)) {
+        // 写回失败，重新标记为脏，等待下一次写回
+        QMutexLocker locker(&mutex_);
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (pending.contains(it->dbId)) {
+                it->dirty = true;
+            }
+        }
+        BusinessLogger::error("Session Activity Tracker",
+                              QString("Failed to flush %1 session activities").arg(pending.size()));
+        return 0;
+    }
+
+    BUSINESS_LOG_DEBUG("Session Activity Tracker",
+                          QString("Flushed %1 session activities").arg(pending.size()));
+    return pending.size();
+}
+
+int SessionActivityTracker::trackedCount() const
+{
+    QMutexLocker locker(&mutex_);
+    return entries_.size();
+}
+
+int SessionActivityTracker::dirtyCount() const
+{
+    QMutexLocker locker(&mutex_);
+    int count = 0;
+    for (const Entry& entry : entries_) {
+        if (entry.dirty) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void SessionActivityTracker::onFlushTimer()
+{
+    flush();
+}
+
+bool SessionActivityTracker::isEntryExpired(const Entry& entry, const QDateTime& now, int timeoutMinutes) const
+{
+    // 检查过期时间
+    if (entry.expiresAt.isValid() && now > entry.expiresAt) {
+        return true;
+    }
+
+    // 检查最后活动时间（超过超时时间视为过期）
+    return now > entry.lastActivity.addSecs(timeoutMinutes * 60);
+}
+
+qint64 SessionActivityTracker::entryDeadline(const Entry& entry, int timeoutMinutes) const
+{
+    // 与 isEntryExpired 一致：取固定过期时间与活动超时中较早者，严格大于才算过期，故加1毫秒
+    qint64 deadline = entry.lastActivity.addSecs(timeoutMinutes * 60).toMSecsSinceEpoch();
+    if (entry.expiresAt.isValid()) {
+        deadline = qMin(deadline, entry.expiresAt.toMSecsSinceEpoch());
+    }
+    return deadline + 1;
+}
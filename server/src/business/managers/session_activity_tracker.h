@@ -0,0 +1,82 @@
+#ifndef SESSION_ACTIVITY_TRACKER_H
+#define SESSION_ACTIVITY_TRACKER_H
+
+#include <QObject>
+#include <QHash>
+#include <QString>
+#include <QDateTime>
+#include <QMutex>
+#include <QTimer>
+#include "session_timer_wheel.h"
+#include "../../data/models/session_model.h"
+
+class SessionRepository;
+
+// 会话活动跟踪器 - 在内存中维护会话的最后活动时间与过期时间
+// 每次收包只更新内存表并标记为脏，由定时器按批次写回数据库（write-behind）
+// 会话到期时间登记在时间轮中，到期检查只处理当前tick的槽位，与会话总数无关
+class SessionActivityTracker : public QObject
+{
+    Q_OBJECT
+public:
+    // 活动更新结果
+    enum TouchResult {
+        TOUCH_OK,        // 已更新
+        TOUCH_UNKNOWN,   // 内存表中没有该会话，需要从数据库加载
+        TOUCH_EXPIRED    // 会话已过期
+    };
+
+    explicit SessionActivityTracker(SessionRepository* sessionRepo, QObject *parent = nullptr);
+    ~SessionActivityTracker();
+
+    // 会话登记与移除
+    void track(const SessionModel& session);
+    void forget(const QString& sessionId);
+    bool contains(const QString& sessionId) const;
+
+    // 更新会话活动（只写内存）
+    TouchResult touch(const QString& sessionId, int timeoutMinutes);
+
+    // 过期判断（基于内存表），未登记的会话返回false并置known为false
+    bool isExpired(const QString& sessionId, int timeoutMinutes, bool* known = nullptr) const;
+
+    // 推进时间轮，返回已过期的会话ID（同时从内存表移除）
+    // 到点但因活动延长了期限的会话按新期限重新登记
+    QStringList collectExpired(int timeoutMinutes);
+
+    // 写回设置
+    void setFlushInterval(int seconds);
+    int getFlushInterval() const;
+
+    // 立即把所有脏数据写回数据库，返回写回的行数
+    int flush();
+
+    // 统计信息
+    int trackedCount() const;
+    int dirtyCount() const;
+
+private slots:
+    void onFlushTimer();
+
+private:
+    // 内存中的会话条目
+    struct Entry {
+        int dbId = -1;
+        QDateTime lastActivity;
+        QDateTime expiresAt;
+        bool dirty = false;
+    };
+
+    bool isEntryExpired(const Entry& entry, const QDateTime& now, int timeoutMinutes) const;
+    qint64 entryDeadline(const Entry& entry, int timeoutMinutes) const;
+
+    SessionRepository* sessionRepo_;
+    QHash<QString, Entry> entries_;
+    SessionTimerWheel wheel_;
+    int timeoutMinutes_;    // 登记时计算到期时间所用，由 collectExpired 更新
+    QTimer* flushTimer_;
+    int flushIntervalSeconds_;
+    mutable QMutex mutex_;
+};
+
+#endif // SESSION_ACTIVITY_TRACKER_H
@@ -0,0 +1,108 @@
+#include "session_timer_wheel.h"
+
+SessionTimerWheel::SessionTimerWheel(qint64 startMs, qint64 tickMs)
+    : tickMs_(qMax<qint64>(1, tickMs))
+    , currentTick_(startMs / tickMs_)
+{
+}
+
+void SessionTimerWheel::schedule(const QString& key, qint64 deadlineMs)
+{
+    const qint64 deadlineTick = (deadlineMs + tickMs_ - 1) / tickMs_;
+    cancel(key);
+    place(key, qMax(deadlineTick, currentTick_ + 1));
+}
+
+bool SessionTimerWheel::cancel(const QString& key)
+{
+    auto it = timers_.find(key);
+    if (it == timers_.end()) {
+        return false;
+    }
+
+    slots_[it->level][it->slot].remove(key);
+    timers_.erase(it);
+    return true;
+}
+
+void SessionTimerWheel::clear()
+{
+    for (int level = 0; level < LEVELS; ++level) {
+        for (int slot = 0; slot < SLOTS; ++slot) {
+            slots_[level][slot].clear();
+        }
+    }
+    timers_.clear();
+}
+
+QStringList SessionTimerWheel::advance(qint64 nowMs)
+{
+    QStringList expired;
+    const qint64 nowTick = nowMs / tickMs_;
+
+    // 时间轮为空时直接跳到当前时间
+    if (timers_.isEmpty()) {
+        currentTick_ = qMax(currentTick_, nowTick);
+        return expired;
+    }
+
+    while (currentTick_ < nowTick) {
+        ++currentTick_;
+
+        // 低层转满一圈时，从上层取出下一段的定时器重新分配
+        for (int level = 1; level < LEVELS; ++level) {
+            if ((currentTick_ >> (SLOT_BITS * level - SLOT_BITS)) & (SLOTS - 1)) {
+                break;
+            }
+            cascade(level);
+        }
+
+        QSet<QString>& slot = slots_[0][currentTick_ & (SLOTS - 1)];
+        for (const QString& key : slot) {
+            timers_.remove(key);
+            expired.append(key);
+        }
+        slot.clear();
+
+        if (timers_.isEmpty()) {
+            currentTick_ = nowTick;
+        }
+    }
+
+    return expired;
+}
+
+void SessionTimerWheel::place(const QString& key, qint64 deadlineTick)
+{
+    qint64 delta = deadlineTick - currentTick_;
+    const qint64 maxDelta = (qint64(1) << (SLOT_BITS * LEVELS)) - 1;
+    if (delta > maxDelta) {
+        deadlineTick = currentTick_ + maxDelta;
+        delta = maxDelta;
+    }
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (qint64(1) << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+
+    Timer timer;
+    timer.deadlineTick = deadlineTick;
+    timer.level = level;
+    timer.slot = int((deadlineTick >> (SLOT_BITS * level)) & (SLOTS - 1));
+    slots_[level][timer.slot].insert(key);
+    timers_.insert(key, timer);
+}
+
+void SessionTimerWheel::cascade(int level)
+{
+    const int index = int((currentTick_ >> (SLOT_BITS * level)) & (SLOTS - 1));
+    const QSet<QString> moving = slots_[level][index];
+    slots_[level][index].clear();
+
+    for (const QString& key : moving) {
+        const qint64 deadlineTick = timers_.value(key).deadlineTick;
+        timers_.remove(key);
+        place(key, deadlineTick);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef SESSION_TIMER_WHEEL_H
+#define SESSION_TIMER_WHEEL_H
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+// 分层时间轮 - 按会话ID登记到期时间，登记/取消 O(1)，每个tick只处理当前槽位
+// 共 LEVELS 层、每层 SLOTS 个槽位：第0层每槽一个tick，上层每槽覆盖下层一整圈，
+// 上层槽位到点时把其中的定时器重新分配到下层（级联）。超出最大范围的到期时间按最大范围登记。
+// 非线程安全，由调用方加锁。
+class SessionTimerWheel
+{
+public:
+    // 从 startMs（毫秒时间戳）开始计时
+    SessionTimerWheel(qint64 startMs, qint64 tickMs = 1000);
+
+    // 登记或更新到期时间（毫秒时间戳），已过期的在下一个tick触发
+    void schedule(const QString& key, qint64 deadlineMs);
+    bool cancel(const QString& key);
+    void clear();
+
+    // 推进到 nowMs，返回期间到期的键（已从时间轮移除）
+    QStringList advance(qint64 nowMs);
+
+    int size() const { return timers_.size(); }
+    qint64 tickMs() const { return tickMs_; }
+
+private:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const int LEVELS = 4;    // 1秒tick时约覆盖194天
+
+    struct Timer {
+        qint64 deadlineTick;
+        int level;
+        int slot;
+    };
+
+    void place(const QString& key, qint64 deadlineTick);
+    void cascade(int level);
+
+    QHash<QString, Timer> timers_;
+    QSet<QString> slots_[LEVELS][SLOTS];
+    qint64 tickMs_;
+    qint64 currentTick_;
+};
+
+#endif // SESSION_TIMER_WHEEL_H
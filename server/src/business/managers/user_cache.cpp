@@ -0,0 +1,128 @@
+#include "user_cache.h"
+#include <QMutexLocker>
+
+UserCache::UserCache(int capacity)
+    : capacity_(qMax(1, capacity))
+    , generation_(0)
+    , clearedAt_(0)
+    , hits_(0)
+    , misses_(0)
+    , evictions_(0)
+{
+}
+
+bool UserCache::find(int userId, UserModel& user)
+{
+    QMutexLocker locker(&mutex_);
+    auto it = byId_.constFind(userId);
+    if (it == byId_.constEnd()) {
+        ++misses_;
+        return false;
+    }
+    return takeHit(it.value(), user);
+}
+
+bool UserCache::find(const QString& username, UserModel& user)
+{
+    QMutexLocker locker(&mutex_);
+    auto idIt = idByUsername_.constFind(username);
+    if (idIt == idByUsername_.constEnd()) {
+        ++misses_;
+        return false;
+    }
+    return takeHit(byId_.value(idIt.value()), user);
+}
+
+quint64 UserCache::generation() const
+{
+    QMutexLocker locker(&mutex_);
+    return generation_;
+}
+
+void UserCache::put(const UserModel& user, quint64 generation)
+{
+    if (!user.isValid()) {
+        return;
+    }
+
+    QMutexLocker locker(&mutex_);
+    // 查库期间被失效，读到的可能是修改前的数据
+    if (clearedAt_ > generation || invalidatedAt_.value(user.id, 0) > generation) {
+        return;
+    }
+
+    auto existing = byId_.constFind(user.id);
+    if (existing != byId_.constEnd()) {
+        removeEntry(existing.value());
+    }
+
+    entries_.push_front(user);
+    byId_.insert(user.id, entries_.begin());
+    idByUsername_.insert(user.username, user.id);
+
+    while (int(entries_.size()) > capacity_) {
+        removeEntry(std::prev(entries_.end()));
+        ++evictions_;
+    }
+}
+
+void UserCache::invalidate(int userId)
+{
+    QMutexLocker locker(&mutex_);
+    invalidatedAt_.insert(userId, ++generation_);
+    auto it = byId_.constFind(userId);
+    if (it != byId_.constEnd()) {
+        removeEntry(it.value());
+    }
+}
+
+void UserCache::clear()
+{
+    QMutexLocker locker(&mutex_);
+    entries_.clear();
+    byId_.clear();
+    idByUsername_.clear();
+    // 清空后旧的按用户记录不再需要，统一用 clearedAt_ 拦住清空前开始的查询
+    invalidatedAt_.clear();
+    clearedAt_ = ++generation_;
+}
+
+void UserCache::setCapacity(int capacity)
+{
+    QMutexLocker locker(&mutex_);
+    capacity_ = qMax(1, capacity);
+    while (int(entries_.size()) > capacity_) {
+        removeEntry(std::prev(entries_.end()));
+        ++evictions_;
+    }
+}
+
+UserCacheStats UserCache::stats() const
+{
+    QMutexLocker locker(&mutex_);
+    UserCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.size = int(entries_.size());
+    stats.capacity = capacity_;
+    return stats;
+}
+
+bool UserCache::takeHit(EntryList::iterator it, UserModel& user)
+{
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it);
+    user = *it;
+    return true;
+}
+
+void UserCache::removeEntry(EntryList::iterator it)
+{
+    byId_.remove(it->id);
+    // 用户名可能已被更新后的条目占用，只删除仍指向本条目的映射
+    if (idByUsername_.value(it->username, -1) == it->id) {
+        idByUsername_.remove(it->username);
+    }
+    entries_.erase(it);
+}
@@ -0,0 +1,63 @@
+#ifndef USER_CACHE_H
+#define USER_CACHE_H
+
+#include <QHash>
+#include <QString>
+#include <QMutex>
+#include <list>
+#include "../../data/models/user_model.h"
+
+// 用户缓存统计
+struct UserCacheStats {
+    quint64 hits = 0;
+    quint64 misses = 0;
+    quint64 evictions = 0;
+    int size = 0;
+    int capacity = 0;
+};
+
+// 用户缓存 - 按ID和用户名索引的LRU缓存，可在多个数据库线程中并发访问
+// 只缓存查到的用户；修改用户后由 UserService 负责使缓存失效
+// 查库前先取 generation()，put 时带回：查库期间该用户被 invalidate 过则不写入，避免旧数据回填
+class UserCache
+{
+public:
+    explicit UserCache(int capacity = 1024);
+
+    // 命中时复制到user并移到最近使用端
+    bool find(int userId, UserModel& user);
+    bool find(const QString& username, UserModel& user);
+
+    // 失效计数快照，查库前获取
+    quint64 generation() const;
+
+    // 插入或替换，超出容量时淘汰最久未使用的条目；
+    // 快照之后该用户被失效过（或缓存被清空）时不写入
+    void put(const UserModel& user, quint64 generation);
+
+    void invalidate(int userId);
+    void clear();
+
+    void setCapacity(int capacity);
+    UserCacheStats stats() const;
+
+private:
+    typedef std::list<UserModel> EntryList;
+
+    bool takeHit(EntryList::iterator it, UserModel& user);
+    void removeEntry(EntryList::iterator it);
+
+    EntryList entries_;                             // 头部为最近使用
+    QHash<int, EntryList::iterator> byId_;
+    QHash<QString, int> idByUsername_;
+    QHash<int, quint64> invalidatedAt_;            // 用户ID -> 最近一次失效时的计数
+    quint64 generation_;                            // 每次失效加一
+    quint64 clearedAt_;
+    int capacity_;
+    quint64 hits_;
+    quint64 misses_;
+    quint64 evictions_;
+    mutable QMutex mutex_;
+};
+
+#endif // USER_CACHE_H
@@ -7,10 +7,17 @@ SessionService::SessionService(DatabaseManager* dbManager, QObject *parent)
     : QObject(parent)
     , dbManager_(dbManager)
     , sessionRepo_(dbManager->sessionRepository())
+    , counterRepo_(dbManager->counterRepository())
     , cleanupTimer_(new QTimer(this))
+    , expiryTimer_(new QTimer(this))
+    , activityTracker_(new SessionActivityTracker(sessionRepo_, this))
     , sessionTimeoutMinutes_(120)
 {
-    // 设置定时清理过期会话（每5分钟执行一次）
+    // 内存中的会话按时间轮逐秒检查到期
+    connect(expiryTimer_, &QTimer::timeout, this, &SessionService::onExpiryTick);
+    expiryTimer_->start(1000);
+    
+    // 未加载到内存的会话（如重启前创建的）由定时清理兜底（每5分钟执行一次）
     connect(cleanupTimer_, &QTimer::timeout, this, &SessionService::onCleanupTimer);
     cleanupTimer_->start(5 * 60 * 1000); // 5分钟
     
@@ -22,6 +29,9 @@ SessionService::~SessionService()
     if (cleanupTimer_) {
         cleanupTimer_->stop();
     }
+    if (expiryTimer_) {
+        expiryTimer_->stop();
+    }
     BusinessLogger::info("Session Service", "Session service destroyed");
 }
 
@@ -55,7 +65,9 @@ QString SessionService::createSession(int userId, const QString& roomId, int tim
         bool success = sessionRepo_->create(session, dbSessionId);
         
         if (success) {
+            counterRepo_->invalidate(CounterDomain::SESSION);
             session.id = dbSessionId;
+            activityTracker_->track(session);
             triggerSessionCreatedEvent(session);
             logSessionActivity("Create Session", sessionId, true);
             BusinessLogger::businessOperationSuccess("Create Session", sessionId);
@@ -74,41 +86,34 @@ QString SessionService::createSession(int userId, const QString& roomId, int tim
 
 bool SessionService::updateSessionActivity(const QString& sessionId)
 {
-    BusinessLogger::businessOperationStart("Update Session Activity", sessionId);
+    // 热路径：每次收包都会调用，只更新内存表，由活动跟踪器按批次写回数据库
+    SessionActivityTracker::TouchResult result = activityTracker_->touch(sessionId, sessionTimeoutMinutes_);
     
-    try {
-        // 获取会话信息
+    if (result == SessionActivityTracker::TOUCH_UNKNOWN) {
+        // 内存表中没有该会话（例如服务重启前创建的会话），从数据库加载一次
         SessionModel session = getSession(sessionId);
-        if (!session.isValid()) {
+        if (!session.isValid() || session.status != SessionModel::STATUS_ACTIVE) {
             BusinessLogger::businessOperationFailed("Update Session Activity", "Session not found");
             return false;
         }
         
-        // 检查会话是否已过期
-        if (isSessionExpired(sessionId)) {
-            expireSession(sessionId);
-            BusinessLogger::businessOperationFailed("Update Session Activity", "Session expired");
-            return false;
-        }
-        
-        // 更新最后活动时间
-        bool success = sessionRepo_->updateLastActivity(session.id);
-        
-        if (success) {
-            triggerSessionActivityEvent(session);
-            logSessionActivity("Update Activity", sessionId, true);
-            BusinessLogger::businessOperationSuccess("Update Session Activity", sessionId);
-        } else {
-            logSessionActivity("Update Activity", sessionId, false, "Database operation failed");
-            BusinessLogger::businessOperationFailed("Update Session Activity", "Database operation failed");
-        }
-        
-        return success;
+        activityTracker_->track(session);
+        result = activityTracker_->touch(sessionId, sessionTimeoutMinutes_);
     }
-    catch (const BusinessException& e) {
-        BusinessLogger::businessOperationFailed("Update Session Activity", e.getMessage());
+    
+    if (result == SessionActivityTracker::TOUCH_EXPIRED) {
+        expireSession(sessionId);
+        BusinessLogger::businessOperationFailed("Update Session Activity", "Session expired");
         return false;
     }
+    
+    return true;
+}
+
+bool SessionService::touchSessionActivity(const QString& sessionId)
+{
+    // 只访问线程安全的内存表，不触碰数据库；返回false时需在主线程走updateSessionActivity
+    return activityTracker_->touch(sessionId, sessionTimeoutMinutes_) == SessionActivityTracker::TOUCH_OK;
 }
 
 bool SessionService::expireSession(const QString& sessionId)
@@ -122,9 +127,14 @@ bool SessionService::expireSession(const QString& sessionId)
             return false;
         }
         
+        // 先把内存中的活动时间写回，再从内存表移除
+        activityTracker_->flush();
+        activityTracker_->forget(sessionId);
+        
         bool success = sessionRepo_->expireSession(session.id);
         
         if (success) {
+            counterRepo_->invalidate(CounterDomain::SESSION);
             triggerSessionExpiredEvent(session);
             logSessionActivity("Expire Session", sessionId, true);
             BusinessLogger::businessOperationSuccess("Expire Session", sessionId);
@@ -146,13 +156,12 @@ bool SessionService::cleanupExpiredSessions()
     BusinessLogger::businessOperationStart("Cleanup Expired Sessions", "");
     
     try {
-        QList<SessionModel> expiredSessions = getExpiredSessions();
-        int cleanedCount = 0;
-        
-        for (const SessionModel& session : expiredSessions) {
-            if (removeSession(session.sessionId)) {
-                cleanedCount++;
-            }
+        // 先让时间轮移除内存中已过期的会话，再用一条DELETE清理数据库
+        activityTracker_->collectExpired(sessionTimeoutMinutes_);
+        int cleanedCount = removeExpiredSessions();
+        if (cleanedCount < 0) {
+            BusinessLogger::businessOperationFailed("Cleanup Expired Sessions", "Database operation failed");
+            return false;
         }
         
         BusinessLogger::businessOperationSuccess("Cleanup Expired Sessions", 
@@ -198,6 +207,13 @@ QList<SessionModel> SessionService::getExpiredSessions()
 // 会话验证
 bool SessionService::isSessionValid(const QString& sessionId)
 {
+    // 内存表中只保存活跃会话，命中时无需查询数据库
+    bool known = false;
+    bool expired = activityTracker_->isExpired(sessionId, sessionTimeoutMinutes_, &known);
+    if (known) {
+        return !expired;
+    }
+    
     SessionModel session = getSession(sessionId);
     if (!session.isValid()) {
         return false;
@@ -219,6 +235,13 @@ bool SessionService::isUserInRoom(int userId, const QString& roomId)
 
 bool SessionService::isSessionExpired(const QString& sessionId)
 {
+    // 优先使用内存表中的最新活动时间
+    bool known = false;
+    bool expired = activityTracker_->isExpired(sessionId, sessionTimeoutMinutes_, &known);
+    if (known) {
+        return expired;
+    }
+    
     SessionModel session = getSession(sessionId);
     if (!session.isValid()) {
         return true;
@@ -239,17 +262,20 @@ bool SessionService::isSessionExpired(const QString& sessionId)
 // 会话统计
 int SessionService::getActiveSessionCount()
 {
-    return sessionRepo_->countByStatus(SessionModel::STATUS_ACTIVE);
+    int count = counterRepo_->count(CounterScope::SESSION_STATUS, SessionModel::STATUS_ACTIVE);
+    return count >= 0 ? count : sessionRepo_->countByStatus(SessionModel::STATUS_ACTIVE);
 }
 
 int SessionService::getUserSessionCount(int userId)
 {
-    return sessionRepo_->countByUserId(userId);
+    int count = counterRepo_->count(CounterScope::SESSION_USER, userId);
+    return count >= 0 ? count : sessionRepo_->countByUserId(userId);
 }
 
 int SessionService::getRoomSessionCount(const QString& roomId)
 {
-    return sessionRepo_->countByRoomId(roomId);
+    int count = counterRepo_->count(CounterScope::SESSION_ROOM, roomId);
+    return count >= 0 ? count : sessionRepo_->countByRoomId(roomId);
 }
 
 // 会话管理
@@ -264,9 +290,12 @@ bool SessionService::removeSession(const QString& sessionId)
             return false;
         }
         
+        activityTracker_->forget(sessionId);
+        
         bool success = sessionRepo_->remove(session.id);
         
         if (success) {
+            counterRepo_->invalidate(CounterDomain::SESSION);
             logSessionActivity("Remove Session", sessionId, true);
             BusinessLogger::businessOperationSuccess("Remove Session", sessionId);
         } else {
@@ -342,12 +371,37 @@ int SessionService::getSessionTimeout() const
     return sessionTimeoutMinutes_;
 }
 
+// 活动时间写回设置
+void SessionService::setActivityFlushInterval(int seconds)
+{
+    activityTracker_->setFlushInterval(seconds);
+}
+
+bool SessionService::flushSessionActivity()
+{
+    activityTracker_->flush();
+    return activityTracker_->dirtyCount() == 0;
+}
+
 // 私有槽函数
 void SessionService::onCleanupTimer()
 {
     cleanupExpiredSessions();
 }
 
+void SessionService::onExpiryTick()
+{
+    // 每个tick只处理时间轮当前槽位，没有会话到期时不访问数据库
+    QStringList expired = activityTracker_->collectExpired(sessionTimeoutMinutes_);
+    if (expired.isEmpty()) {
+        return;
+    }
+    
+    int removedCount = removeExpiredSessions();
+    BUSINESS_LOG_DEBUG("Session Service", QString("%1 sessions expired, %2 rows removed")
+                         .arg(expired.size()).arg(removedCount));
+}
+
 // 私有辅助方法
 QString SessionService::generateSessionId()
 {
@@ -359,6 +413,20 @@ QDateTime SessionService::calculateExpiryTime(int timeoutMinutes)
     return QDateTime::currentDateTime().addSecs(timeoutMinutes * 60);
 }
 
+int SessionService::removeExpiredSessions()
+{
+    // 删除前先写回活动时间，避免活跃会话被误判为过期
+    activityTracker_->flush();
+    
+    QDateTime now = QDateTime::currentDateTime();
+    // 与 findExpiredSessions 一致：活跃会话1小时无活动视为过期
+    int removed = sessionRepo_->removeExpired(now, now.addSecs(-3600));
+    if (removed > 0) {
+        counterRepo_->invalidate(CounterDomain::SESSION);
+    }
+    return removed;
+}
+
 void SessionService::logSessionActivity(const QString& operation, const QString& sessionId, bool success, const QString& reason)
 {
     if (success) {
@@ -415,6 +483,6 @@ void SessionService::triggerSessionExpiredEvent(const SessionModel& session)
 
 void SessionService::triggerSessionActivityEvent(const SessionModel& session)
 {
-    BusinessLogger::debug("Session Service", QString("Session activity event: %1 for user %2 in room %3")
+    BUSINESS_LOG_DEBUG("Session Service", QString("Session activity event: %1 for user %2 in room %3")
                          .arg(session.sessionId).arg(session.userId).arg(session.roomId));
 }
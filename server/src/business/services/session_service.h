@@ -3,9 +3,11 @@
 
 #include "../exceptions/business_exception.h"
 #include "../logging/business_logger.h"
+#include "../managers/session_activity_tracker.h"
 #include "../../data/databasemanager.h"
 #include "../../data/models/session_model.h"
 #include "../../data/repositories/session_repository.h"
+#include "../../data/repositories/counter_repository.h"
 #include <QObject>
 #include <QJsonObject>
 #include <QTimer>
@@ -21,6 +23,7 @@ public:
     // 会话生命周期管理
     QString createSession(int userId, const QString& roomId, int timeoutMinutes = 120);
     bool updateSessionActivity(const QString& sessionId);
+    bool touchSessionActivity(const QString& sessionId);  // 仅更新内存，可在I/O线程调用
     bool expireSession(const QString& sessionId);
     bool cleanupExpiredSessions();
     
@@ -49,19 +52,28 @@ public:
     // 会话超时设置
     void setSessionTimeout(int minutes);
     int getSessionTimeout() const;
+    
+    // 活动时间写回设置
+    void setActivityFlushInterval(int seconds);
+    bool flushSessionActivity();
 
 private slots:
     void onCleanupTimer();
+    void onExpiryTick();
 
 private:
     DatabaseManager* dbManager_;
     SessionRepository* sessionRepo_;
+    CounterRepository* counterRepo_;
     QTimer* cleanupTimer_;
+    QTimer* expiryTimer_;
+    SessionActivityTracker* activityTracker_;
     int sessionTimeoutMinutes_;
     
     // 私有辅助方法
     QString generateSessionId();
     QDateTime calculateExpiryTime(int timeoutMinutes);
+    int removeExpiredSessions();
     void logSessionActivity(const QString& operation, const QString& sessionId, bool success, const QString& reason = QString());
     
     // 业务验证方法
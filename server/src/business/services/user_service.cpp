@@ -2,15 +2,17 @@
 #include <QCryptographicHash>
 
 UserService::UserService(DatabaseManager* dbManager, QObject *parent)
-    : QObject(parent), dbManager_(dbManager), userRepo_(dbManager->userRepository())
+    : QObject(parent), dbManager_(dbManager), userRepo_(dbManager->userRepository()), counterRepo_(dbManager->counterRepository())
 {
     // 创建会话服务
     sessionService_ = new SessionService(dbManager, this);
+    userCache_ = new UserCache();
     BusinessLogger::info("User Service", "User service initialized");
 }
 
 UserService::~UserService()
 {
+    delete userCache_;
     BusinessLogger::info("User Service", "User service destroyed");
 }
 
@@ -77,6 +79,7 @@ bool UserService::registerUser(const QString& username, const QString& password,
         bool success = userRepo_->create(user, userId);
         
         if (success) {
+            counterRepo_->invalidate(CounterDomain::USER);
             BusinessLogger::userRegistration(username, userType, true);
             BusinessLogger::businessOperationSuccess("User Registration", QString("User ID: %1").arg(userId));
         } else {
@@ -127,7 +130,7 @@ UserModel UserService::getUserInfo(const QString& username)
     
     try {
         UserModel user;
-        if (userRepo_->findByUsername(username, user)) {
+        if (loadUser(username, user)) {
             BusinessLogger::businessOperationSuccess("Get User Info", username);
             return user;
         } else {
@@ -147,7 +150,7 @@ UserModel UserService::getUserInfo(int userId)
     
     try {
         UserModel user;
-        if (userRepo_->findById(userId, user)) {
+        if (loadUser(userId, user)) {
             BusinessLogger::businessOperationSuccess("Get User Info", QString::number(userId));
             return user;
         } else {
@@ -178,6 +181,10 @@ bool UserService::updateUserInfo(const UserModel& user)
         // 更新用户信息
         bool success = userRepo_->update(user);
         
+        // 用户名可能已变更，按ID失效会同时移除旧用户名索引
+        userCache_->invalidate(user.id);
+        counterRepo_->invalidate(CounterDomain::USER);
+        
         if (success) {
             BusinessLogger::businessOperationSuccess("Update User Info", user.username);
         } else {
@@ -220,6 +227,7 @@ bool UserService::updatePassword(int userId, const QString& oldPassword, const Q
         // 哈希新密码并更新
         QString newPasswordHash = userRepo_->hashPassword(newPassword);
         bool success = userRepo_->updatePassword(userId, newPasswordHash);
+        userCache_->invalidate(userId);
         
         if (success) {
             BusinessLogger::businessOperationSuccess("Update Password", QString::number(userId));
@@ -255,6 +263,8 @@ bool UserService::updateUserType(int userId, int newUserType)
         
         // 更新用户类型
         bool success = userRepo_->updateUserType(userId, newUserType);
+        userCache_->invalidate(userId);
+        counterRepo_->invalidate(CounterDomain::USER);
         
         if (success) {
             BusinessLogger::businessOperationSuccess("Update User Type", QString::number(userId));
@@ -310,7 +320,11 @@ int UserService::getUserCount(int userType)
     BusinessLogger::businessOperationStart("Get User Count");
     
     try {
-        int count = (userType >= 0) ? userRepo_->countByUserType(userType) : userRepo_->countAll();
+        int count = (userType >= 0) ? counterRepo_->count(CounterScope::USER_TYPE, userType)
+                                    : counterRepo_->count(CounterScope::USER_ALL);
+        if (count < 0) {
+            count = (userType >= 0) ? userRepo_->countByUserType(userType) : userRepo_->countAll();
+        }
         BusinessLogger::businessOperationSuccess("Get User Count", QString::number(count));
         return count;
     }
@@ -323,39 +337,46 @@ int UserService::getUserCount(int userType)
 // 用户状态检查
 bool UserService::userExists(const QString& username)
 {
-    return userRepo_->exists(username);
+    UserModel user;
+    return loadUser(username, user);
 }
 
 bool UserService::userExists(int userId)
 {
     UserModel user;
-    return userRepo_->findById(userId, user);
+    return loadUser(userId, user);
 }
 
 int UserService::getUserId(const QString& username)
 {
-    return userRepo_->getUserId(username);
+    UserModel user;
+    return loadUser(username, user) ? user.id : -1;
 }
 
 int UserService::getUserType(const QString& username)
 {
-    return userRepo_->getUserType(username);
+    UserModel user;
+    return loadUser(username, user) ? user.userType : -1;
 }
 
 // 权限检查
 bool UserService::hasPermission(int userId, const QString& operation)
 {
-    // 这里可以实现更复杂的权限检查逻辑
-    // 目前简单返回true，后续可以扩展
-    BusinessLogger::permissionCheck(operation, userId, true);
-    return true;
+    // 用户信息从缓存获取，热点用户不再访问数据库
+    // 目前只要求用户存在，后续可以按用户类型扩展
+    UserModel user;
+    const bool allowed = loadUser(userId, user);
+    BusinessLogger::permissionCheck(operation, userId, allowed);
+    return allowed;
 }
 
 bool UserService::canAccessWorkOrder(int userId, int workOrderId)
 {
+    Q_UNUSED(workOrderId)
     // 这里可以实现工单访问权限检查逻辑
-    // 目前简单返回true，后续可以扩展
-    return true;
+    // 目前只要求用户存在，后续可以扩展
+    UserModel user;
+    return loadUser(userId, user);
 }
 
 bool UserService::canModifyWorkOrder(int userId, int workOrderId)
@@ -370,7 +391,7 @@ bool UserService::validateUserCredentials(const QString& username, const QString
 {
     // 获取用户信息
     UserModel user;
-    if (!userRepo_->findByUsername(username, user)) {
+    if (!loadUser(username, user)) {
         return false;
     }
     
@@ -458,7 +479,7 @@ bool UserService::validateUserUpdate(const UserModel& user)
     
     // 检查用户名是否已被其他用户使用
     UserModel existingUser;
-    if (userRepo_->findByUsername(user.username, existingUser) && existingUser.id != user.id) {
+    if (loadUser(user.username, existingUser) && existingUser.id != user.id) {
         BusinessLogger::validationFailed("User Update", "username", "Username already exists");
         return false;
     }
@@ -608,3 +629,48 @@ SessionService* UserService::getSessionService() const
 {
     return sessionService_;
 }
+
+UserCacheStats UserService::userCacheStats() const
+{
+    return userCache_->stats();
+}
+
+void UserService::logStatistics() const
+{
+    const UserCacheStats stats = userCache_->stats();
+    const quint64 total = stats.hits + stats.misses;
+    BusinessLogger::info("User Service", QString("用户缓存: %1/%2, 命中: %3, 未命中: %4, 淘汰: %5, 命中率: %6%")
+                         .arg(stats.size)
+                         .arg(stats.capacity)
+                         .arg(stats.hits)
+                         .arg(stats.misses)
+                         .arg(stats.evictions)
+                         .arg(total > 0 ? 100.0 * stats.hits / total : 0.0, 0, 'f', 1));
+}
+
+// 用户缓存
+bool UserService::loadUser(int userId, UserModel& user)
+{
+    if (userCache_->find(userId, user)) {
+        return true;
+    }
+    const quint64 generation = userCache_->generation();
+    if (!userRepo_->findById(userId, user)) {
+        return false;
+    }
+    userCache_->put(user, generation);
+    return true;
+}
+
+bool UserService::loadUser(const QString& username, UserModel& user)
+{
+    if (userCache_->find(username, user)) {
+        return true;
+    }
+    const quint64 generation = userCache_->generation();
+    if (!userRepo_->findByUsername(username, user)) {
+        return false;
+    }
+    userCache_->put(user, generation);
+    return true;
+}
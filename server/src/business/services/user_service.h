@@ -7,7 +7,9 @@
 #include "../../data/databasemanager.h"
 #include "../../data/models/user_model.h"
 #include "../../data/repositories/user_repository.h"
+#include "../../data/repositories/counter_repository.h"
 #include "session_service.h"
+#include "../managers/user_cache.h"
 #include "../../../common/protocol/types/enums.h"
 #include <QObject>
 #include <QJsonObject>
@@ -61,11 +63,21 @@ public:
     
     // 获取服务实例
     SessionService* getSessionService() const;
+    
+    // 用户缓存
+    UserCacheStats userCacheStats() const;
+    void logStatistics() const;
 
 private:
     DatabaseManager* dbManager_;
     UserRepository* userRepo_;
+    CounterRepository* counterRepo_;
     SessionService* sessionService_;
+    UserCache* userCache_;
+    
+    // 先查缓存，未命中时读库并写入缓存
+    bool loadUser(int userId, UserModel& user);
+    bool loadUser(const QString& username, UserModel& user);
     
     // 私有辅助方法
     bool validateUserCredentials(const QString& username, const QString& password, int userType);
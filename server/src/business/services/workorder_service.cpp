@@ -3,7 +3,7 @@
 #include "../../data/models/user_model.h"
 
 WorkOrderService::WorkOrderService(DatabaseManager* dbManager, UserService* userService, QObject *parent)
-    : QObject(parent), dbManager_(dbManager), workOrderRepo_(dbManager->workOrderRepository()), userService_(userService)
+    : QObject(parent), dbManager_(dbManager), workOrderRepo_(dbManager->workOrderRepository()), counterRepo_(dbManager->counterRepository()), userService_(userService)
 {
     BusinessLogger::info("Work Order Service", "Work order service initialized");
 }
@@ -62,13 +62,15 @@ bool WorkOrderService::createWorkOrder(const QString& title, const QString& desc
         BusinessLogger::info("Work Order Service", QString("Work order model prepared - AssignedTo: %1, Status: %2").arg(workOrder.assignedTo).arg(workOrder.status));
         
         // 保存工单
+        // 工单与创建者参与记录在同一事务中写入
         int workOrderId = -1;
-        bool success = workOrderRepo_->create(workOrder, workOrderId);
+        bool success = dbManager_->runInTransaction([&]() {
+            return workOrderRepo_->create(workOrder, workOrderId) &&
+                   workOrderRepo_->addParticipant(workOrderId, creatorId, ParticipantModel::ROLE_CREATOR);
+        });
         
         if (success) {
-            // 自动将创建者添加为参与者
-            workOrderRepo_->addParticipant(workOrderId, creatorId, ParticipantModel::ROLE_CREATOR);
-            
+            counterRepo_->invalidate(CounterDomain::WORKORDER);
             BusinessLogger::workOrderCreated(generatedTicketId, creatorId, true);
             BusinessLogger::businessOperationSuccess("Work Order Creation", QString("Work order ID: %1, Ticket ID: %2, Expert: %3").arg(workOrderId).arg(generatedTicketId).arg(expertUsername));
         } else {
@@ -105,9 +107,12 @@ bool WorkOrderService::updateWorkOrder(const WorkOrderModel& workOrder)
         }
         
         // 更新工单
-        bool success = workOrderRepo_->update(workOrder);
+        bool success = dbManager_->runInTransaction([&]() {
+            return workOrderRepo_->update(workOrder);
+        });
         
         if (success) {
+            counterRepo_->invalidate(CounterDomain::WORKORDER);
             BusinessLogger::workOrderUpdated(workOrder.ticketId, "Work order updated", true);
             BusinessLogger::businessOperationSuccess("Work Order Update", workOrder.ticketId);
         } else {
@@ -147,9 +152,12 @@ bool WorkOrderService::deleteWorkOrder(int workOrderId, int userId)
         }
         
         // 删除工单
-        bool success = workOrderRepo_->remove(workOrderId);
+        bool success = dbManager_->runInTransaction([&]() {
+            return workOrderRepo_->remove(workOrderId);
+        });
         
         if (success) {
+            counterRepo_->invalidate(CounterDomain::WORKORDER);
             BusinessLogger::businessOperationSuccess("Work Order Deletion", QString::number(workOrderId));
         } else {
             BusinessLogger::businessOperationFailed("Work Order Deletion", "Database operation failed");
@@ -204,63 +212,138 @@ WorkOrderModel WorkOrderService::getWorkOrderByTicketId(const QString& ticketId)
     }
 }
 
-QList<WorkOrderModel> WorkOrderService::getWorkOrdersByStatus(const QString& status, int limit, int offset)
+QList<WorkOrderSummary> WorkOrderService::getWorkOrdersByStatus(const QString& status, int limit, int offset)
 {
     BusinessLogger::businessOperationStart("Get Work Orders By Status", status);
     
     try {
-        QList<WorkOrderModel> workOrders = workOrderRepo_->findByStatus(status);
+        QList<WorkOrderSummary> workOrders = workOrderRepo_->findByStatus(status, limit, offset);
         BusinessLogger::businessOperationSuccess("Get Work Orders By Status", QString("Found %1 work orders").arg(workOrders.size()));
         return workOrders;
     }
     catch (const BusinessException& e) {
         BusinessLogger::businessOperationFailed("Get Work Orders By Status", e.getMessage());
-        return QList<WorkOrderModel>();
+        return QList<WorkOrderSummary>();
     }
 }
 
-QList<WorkOrderModel> WorkOrderService::getWorkOrdersByCreator(int creatorId, int limit, int offset)
+QList<WorkOrderSummary> WorkOrderService::getWorkOrdersByCreator(int creatorId, int limit, int offset)
 {
     BusinessLogger::businessOperationStart("Get Work Orders By Creator", QString::number(creatorId));
     
     try {
-        QList<WorkOrderModel> workOrders = workOrderRepo_->findByCreator(creatorId);
+        QList<WorkOrderSummary> workOrders = workOrderRepo_->findByCreator(creatorId, limit, offset);
         BusinessLogger::businessOperationSuccess("Get Work Orders By Creator", QString("Found %1 work orders").arg(workOrders.size()));
         return workOrders;
     }
     catch (const BusinessException& e) {
         BusinessLogger::businessOperationFailed("Get Work Orders By Creator", e.getMessage());
-        return QList<WorkOrderModel>();
+        return QList<WorkOrderSummary>();
     }
 }
 
-QList<WorkOrderModel> WorkOrderService::getWorkOrdersByAssignee(int assigneeId, int limit, int offset)
+QList<WorkOrderSummary> WorkOrderService::getWorkOrdersByAssignee(int assigneeId, int limit, int offset)
 {
     BusinessLogger::businessOperationStart("Get Work Orders By Assignee", QString::number(assigneeId));
     
     try {
-        QList<WorkOrderModel> workOrders = workOrderRepo_->findByAssignee(assigneeId);
+        QList<WorkOrderSummary> workOrders = workOrderRepo_->findByAssignee(assigneeId, limit, offset);
         BusinessLogger::businessOperationSuccess("Get Work Orders By Assignee", QString("Found %1 work orders").arg(workOrders.size()));
         return workOrders;
     }
     catch (const BusinessException& e) {
         BusinessLogger::businessOperationFailed("Get Work Orders By Assignee", e.getMessage());
-        return QList<WorkOrderModel>();
+        return QList<WorkOrderSummary>();
     }
 }
 
-QList<WorkOrderModel> WorkOrderService::getAllWorkOrders(int limit, int offset)
+QList<WorkOrderSummary> WorkOrderService::getAllWorkOrders(int limit, int offset)
 {
     BusinessLogger::businessOperationStart("Get All Work Orders");
     
     try {
-        QList<WorkOrderModel> workOrders = workOrderRepo_->findAll(limit, offset);
+        QList<WorkOrderSummary> workOrders = workOrderRepo_->findAll(limit, offset);
         BusinessLogger::businessOperationSuccess("Get All Work Orders", QString("Found %1 work orders").arg(workOrders.size()));
         return workOrders;
     }
     catch (const BusinessException& e) {
         BusinessLogger::businessOperationFailed("Get All Work Orders", e.getMessage());
-        return QList<WorkOrderModel>();
+        return QList<WorkOrderSummary>();
+    }
+}
+
+WorkOrderPage WorkOrderService::getWorkOrderPageByStatus(const QString& status, const QString& cursor, int limit)
+{
+    BusinessLogger::businessOperationStart("Get Work Order Page By Status", status);
+    
+    try {
+        WorkOrderPage page = workOrderRepo_->findPageByStatus(status, cursor, limit);
+        BusinessLogger::businessOperationSuccess("Get Work Order Page By Status", QString("Found %1 work orders, has more: %2").arg(page.items.size()).arg(page.hasMore));
+        return page;
+    }
+    catch (const BusinessException& e) {
+        BusinessLogger::businessOperationFailed("Get Work Order Page By Status", e.getMessage());
+        return WorkOrderPage();
+    }
+}
+
+WorkOrderPage WorkOrderService::getWorkOrderPageByCreator(int creatorId, const QString& cursor, int limit)
+{
+    BusinessLogger::businessOperationStart("Get Work Order Page By Creator", QString::number(creatorId));
+    
+    try {
+        WorkOrderPage page = workOrderRepo_->findPageByCreator(creatorId, cursor, limit);
+        BusinessLogger::businessOperationSuccess("Get Work Order Page By Creator", QString("Found %1 work orders, has more: %2").arg(page.items.size()).arg(page.hasMore));
+        return page;
+    }
+    catch (const BusinessException& e) {
+        BusinessLogger::businessOperationFailed("Get Work Order Page By Creator", e.getMessage());
+        return WorkOrderPage();
+    }
+}
+
+WorkOrderPage WorkOrderService::getWorkOrderPageByAssignee(int assigneeId, const QString& cursor, int limit)
+{
+    BusinessLogger::businessOperationStart("Get Work Order Page By Assignee", QString::number(assigneeId));
+    
+    try {
+        WorkOrderPage page = workOrderRepo_->findPageByAssignee(assigneeId, cursor, limit);
+        BusinessLogger::businessOperationSuccess("Get Work Order Page By Assignee", QString("Found %1 work orders, has more: %2").arg(page.items.size()).arg(page.hasMore));
+        return page;
+    }
+    catch (const BusinessException& e) {
+        BusinessLogger::businessOperationFailed("Get Work Order Page By Assignee", e.getMessage());
+        return WorkOrderPage();
+    }
+}
+
+WorkOrderPage WorkOrderService::searchWorkOrdersByCreator(const QString& text, int creatorId, const QString& cursor, int limit)
+{
+    BusinessLogger::businessOperationStart("Search Work Orders By Creator", QString("Creator: %1, Text: %2").arg(creatorId).arg(text));
+    
+    try {
+        WorkOrderPage page = workOrderRepo_->searchByCreator(text, creatorId, cursor, limit);
+        BusinessLogger::businessOperationSuccess("Search Work Orders By Creator", QString("Found %1 work orders, has more: %2").arg(page.items.size()).arg(page.hasMore));
+        return page;
+    }
+    catch (const BusinessException& e) {
+        BusinessLogger::businessOperationFailed("Search Work Orders By Creator", e.getMessage());
+        return WorkOrderPage();
+    }
+}
+
+WorkOrderPage WorkOrderService::searchWorkOrdersByAssignee(const QString& text, int assigneeId, const QString& cursor, int limit)
+{
+    BusinessLogger::businessOperationStart("Search Work Orders By Assignee", QString("Assignee: %1, Text: %2").arg(assigneeId).arg(text));
+    
+    try {
+        WorkOrderPage page = workOrderRepo_->searchByAssignee(text, assigneeId, cursor, limit);
+        BusinessLogger::businessOperationSuccess("Search Work Orders By Assignee", QString("Found %1 work orders, has more: %2").arg(page.items.size()).arg(page.hasMore));
+        return page;
+    }
+    catch (const BusinessException& e) {
+        BusinessLogger::businessOperationFailed("Search Work Orders By Assignee", e.getMessage());
+        return WorkOrderPage();
     }
 }
 
@@ -287,9 +370,12 @@ bool WorkOrderService::updateWorkOrderStatus(int workOrderId, const QString& new
         }
         
         // 更新状态
-        bool success = workOrderRepo_->updateStatus(workOrderId, newStatus);
+        bool success = dbManager_->runInTransaction([&]() {
+            return workOrderRepo_->updateStatus(workOrderId, newStatus);
+        });
         
         if (success) {
+            counterRepo_->invalidate(CounterDomain::WORKORDER);
             BusinessLogger::workOrderStatusChanged(workOrder.ticketId, workOrder.status, newStatus, true);
             BusinessLogger::businessOperationSuccess("Work Order Status Update", QString("Status changed from %1 to %2").arg(workOrder.status).arg(newStatus));
         } else {
@@ -333,10 +419,14 @@ bool WorkOrderService::closeWorkOrder(int workOrderId, int userId)
         }
         
         // 关闭工单
-        bool success = workOrderRepo_->updateStatus(workOrderId, WorkOrderStatusManager::CLOSED) &&
-                      workOrderRepo_->updateClosedAt(workOrderId, QDateTime::currentDateTime());
+        const QDateTime closedAt = QDateTime::currentDateTime();
+        bool success = dbManager_->runInTransaction([&]() {
+            return workOrderRepo_->updateStatus(workOrderId, WorkOrderStatusManager::CLOSED) &&
+                   workOrderRepo_->updateClosedAt(workOrderId, closedAt);
+        });
         
         if (success) {
+            counterRepo_->invalidate(CounterDomain::WORKORDER);
             BusinessLogger::workOrderClosed(workOrder.ticketId, userId, true);
             BusinessLogger::businessOperationSuccess("Work Order Close", workOrder.ticketId);
         } else {
@@ -384,9 +474,12 @@ bool WorkOrderService::assignWorkOrder(int workOrderId, int assigneeId, int assi
         }
         
         // 分配工单
-        bool success = workOrderRepo_->updateAssignee(workOrderId, assigneeId);
+        bool success = dbManager_->runInTransaction([&]() {
+            return workOrderRepo_->updateAssignee(workOrderId, assigneeId);
+        });
         
         if (success) {
+            counterRepo_->invalidate(CounterDomain::WORKORDER);
             BusinessLogger::workOrderAssigned("", assigneeId, true);
             BusinessLogger::businessOperationSuccess("Work Order Assignment", QString("Work order %1 assigned to user %2").arg(workOrderId).arg(assigneeId));
         } else {
@@ -420,9 +513,12 @@ bool WorkOrderService::unassignWorkOrder(int workOrderId, int assignerId)
         }
         
         // 取消分配工单
-        bool success = workOrderRepo_->updateAssignee(workOrderId, -1); // 设置为-1表示未分配
+        bool success = dbManager_->runInTransaction([&]() {
+            return workOrderRepo_->updateAssignee(workOrderId, -1); // 设置为-1表示未分配
+        });
         
         if (success) {
+            counterRepo_->invalidate(CounterDomain::WORKORDER);
             BusinessLogger::businessOperationSuccess("Work Order Unassignment", QString::number(workOrderId));
         } else {
             BusinessLogger::businessOperationFailed("Work Order Unassignment", "Database operation failed");
@@ -452,7 +548,9 @@ bool WorkOrderService::addParticipant(int workOrderId, int userId, const QString
         }
         
         // 添加参与者
-        bool success = workOrderRepo_->addParticipant(workOrderId, userId, role, permissions);
+        bool success = dbManager_->runInTransaction([&]() {
+            return workOrderRepo_->addParticipant(workOrderId, userId, role, permissions);
+        });
         
         if (success) {
             BusinessLogger::businessOperationSuccess("Add Work Order Participant", QString("User %1 added to work order %2").arg(userId).arg(workOrderId));
@@ -484,7 +582,9 @@ bool WorkOrderService::removeParticipant(int workOrderId, int userId)
         }
         
         // 移除参与者
-        bool success = workOrderRepo_->removeParticipant(workOrderId, userId);
+        bool success = dbManager_->runInTransaction([&]() {
+            return workOrderRepo_->removeParticipant(workOrderId, userId);
+        });
         
         if (success) {
             BusinessLogger::businessOperationSuccess("Remove Work Order Participant", QString("User %1 removed from work order %2").arg(userId).arg(workOrderId));
@@ -515,7 +615,9 @@ bool WorkOrderService::updateParticipantRole(int workOrderId, int userId, const
         }
         
         // 更新参与者角色
-        bool success = workOrderRepo_->updateParticipantRole(workOrderId, userId, newRole);
+        bool success = dbManager_->runInTransaction([&]() {
+            return workOrderRepo_->updateParticipantRole(workOrderId, userId, newRole);
+        });
         
         if (success) {
             BusinessLogger::businessOperationSuccess("Update Participant Role", QString("User %1 role updated to %2").arg(userId).arg(newRole));
@@ -561,7 +663,11 @@ int WorkOrderService::getWorkOrderCount(const QString& status)
     BusinessLogger::businessOperationStart("Get Work Order Count", status.isEmpty() ? "All" : status);
     
     try {
-        int count = status.isEmpty() ? workOrderRepo_->countAll() : workOrderRepo_->countByStatus(status);
+        int count = status.isEmpty() ? counterRepo_->count(CounterScope::WORKORDER_ALL)
+                                     : counterRepo_->count(CounterScope::WORKORDER_STATUS, status);
+        if (count < 0) {
+            count = status.isEmpty() ? workOrderRepo_->countAll() : workOrderRepo_->countByStatus(status);
+        }
         BusinessLogger::businessOperationSuccess("Get Work Order Count", QString::number(count));
         return count;
     }
@@ -573,12 +679,14 @@ int WorkOrderService::getWorkOrderCount(const QString& status)
 
 int WorkOrderService::getWorkOrderCountByCreator(int creatorId)
 {
-    return workOrderRepo_->countByCreator(creatorId);
+    int count = counterRepo_->count(CounterScope::WORKORDER_CREATOR, creatorId);
+    return count >= 0 ? count : workOrderRepo_->countByCreator(creatorId);
 }
 
 int WorkOrderService::getWorkOrderCountByAssignee(int assigneeId)
 {
-    return workOrderRepo_->countByAssignee(assigneeId);
+    int count = counterRepo_->count(CounterScope::WORKORDER_ASSIGNEE, assigneeId);
+    return count >= 0 ? count : workOrderRepo_->countByAssignee(assigneeId);
 }
 
 // 权限检查
@@ -8,6 +8,7 @@
 #include "../../data/databasemanager.h"
 #include "../../data/models/workorder_model.h"
 #include "../../data/repositories/workorder_repository.h"
+#include "../../data/repositories/counter_repository.h"
 #include "user_service.h"
 #include <QObject>
 #include <QJsonObject>
@@ -30,13 +31,22 @@ public:
     bool updateWorkOrder(const WorkOrderModel& workOrder);
     bool deleteWorkOrder(int workOrderId, int userId);
     
-    // 工单查询
+    // 工单查询（列表返回摘要，详情按ID或工单号查询）
     WorkOrderModel getWorkOrderById(int workOrderId);
     WorkOrderModel getWorkOrderByTicketId(const QString& ticketId);
-    QList<WorkOrderModel> getWorkOrdersByStatus(const QString& status, int limit = -1, int offset = 0);
-    QList<WorkOrderModel> getWorkOrdersByCreator(int creatorId, int limit = -1, int offset = 0);
-    QList<WorkOrderModel> getWorkOrdersByAssignee(int assigneeId, int limit = -1, int offset = 0);
-    QList<WorkOrderModel> getAllWorkOrders(int limit = -1, int offset = 0);
+    QList<WorkOrderSummary> getWorkOrdersByStatus(const QString& status, int limit = -1, int offset = 0);
+    QList<WorkOrderSummary> getWorkOrdersByCreator(int creatorId, int limit = -1, int offset = 0);
+    QList<WorkOrderSummary> getWorkOrdersByAssignee(int assigneeId, int limit = -1, int offset = 0);
+    QList<WorkOrderSummary> getAllWorkOrders(int limit = -1, int offset = 0);
+    
+    // 键集分页查询（按创建时间倒序），cursor 为空表示第一页
+    WorkOrderPage getWorkOrderPageByStatus(const QString& status, const QString& cursor, int limit);
+    WorkOrderPage getWorkOrderPageByCreator(int creatorId, const QString& cursor, int limit);
+    WorkOrderPage getWorkOrderPageByAssignee(int assigneeId, const QString& cursor, int limit);
+    
+    // 工单全文搜索（按相关度排序，分页同上）
+    WorkOrderPage searchWorkOrdersByCreator(const QString& text, int creatorId, const QString& cursor, int limit);
+    WorkOrderPage searchWorkOrdersByAssignee(const QString& text, int assigneeId, const QString& cursor, int limit);
     
     // 工单状态管理
     bool updateWorkOrderStatus(int workOrderId, const QString& newStatus, int userId);
@@ -55,7 +65,7 @@ public:
     QList<ParticipantModel> getWorkOrderParticipants(int workOrderId);
     bool isParticipant(int workOrderId, int userId);
     
-    // 工单统计
+    // 工单统计（读取计数镜像，O(1)）
     int getWorkOrderCount(const QString& status = QString());
     int getWorkOrderCountByCreator(int creatorId);
     int getWorkOrderCountByAssignee(int assigneeId);
@@ -72,6 +82,7 @@ public:
 private:
     DatabaseManager* dbManager_;
     WorkOrderRepository* workOrderRepo_;
+    CounterRepository* counterRepo_;
     UserService* userService_;
     
     // 私有辅助方法
@@ -0,0 +1,195 @@
+#include "connection_pool.h"
+#include "../logging/db_logger.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QMutexLocker>
+
+void ConnectionPool::ThreadConnection::clearStatements()
+{
+    registry->statementCount.fetch_sub(statements.size(), std::memory_order_relaxed);
+    qDeleteAll(statements);
+    statements.clear();
+}
+
+void ConnectionPool::ThreadConnection::close()
+{
+    // 先释放语句和句柄再移除连接，否则 Qt 会提示连接仍在使用
+    clearStatements();
+    db.close();
+    db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(name);
+    registry->connections.remove(name);
+}
+
+ConnectionPool::ThreadConnection::~ThreadConnection()
+{
+    // 已被连接池析构关闭时不在登记表中
+    QMutexLocker locker(&registry->mutex);
+    if (registry->connections.value(name) == this) {
+        close();
+    }
+}
+
+ConnectionPool::ConnectionPool(const ConnectionPoolOptions& options, QObject *parent)
+    : QObject(parent)
+    , options_(options)
+    , registry_(std::make_shared<Registry>())
+    , nextId_(0)
+    , statementHits_(0)
+    , statementMisses_(0)
+{
+}
+
+ConnectionPool::~ConnectionPool()
+{
+    releaseThreadConnection();
+
+    // 其余线程仍持有连接对象，这里只关闭连接；对象在线程退出时释放（本析构之后退出的线程不会释放，只剩空壳）
+    QMutexLocker locker(&registry_->mutex);
+    if (!registry_->connections.isEmpty()) {
+        DBLogger::warning("连接池", QString("关闭 %1 个未退出工作线程的连接").arg(registry_->connections.size()));
+    }
+    const QList<ThreadConnection*> remaining = registry_->connections.values();
+    for (ThreadConnection* tc : remaining) {
+        tc->close();
+    }
+}
+
+bool ConnectionPool::initialize()
+{
+    QSqlDatabase& db = connection();
+    if (!db.isOpen()) {
+        return false;
+    }
+
+    // journal_mode 记录在数据库文件中，只需设置一次
+    if (options_.walMode) {
+        QSqlQuery query(db);
+        if (!query.exec("PRAGMA journal_mode = WAL") || !query.next()) {
+            DBLogger::error("连接池初始化", query.lastError());
+            return false;
+        }
+        const QString mode = query.value(0).toString();
+        if (mode.compare("wal", Qt::CaseInsensitive) != 0) {
+            // 例如数据库位于不支持共享内存的文件系统上
+            DBLogger::warning("连接池初始化", QString("无法启用WAL模式，当前日志模式: %1").arg(mode));
+        }
+    }
+
+    DBLogger::info("连接池初始化", QString("数据库: %1, synchronous=%2, cache=%3KiB, mmap=%4MiB, busy_timeout=%5ms")
+                   .arg(options_.databasePath)
+                   .arg(options_.synchronous)
+                   .arg(options_.cacheSizeKiB)
+                   .arg(options_.mmapSizeBytes / (1024 * 1024))
+                   .arg(options_.busyTimeoutMs));
+    return true;
+}
+
+QSqlDatabase& ConnectionPool::connection()
+{
+    ThreadConnection* tc = connections_.localData();
+    if (!tc) {
+        tc = new ThreadConnection;
+        tc->registry = registry_;
+        tc->name = QString("%1_%2").arg(options_.connectionPrefix).arg(nextId_.fetch_add(1));
+        tc->db = QSqlDatabase::addDatabase("QSQLITE", tc->name);
+        connections_.setLocalData(tc);
+
+        QMutexLocker locker(&registry_->mutex);
+        registry_->connections.insert(tc->name, tc);
+    }
+
+    // 打开失败时下次调用重试，调用方通过 isOpen() 判断；重新打开后旧语句作废
+    if (!tc->db.isOpen()) {
+        tc->clearStatements();
+        openConnection(tc->db);
+    }
+    return tc->db;
+}
+
+QSqlQuery& ConnectionPool::cachedQuery(const QString& statementId, const QString& sql)
+{
+    QSqlDatabase& db = connection();
+    ThreadConnection* tc = connections_.localData();
+
+    CachedStatement* statement = tc->statements.value(statementId, nullptr);
+    if (statement && statement->prepared) {
+        statementHits_.fetch_add(1, std::memory_order_relaxed);
+        statement->query.finish();
+        return statement->query;
+    }
+
+    statementMisses_.fetch_add(1, std::memory_order_relaxed);
+    if (!statement) {
+        statement = new CachedStatement(db);
+        // 只向前遍历结果，SQLite 驱动无需缓存已读行
+        statement->query.setForwardOnly(true);
+        tc->statements.insert(statementId, statement);
+        registry_->statementCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // prepare 失败时保留错误，由调用方执行时报告，下次使用再重试
+    statement->prepared = statement->query.prepare(sql);
+    return statement->query;
+}
+
+StatementCacheStats ConnectionPool::statementCacheStats() const
+{
+    StatementCacheStats stats;
+    stats.hits = statementHits_.load(std::memory_order_relaxed);
+    stats.misses = statementMisses_.load(std::memory_order_relaxed);
+    stats.statements = registry_->statementCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void ConnectionPool::releaseThreadConnection()
+{
+    if (connections_.hasLocalData()) {
+        connections_.setLocalData(nullptr);
+    }
+}
+
+int ConnectionPool::openConnectionCount() const
+{
+    QMutexLocker locker(&registry_->mutex);
+    return registry_->connections.size();
+}
+
+bool ConnectionPool::openConnection(QSqlDatabase& db)
+{
+    db.setDatabaseName(options_.databasePath);
+    db.setConnectOptions(QString("QSQLITE_BUSY_TIMEOUT=%1").arg(options_.busyTimeoutMs));
+
+    if (!db.open()) {
+        DBLogger::connectionFailed(db.connectionName(), db.lastError().text());
+        return false;
+    }
+
+    if (!applyPragmas(db)) {
+        db.close();
+        return false;
+    }
+
+    DBLogger::connectionEstablished(db.connectionName());
+    return true;
+}
+
+bool ConnectionPool::applyPragmas(QSqlDatabase& db)
+{
+    // 连接级参数，每个新连接都需要设置；cache_size 取负值表示以 KiB 为单位
+    const QStringList pragmas = {
+        QString("PRAGMA synchronous = %1").arg(options_.synchronous),
+        QString("PRAGMA cache_size = -%1").arg(options_.cacheSizeKiB),
+        QString("PRAGMA mmap_size = %1").arg(options_.mmapSizeBytes),
+        "PRAGMA temp_store = MEMORY"
+    };
+
+    QSqlQuery query(db);
+    for (const QString& pragma : pragmas) {
+        if (!query.exec(pragma)) {
+            DBLogger::error("设置连接参数", query.lastError());
+            return false;
+        }
+    }
+    return true;
+}
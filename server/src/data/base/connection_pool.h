@@ -0,0 +1,97 @@
+#ifndef CONNECTION_POOL_H
+#define CONNECTION_POOL_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QThreadStorage>
+#include <QMutex>
+#include <QStringList>
+#include <QHash>
+#include <QSqlQuery>
+#include <atomic>
+#include <memory>
+
+// SQLite 连接参数
+struct ConnectionPoolOptions {
+    QString databasePath;
+    QString connectionPrefix = "remote_support_connection";
+    bool walMode = true;                        // WAL：读者与写者互不阻塞
+    QString synchronous = "NORMAL";             // WAL 下 NORMAL 只在检查点时 fsync，崩溃不损坏数据库
+    int cacheSizeKiB = 16 * 1024;               // 每个连接的页缓存
+    qint64 mmapSizeBytes = 256LL * 1024 * 1024; // 读路径直接映射数据库文件
+    int busyTimeoutMs = 5000;                   // 写锁被占用时的最长等待，超时返回 SQLITE_BUSY
+};
+
+// 预编译语句缓存统计
+struct StatementCacheStats {
+    quint64 hits = 0;
+    quint64 misses = 0;
+    int statements = 0;     // 各连接当前缓存的语句总数
+};
+
+// 数据库连接池 - 每个线程持有一个独立连接，线程结束时自动关闭
+// QSqlDatabase 连接只能在创建它的线程中使用，因此按线程而不是按请求分配连接
+// 析构时关闭仍未退出的线程的连接，须在各线程停止使用数据库后析构
+class ConnectionPool : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ConnectionPool(const ConnectionPoolOptions& options, QObject *parent = nullptr);
+    ~ConnectionPool();
+
+    // 打开调用线程的连接并设置数据库级参数（journal_mode）
+    bool initialize();
+
+    // 调用线程的连接，首次调用时创建并打开
+    QSqlDatabase& connection();
+
+    // 关闭调用线程的连接；其他线程的连接在线程退出或连接池析构时关闭
+    void releaseThreadConnection();
+
+    // 调用线程连接上的预编译语句：statementId 对应唯一的SQL文本，首次使用时 prepare，之后直接复用
+    // 返回的引用在连接关闭前有效
+    QSqlQuery& cachedQuery(const QString& statementId, const QString& sql);
+    StatementCacheStats statementCacheStats() const;
+
+    int openConnectionCount() const;
+    const ConnectionPoolOptions& options() const { return options_; }
+
+private:
+    struct ThreadConnection;
+
+    // 已打开的连接：线程退出时连接自行注销；连接池析构时关闭其余连接。
+    // 连接池析构后 QThreadStorage 不再清理各线程数据，因此必须在析构时关闭，不能留给线程退出
+    struct Registry {
+        QMutex mutex;
+        QHash<QString, ThreadConnection*> connections;
+        std::atomic<int> statementCount{0};
+    };
+
+    struct CachedStatement {
+        QSqlQuery query;
+        bool prepared = false;
+        explicit CachedStatement(const QSqlDatabase& db) : query(db) {}
+    };
+
+    struct ThreadConnection {
+        std::shared_ptr<Registry> registry;
+        QString name;
+        QSqlDatabase db;
+        QHash<QString, CachedStatement*> statements;  // 语句须先于连接释放
+        void clearStatements();
+        void close();       // 调用方持有 registry->mutex
+        ~ThreadConnection();
+    };
+
+    bool openConnection(QSqlDatabase& db);
+    bool applyPragmas(QSqlDatabase& db);
+
+    ConnectionPoolOptions options_;
+    std::shared_ptr<Registry> registry_;
+    QThreadStorage<ThreadConnection*> connections_;
+    std::atomic<int> nextId_;
+    std::atomic<quint64> statementHits_;
+    std::atomic<quint64> statementMisses_;
+};
+
+#endif // CONNECTION_POOL_H
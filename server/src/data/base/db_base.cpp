@@ -1,20 +1,60 @@
 #include "db_base.h"
+#include "connection_pool.h"
 #include "../logging/db_logger.h"
 
-DBBase::DBBase(QObject *parent) : QObject(parent) {}
+DBBase::DBBase(QObject *parent) : QObject(parent), pool_(nullptr) {}
 
-DBBase::~DBBase() {}
+DBBase::~DBBase()
+{
+    qDeleteAll(statements_);
+}
+
+QSqlDatabase& DBBase::database()
+{
+    return pool_ ? pool_->connection() : db_;
+}
+
+const QSqlDatabase& DBBase::database() const
+{
+    return pool_ ? pool_->connection() : db_;
+}
+
+PreparedStatement DBBase::prepareCached(const QString &statementId, const QString &sql)
+{
+    if (pool_) {
+        return PreparedStatement(pool_->cachedQuery(statementId, sql));
+    }
+    
+    QSqlQuery *query = statements_.value(statementId, nullptr);
+    if (!query) {
+        query = new QSqlQuery(db_);
+        query->setForwardOnly(true);
+        query->prepare(sql);
+        statements_.insert(statementId, query);
+    }
+    return PreparedStatement(*query);
+}
 
 bool DBBase::checkConnection(const QString &operation)
 {
-    if (!db_.isOpen()) {
-        lastError_ = QString("Database connection is not open for operation: %1").arg(operation);
-        DBLogger::error(operation, QSqlError(lastError_, "", QSqlError::ConnectionError));
+    if (!database().isOpen()) {
+        const QString error = QString("Database connection is not open for operation: %1").arg(operation);
+        {
+            QMutexLocker locker(&errorMutex_);
+            lastError_ = error;
+        }
+        DBLogger::error(operation, QSqlError(error, "", QSqlError::ConnectionError));
         return false;
     }
     return true;
 }
 
+QString DBBase::getLastError() const
+{
+    QMutexLocker locker(&errorMutex_);
+    return lastError_;
+}
+
 bool DBBase::executeQuery(QSqlQuery &query, const QString &operation)
 {
     if (!checkConnection(operation)) {
@@ -9,6 +9,26 @@
 
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QMutex>
+#include <QHash>
+
+class ConnectionPool;
+
+// 缓存语句句柄：离开作用域时 finish()，释放结果集并结束读快照，语句本身留在缓存中复用
+class PreparedStatement
+{
+public:
+    explicit PreparedStatement(QSqlQuery &query) : query_(query) {}
+    ~PreparedStatement() { query_.finish(); }
+
+    QSqlQuery &query() { return query_; }
+
+    PreparedStatement(const PreparedStatement&) = delete;
+    PreparedStatement& operator=(const PreparedStatement&) = delete;
+
+private:
+    QSqlQuery &query_;
+};
 
 class DBBase : public QObject
 {
@@ -20,9 +40,12 @@ public:
     // 设置数据库连接
     void setDatabase(QSqlDatabase &db) { db_ = db; }
     
-    // 获取数据库连接
-    QSqlDatabase& database() { return db_; }
-    const QSqlDatabase& database() const { return db_; }
+    // 设置连接池后，每个调用线程使用自己的连接，仓储方法可在任意线程调用
+    void setConnectionPool(ConnectionPool *pool) { pool_ = pool; }
+    
+    // 获取数据库连接（有连接池时为调用线程的连接）
+    QSqlDatabase& database();
+    const QSqlDatabase& database() const;
 
 protected:
     // 数据库连接检查
@@ -30,6 +53,10 @@ protected:
     
 
     
+    // 取得缓存的预编译语句（按调用线程的连接缓存），复用时重新绑定参数即可
+    // statementId 须与固定的SQL文本一一对应；拼接了变量的SQL不要缓存
+    PreparedStatement prepareCached(const QString &statementId, const QString &sql);
+    
     // 通用查询执行
     bool executeQuery(QSqlQuery &query, const QString &operation);
     
@@ -44,10 +71,13 @@ protected:
     QList<QSqlRecord> paginate(QSqlQuery &query, int page, int pageSize);
     
     // 获取最后的错误信息
-    QString getLastError() const { return lastError_; }
+    QString getLastError() const;
 
 private:
     QSqlDatabase db_;
+    ConnectionPool *pool_;
+    QHash<QString, QSqlQuery*> statements_;  // 未使用连接池时缓存在 db_ 上
+    mutable QMutex errorMutex_;
     QString lastError_;
 };
 
@@ -0,0 +1,27 @@
+#include "db_executor.h"
+#include "../logging/db_logger.h"
+
+DBExecutor::DBExecutor(int threadCount, QObject *parent)
+    : QObject(parent)
+    , pending_(0)
+{
+    threadPool_.setMaxThreadCount(qMax(1, threadCount));
+    // 线程常驻：线程退出会关闭其数据库连接，空闲回收会导致频繁重连
+    threadPool_.setExpiryTimeout(-1);
+
+    DBLogger::info("数据库执行器", QString("执行线程数: %1").arg(threadPool_.maxThreadCount()));
+}
+
+DBExecutor::~DBExecutor()
+{
+    shutdown();
+}
+
+void DBExecutor::shutdown()
+{
+    const int pending = pendingCount();
+    if (pending > 0) {
+        DBLogger::info("数据库执行器", QString("等待 %1 个数据库任务完成").arg(pending));
+    }
+    threadPool_.waitForDone();
+}
@@ -0,0 +1,59 @@
+#ifndef DB_EXECUTOR_H
+#define DB_EXECUTOR_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QFuture>
+#include <QPointer>
+#include <QtConcurrent/QtConcurrentRun>
+#include <atomic>
+#include <utility>
+
+// 数据库执行器 - 在专用线程上执行仓储/服务调用，避免阻塞网络线程
+// 每个执行线程从连接池取得自己的连接；WAL模式下读并发，写操作由SQLite串行（busy_timeout内等待）
+class DBExecutor : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DBExecutor(int threadCount = 2, QObject *parent = nullptr);
+    ~DBExecutor();
+
+    // 提交任务，通过future获取结果
+    template <typename Func>
+    auto submit(Func func) -> QFuture<decltype(func())>
+    {
+        return QtConcurrent::run(&threadPool_, std::move(func));
+    }
+
+    // 提交任务，完成后在 context 所在线程调用 callback(result)
+    // func 必须有返回值；context 被销毁时丢弃结果
+    template <typename Func, typename Callback>
+    void submit(QObject *context, Func func, Callback callback)
+    {
+        QPointer<QObject> guard(context);
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        QtConcurrent::run(&threadPool_, [this, guard, func, callback]() mutable {
+            auto result = func();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            QObject *target = guard.data();
+            if (!target) {
+                return;
+            }
+            QMetaObject::invokeMethod(target, [callback, result]() mutable {
+                callback(result);
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    // 等待已提交的任务执行完毕（关闭服务器时在释放业务服务之前调用）
+    void shutdown();
+
+    int threadCount() const { return threadPool_.maxThreadCount(); }
+    int pendingCount() const { return pending_.load(std::memory_order_relaxed); }
+
+private:
+    QThreadPool threadPool_;
+    std::atomic<int> pending_;
+};
+
+#endif // DB_EXECUTOR_H
@@ -0,0 +1,144 @@
+#include "group_commit_writer.h"
+#include "connection_pool.h"
+#include "unit_of_work.h"
+#include "../logging/db_logger.h"
+#include <QMutexLocker>
+#include <QElapsedTimer>
+
+GroupCommitWriter::GroupCommitWriter(ConnectionPool *pool, const GroupCommitOptions &options,
+                                     QObject *parent)
+    : QThread(parent)
+    , pool_(pool)
+    , options_(options)
+    , stopping_(false)
+    , batches_(0)
+    , tasks_(0)
+{
+    options_.windowMs = qMax(0, options_.windowMs);
+    options_.maxBatch = qMax(1, options_.maxBatch);
+    setObjectName("db-group-commit");
+}
+
+GroupCommitWriter::~GroupCommitWriter()
+{
+    stop();
+}
+
+bool GroupCommitWriter::execute(const std::function<bool()> &work)
+{
+    // 写线程内的嵌套调用直接以保存点执行，避免等待自己
+    if (QThread::currentThread() == this || UnitOfWork::inTransaction()) {
+        return executeInline(work);
+    }
+
+    Task task;
+    task.work = work;
+
+    QMutexLocker locker(&mutex_);
+    if (stopping_ || !isRunning()) {
+        locker.unlock();
+        return executeInline(work);
+    }
+
+    pending_.append(&task);
+    queueCondition_.wakeOne();
+    while (!task.done) {
+        doneCondition_.wait(&mutex_);
+    }
+    return task.success;
+}
+
+void GroupCommitWriter::stop()
+{
+    {
+        QMutexLocker locker(&mutex_);
+        stopping_ = true;
+        queueCondition_.wakeOne();
+    }
+    wait();
+}
+
+void GroupCommitWriter::run()
+{
+    QMutexLocker locker(&mutex_);
+    for (;;) {
+        while (pending_.isEmpty() && !stopping_) {
+            queueCondition_.wait(&mutex_);
+        }
+        if (pending_.isEmpty()) {
+            break;
+        }
+
+        // 在时间窗口内继续收集，直到凑满一批
+        if (!stopping_ && options_.windowMs > 0) {
+            QElapsedTimer window;
+            window.start();
+            qint64 remaining = options_.windowMs;
+            while (pending_.size() < options_.maxBatch && remaining > 0 && !stopping_) {
+                queueCondition_.wait(&mutex_, static_cast<unsigned long>(remaining));
+                remaining = options_.windowMs - window.elapsed();
+            }
+        }
+
+        const QList<Task*> batch = pending_.mid(0, options_.maxBatch);
+        pending_.erase(pending_.begin(), pending_.begin() + batch.size());
+
+        locker.unlock();
+        commitBatch(batch);
+        locker.relock();
+
+        for (Task *task : batch) {
+            task->done = true;
+        }
+        doneCondition_.wakeAll();
+    }
+
+    // 线程退出时连接池会关闭本线程的连接
+    pool_->releaseThreadConnection();
+}
+
+bool GroupCommitWriter::executeInline(const std::function<bool()> &work)
+{
+    UnitOfWork unit(pool_->connection());
+    if (!unit.isActive()) {
+        return false;
+    }
+    if (!work()) {
+        unit.rollback();
+        return false;
+    }
+    return unit.commit();
+}
+
+void GroupCommitWriter::commitBatch(const QList<Task*> &batch)
+{
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    tasks_.fetch_add(batch.size(), std::memory_order_relaxed);
+
+    UnitOfWork transaction(pool_->connection());
+    if (!transaction.isActive()) {
+        for (Task *task : batch) {
+            task->success = false;
+        }
+        return;
+    }
+
+    for (Task *task : batch) {
+        UnitOfWork savepoint(pool_->connection());
+        bool success = false;
+        try {
+            success = savepoint.isActive() && task->work();
+        } catch (...) {
+            DBLogger::error("组提交", "写操作抛出异常，已回滚该组");
+            success = false;
+        }
+        task->success = success ? savepoint.commit() : false;
+    }
+
+    // 整批提交失败时所有组都未落盘
+    if (!transaction.commit()) {
+        for (Task *task : batch) {
+            task->success = false;
+        }
+    }
+}
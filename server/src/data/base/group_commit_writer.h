@@ -0,0 +1,68 @@
+#ifndef GROUP_COMMIT_WRITER_H
+#define GROUP_COMMIT_WRITER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QList>
+#include <atomic>
+#include <functional>
+
+class ConnectionPool;
+
+// 组提交参数
+struct GroupCommitOptions {
+    int windowMs = 2;       // 收到第一个写操作后最多再等待的时间，用于合并并发写入
+    int maxBatch = 64;      // 单个事务最多包含的写操作组数
+};
+
+// 组提交写线程 - 把不同请求在短时间窗口内提交的小写操作合并进同一个事务，
+// 多个请求共用一次提交（一次 fsync）。每组写操作包在独立的 SAVEPOINT 中，失败只回滚本组。
+class GroupCommitWriter : public QThread
+{
+    Q_OBJECT
+
+public:
+    GroupCommitWriter(ConnectionPool *pool, const GroupCommitOptions &options,
+                      QObject *parent = nullptr);
+    ~GroupCommitWriter();
+
+    // 提交一组写操作并阻塞到所在批次提交完成（任意线程）
+    // work 在写线程执行，返回false表示本组失败；返回值为本组是否成功落盘
+    bool execute(const std::function<bool()> &work);
+
+    // 处理完队列中剩余的写操作并结束写线程
+    void stop();
+
+    quint64 batchCount() const { return batches_.load(std::memory_order_relaxed); }
+    quint64 taskCount() const { return tasks_.load(std::memory_order_relaxed); }
+    const GroupCommitOptions &options() const { return options_; }
+
+protected:
+    void run() override;
+
+private:
+    struct Task {
+        std::function<bool()> work;
+        bool done = false;
+        bool success = false;
+    };
+
+    // 在调用线程直接执行（写线程未运行或重入时）
+    bool executeInline(const std::function<bool()> &work);
+    void commitBatch(const QList<Task*> &batch);
+
+    ConnectionPool *pool_;
+    GroupCommitOptions options_;
+
+    QMutex mutex_;
+    QWaitCondition queueCondition_;
+    QWaitCondition doneCondition_;
+    QList<Task*> pending_;
+    bool stopping_;
+
+    std::atomic<quint64> batches_;
+    std::atomic<quint64> tasks_;
+};
+
+#endif // GROUP_COMMIT_WRITER_H
@@ -0,0 +1,100 @@
+#include "unit_of_work.h"
+#include "../logging/db_logger.h"
+#include <QSqlQuery>
+#include <QSqlError>
+
+namespace {
+// 每个线程使用自己的连接，嵌套深度按线程记录
+thread_local int transactionDepth = 0;
+}
+
+UnitOfWork::UnitOfWork(QSqlDatabase &db)
+    : db_(db)
+    , active_(false)
+{
+    if (transactionDepth == 0) {
+        active_ = db_.transaction();
+        if (!active_) {
+            DBLogger::error("开启事务", db_.lastError());
+        }
+    } else {
+        savepoint_ = QString("uow_%1").arg(transactionDepth);
+        active_ = execSavepointCommand("SAVEPOINT " + savepoint_);
+    }
+
+    if (active_) {
+        ++transactionDepth;
+    }
+}
+
+UnitOfWork::~UnitOfWork()
+{
+    if (active_) {
+        rollback();
+    }
+}
+
+bool UnitOfWork::inTransaction()
+{
+    return transactionDepth > 0;
+}
+
+bool UnitOfWork::commit()
+{
+    if (!active_) {
+        return false;
+    }
+
+    bool success;
+    if (savepoint_.isEmpty()) {
+        success = db_.commit();
+        if (!success) {
+            DBLogger::error("提交事务", db_.lastError());
+            db_.rollback();
+        }
+    } else {
+        success = execSavepointCommand("RELEASE " + savepoint_);
+        if (!success) {
+            execSavepointCommand("ROLLBACK TO " + savepoint_);
+            execSavepointCommand("RELEASE " + savepoint_);
+        }
+    }
+
+    finish();
+    return success;
+}
+
+void UnitOfWork::rollback()
+{
+    if (!active_) {
+        return;
+    }
+
+    if (savepoint_.isEmpty()) {
+        if (!db_.rollback()) {
+            DBLogger::error("回滚事务", db_.lastError());
+        }
+    } else {
+        // ROLLBACK TO 不会移除保存点，需再 RELEASE
+        execSavepointCommand("ROLLBACK TO " + savepoint_);
+        execSavepointCommand("RELEASE " + savepoint_);
+    }
+
+    finish();
+}
+
+bool UnitOfWork::execSavepointCommand(const QString &command)
+{
+    QSqlQuery query(db_);
+    if (!query.exec(command)) {
+        DBLogger::error(command, query.lastError());
+        return false;
+    }
+    return true;
+}
+
+void UnitOfWork::finish()
+{
+    active_ = false;
+    --transactionDepth;
+}
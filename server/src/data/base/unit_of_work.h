@@ -0,0 +1,42 @@
+#ifndef UNIT_OF_WORK_H
+#define UNIT_OF_WORK_H
+
+#include <QSqlDatabase>
+#include <QString>
+
+// 工作单元 - 把一组相关的写操作放进同一个事务，只提交（同步落盘）一次
+// 作用域内未调用 commit() 时自动回滚。
+// 同一线程内嵌套使用时，内层以 SAVEPOINT 实现，只回滚自己的修改，由最外层负责提交。
+//
+//   UnitOfWork work(database());
+//   if (!repo->updateStatus(...) || !repo->updateClosedAt(...)) return false;
+//   return work.commit();
+class UnitOfWork
+{
+public:
+    explicit UnitOfWork(QSqlDatabase &db);
+    ~UnitOfWork();
+
+    // 事务是否已成功开启且尚未结束
+    bool isActive() const { return active_; }
+    bool isNested() const { return !savepoint_.isEmpty(); }
+
+    bool commit();
+    void rollback();
+
+    // 调用线程当前是否处于工作单元中
+    static bool inTransaction();
+
+    UnitOfWork(const UnitOfWork&) = delete;
+    UnitOfWork& operator=(const UnitOfWork&) = delete;
+
+private:
+    bool execSavepointCommand(const QString &command);
+    void finish();
+
+    QSqlDatabase db_;
+    QString savepoint_;   // 为空表示最外层事务
+    bool active_;
+};
+
+#endif // UNIT_OF_WORK_H
@@ -1,26 +1,43 @@
 #include "databasemanager.h"
+#include "base/connection_pool.h"
+#include "base/db_executor.h"
+#include "base/group_commit_writer.h"
+#include "base/unit_of_work.h"
 #include "logging/db_logger.h"
 #include "repositories/workorder_repository.h"
 #include "repositories/user_repository.h"
 #include "repositories/session_repository.h"
+#include "repositories/counter_repository.h"
+#include <QStringList>
 
 DatabaseManager::DatabaseManager(QObject *parent) 
     : QObject(parent)
+    , pool_(nullptr)
+    , executor_(nullptr)
+    , executorThreadCount_(2)
+    , groupCommitWriter_(nullptr)
+    , groupCommitWindowMs_(0)
+    , searchMode_(WorkOrderSearchMode::LIKE_SCAN)
     , workOrderRepo_(nullptr)
     , userRepo_(nullptr)
     , sessionRepo_(nullptr)
+    , counterRepo_(nullptr)
+    , countersAvailable_(false)
 {
 }
 
 DatabaseManager::~DatabaseManager()
 {
-    if (db_.isOpen()) {
-        db_.close();
-    }
+    // 先结束执行线程（同时关闭它们的连接），再释放仓储
+    delete executor_;
+    delete groupCommitWriter_;
     
     delete workOrderRepo_;
     delete userRepo_;
     delete sessionRepo_;
+    delete counterRepo_;
+    
+    delete pool_;
 }
 
 bool DatabaseManager::initialize()
@@ -30,21 +47,14 @@ bool DatabaseManager::initialize()
         return false;
     }
 
-    // 初始化数据库连接
-    QString connectionName = "remote_support_connection";
-    if (QSqlDatabase::contains(connectionName)) {
-        db_ = QSqlDatabase::database(connectionName);
-    } else {
-        db_ = QSqlDatabase::addDatabase("QSQLITE", connectionName);
-    }
-
-    QString dbPath = QDir::currentPath() + "/database/remote_support.db";
-    DBLogger::info("数据库初始化", QString("数据库路径: %1").arg(dbPath));
-
-    db_.setDatabaseName(dbPath);
+    // 初始化连接池（每个线程一个连接，WAL模式）
+    ConnectionPoolOptions options;
+    options.databasePath = QDir::currentPath() + "/database/remote_support.db";
+    DBLogger::info("数据库初始化", QString("数据库路径: %1").arg(options.databasePath));
 
-    if (!db_.open()) {
-        DBLogger::error("数据库初始化", db_.lastError());
+    pool_ = new ConnectionPool(options);
+    if (!pool_->initialize()) {
+        DBLogger::error("数据库初始化", "打开数据库连接失败");
         return false;
     }
 
@@ -57,16 +67,40 @@ bool DatabaseManager::initialize()
     workOrderRepo_ = new WorkOrderRepository(this);
     userRepo_ = new UserRepository(this);
     sessionRepo_ = new SessionRepository(this);
+    counterRepo_ = new CounterRepository(this);
     
-    // 设置数据库连接
-    workOrderRepo_->setDatabase(db_);
-    userRepo_->setDatabase(db_);
-    sessionRepo_->setDatabase(db_);
+    // 设置连接池，各仓储按调用线程取连接
+    workOrderRepo_->setConnectionPool(pool_);
+    workOrderRepo_->setSearchMode(searchMode_);
+    userRepo_->setConnectionPool(pool_);
+    sessionRepo_->setConnectionPool(pool_);
+    counterRepo_->setConnectionPool(pool_);
+    counterRepo_->setAvailable(countersAvailable_);
+    
+    executor_ = new DBExecutor(executorThreadCount_);
+    
+    if (groupCommitWindowMs_ > 0) {
+        GroupCommitOptions groupOptions;
+        groupOptions.windowMs = groupCommitWindowMs_;
+        groupCommitWriter_ = new GroupCommitWriter(pool_, groupOptions);
+        groupCommitWriter_->start();
+        DBLogger::info("数据库初始化", QString("已开启组提交，时间窗口 %1 ms").arg(groupCommitWindowMs_));
+    }
 
     DBLogger::info("数据库初始化", "数据库初始化成功！所有Repository已准备就绪。");
     return true;
 }
 
+void DatabaseManager::setExecutorThreadCount(int count)
+{
+    executorThreadCount_ = qMax(1, count);
+}
+
+void DatabaseManager::setGroupCommitWindow(int windowMs)
+{
+    groupCommitWindowMs_ = qMax(0, windowMs);
+}
+
 bool DatabaseManager::ensureDatabaseDirectory()
 {
     QString dbDirPath = QDir::currentPath() + "/database";
@@ -80,14 +114,20 @@ bool DatabaseManager::ensureDatabaseDirectory()
 
 bool DatabaseManager::createTables()
 {
-    return createWorkOrderTables() && 
-           createUserTables() && 
-           createSessionTables();
+    if (!createWorkOrderTables() || 
+        !createUserTables() || 
+        !createSessionTables()) {
+        return false;
+    }
+    
+    // 计数表不可用时统计回退到 COUNT(*) 查询，不影响启动
+    countersAvailable_ = createCounterTables();
+    return true;
 }
 
 bool DatabaseManager::createWorkOrderTables()
 {
-    QSqlQuery query(db_);
+    QSqlQuery query(database());
 
     // 创建工单表
     QString createWorkOrderTable = R"(
@@ -135,13 +175,90 @@ bool DatabaseManager::createWorkOrderTables()
         return false;
     }
 
+    // 工单列表查询的复合索引（id 即 rowid，SQLite 会隐式附加在索引末尾，分页时可直接按索引顺序取数）
+    const QStringList workOrderIndexes = {
+        "CREATE INDEX IF NOT EXISTS idx_work_orders_creator_created ON work_orders(creator_id, created_at)",
+        "CREATE INDEX IF NOT EXISTS idx_work_orders_assignee_created ON work_orders(assigned_to, created_at)",
+        "CREATE INDEX IF NOT EXISTS idx_work_orders_status_created ON work_orders(status, created_at)"
+    };
+    for (const QString& createIndex : workOrderIndexes) {
+        if (!query.exec(createIndex)) {
+            DBLogger::error("创建工单索引", query.lastError());
+            return false;
+        }
+    }
+
+    // 全文索引不可用时工单搜索退化为LIKE扫描，不影响启动
+    searchMode_ = createWorkOrderSearchIndex();
+
     DBLogger::info("创建工单表", "工单表创建成功！");
     return true;
 }
 
+WorkOrderSearchMode DatabaseManager::createWorkOrderSearchIndex()
+{
+    QSqlQuery query(database());
+
+    // 已存在时沿用建表时的分词器
+    query.exec("SELECT sql FROM sqlite_master WHERE type = 'table' AND name = 'work_orders_fts'");
+    bool exists = query.next();
+    QString tableSql = exists ? query.value(0).toString() : QString();
+    query.finish();
+
+    if (!exists) {
+        // trigram 分词器（SQLite 3.34+）支持中文子串匹配，不可用时按词（unicode61）索引
+        const QString createFts = R"(
+            CREATE VIRTUAL TABLE work_orders_fts USING fts5(
+                title, description, category,
+                content = 'work_orders', content_rowid = 'id', tokenize = '%1'
+            )
+        )";
+        if (query.exec(createFts.arg("trigram"))) {
+            tableSql = "trigram";
+        } else if (!query.exec(createFts.arg("unicode61"))) {
+            DBLogger::warning("创建工单全文索引", QString("FTS5不可用，工单搜索使用LIKE: %1").arg(query.lastError().text()));
+            return WorkOrderSearchMode::LIKE_SCAN;
+        }
+    }
+
+    // 外部内容表，由触发器与 work_orders 保持同步
+    const QStringList triggers = {
+        R"(CREATE TRIGGER IF NOT EXISTS work_orders_fts_insert AFTER INSERT ON work_orders BEGIN
+               INSERT INTO work_orders_fts(rowid, title, description, category)
+               VALUES (new.id, new.title, new.description, new.category);
+           END)",
+        R"(CREATE TRIGGER IF NOT EXISTS work_orders_fts_delete AFTER DELETE ON work_orders BEGIN
+               INSERT INTO work_orders_fts(work_orders_fts, rowid, title, description, category)
+               VALUES ('delete', old.id, old.title, old.description, old.category);
+           END)",
+        R"(CREATE TRIGGER IF NOT EXISTS work_orders_fts_update AFTER UPDATE OF title, description, category ON work_orders BEGIN
+               INSERT INTO work_orders_fts(work_orders_fts, rowid, title, description, category)
+               VALUES ('delete', old.id, old.title, old.description, old.category);
+               INSERT INTO work_orders_fts(rowid, title, description, category)
+               VALUES (new.id, new.title, new.description, new.category);
+           END)"
+    };
+    for (const QString& createTrigger : triggers) {
+        if (!query.exec(createTrigger)) {
+            DBLogger::error("创建工单全文索引触发器", query.lastError());
+            return WorkOrderSearchMode::LIKE_SCAN;
+        }
+    }
+
+    // 新建索引时导入已有工单
+    if (!exists && !query.exec("INSERT INTO work_orders_fts(work_orders_fts) VALUES ('rebuild')")) {
+        DBLogger::error("重建工单全文索引", query.lastError());
+        return WorkOrderSearchMode::LIKE_SCAN;
+    }
+
+    const bool trigram = tableSql.contains("trigram");
+    DBLogger::info("创建工单全文索引", QString("工单全文索引就绪，分词器: %1").arg(trigram ? "trigram" : "unicode61"));
+    return trigram ? WorkOrderSearchMode::FTS_TRIGRAM : WorkOrderSearchMode::FTS_WORD;
+}
+
 bool DatabaseManager::createUserTables()
 {
-    QSqlQuery query(db_);
+    QSqlQuery query(database());
 
     // 创建用户表
     QString createUserTable = R"(
@@ -167,7 +284,7 @@ bool DatabaseManager::createUserTables()
 
 bool DatabaseManager::createSessionTables()
 {
-    QSqlQuery query(db_);
+    QSqlQuery query(database());
 
     // 创建会话表（预留实现位置）
     QString createSessionTable = R"(
@@ -189,10 +306,135 @@ bool DatabaseManager::createSessionTables()
         return false;
     }
 
+    // 过期会话按时间范围批量删除
+    const QStringList sessionIndexes = {
+        "CREATE INDEX IF NOT EXISTS idx_sessions_expires_at ON sessions(expires_at)",
+        "CREATE INDEX IF NOT EXISTS idx_sessions_last_activity ON sessions(last_activity)"
+    };
+    for (const QString& createIndex : sessionIndexes) {
+        if (!query.exec(createIndex)) {
+            DBLogger::error("创建会话索引", query.lastError());
+            return false;
+        }
+    }
+
     DBLogger::info("创建会话表", "会话表创建成功！");
     return true;
 }
 
+namespace {
+
+// 一个计数范围：row 中的 %1 替换为 NEW/OLD（建表时为表名）
+struct CounterDefinition {
+    const char* table;
+    QString scope;
+    const char* key;        // 计数键表达式
+    const char* condition;  // 参与计数的行
+    QStringList columns;    // 影响键或条件的列，为空时不需要更新触发器
+};
+
+QString counterAdjust(const CounterDefinition& def, const QString& row, int delta)
+{
+    const QString key = QString("CAST(%1 AS TEXT)").arg(QString(def.key).replace("%1", row));
+    const QString condition = QString(def.condition).replace("%1", row);
+    QString sql;
+    if (delta > 0) {
+        sql += QString("INSERT OR IGNORE INTO entity_counters(scope, key, count) SELECT '%1', %2, 0 WHERE %3;\n")
+               .arg(def.scope, key, condition);
+    }
+    sql += QString("UPDATE entity_counters SET count = count %1 1 WHERE scope = '%2' AND key = %3 AND %4;\n")
+           .arg(delta > 0 ? "+" : "-", def.scope, key, condition);
+    return sql;
+}
+
+} // namespace
+
+bool DatabaseManager::createCounterTables()
+{
+    const QList<CounterDefinition> definitions = {
+        { "work_orders", CounterScope::WORKORDER_ALL, "''", "1", {} },
+        { "work_orders", CounterScope::WORKORDER_STATUS, "%1.status", "%1.status IS NOT NULL", { "status" } },
+        { "work_orders", CounterScope::WORKORDER_CREATOR, "%1.creator_id", "1", { "creator_id" } },
+        { "work_orders", CounterScope::WORKORDER_ASSIGNEE, "%1.assigned_to", "%1.assigned_to IS NOT NULL", { "assigned_to" } },
+        { "users", CounterScope::USER_ALL, "''", "1", {} },
+        { "users", CounterScope::USER_TYPE, "%1.user_type", "1", { "user_type" } },
+        { "sessions", CounterScope::SESSION_ALL, "''", "1", {} },
+        { "sessions", CounterScope::SESSION_STATUS, "%1.status", "%1.status IS NOT NULL", { "status" } },
+        { "sessions", CounterScope::SESSION_USER, "%1.user_id", "1", { "user_id" } },
+        { "sessions", CounterScope::SESSION_ROOM, "%1.room_id", "%1.status = 'active' AND %1.room_id IS NOT NULL", { "status", "room_id" } }
+    };
+
+    QSqlDatabase& db = database();
+    QSqlQuery query(db);
+
+    query.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'entity_counters'");
+    const bool exists = query.next();
+    query.finish();
+
+    // 建表、导入现有数据与建触发器在同一事务中完成，失败时下次启动重新导入
+    if (!db.transaction()) {
+        DBLogger::error("创建计数表", db.lastError());
+        return false;
+    }
+
+    bool ok = true;
+    if (!exists) {
+        ok = query.exec(R"(
+            CREATE TABLE entity_counters(
+                scope TEXT NOT NULL,                       -- 计数范围，如 workorder.status
+                key TEXT NOT NULL,                         -- 范围内的键，如状态或用户ID
+                count INTEGER NOT NULL DEFAULT 0,
+                PRIMARY KEY (scope, key)
+            ) WITHOUT ROWID
+        )");
+        for (int i = 0; ok && i < definitions.size(); ++i) {
+            const CounterDefinition& def = definitions[i];
+            ok = query.exec(QString("INSERT INTO entity_counters(scope, key, count) "
+                                    "SELECT '%1', CAST(%2 AS TEXT), COUNT(*) FROM %3 WHERE %4 GROUP BY 1, 2")
+                            .arg(def.scope,
+                                 QString(def.key).replace("%1", def.table),
+                                 def.table,
+                                 QString(def.condition).replace("%1", def.table)));
+        }
+    }
+
+    // 触发器在写入所在的事务中增减计数，所有写路径（包括批量删除）都不会遗漏
+    for (int i = 0; ok && i < definitions.size(); ++i) {
+        const CounterDefinition& def = definitions[i];
+        const QString name = QString("counter_%1").arg(QString(def.scope).replace('.', '_'));
+
+        ok = query.exec(QString("CREATE TRIGGER IF NOT EXISTS %1_insert AFTER INSERT ON %2 BEGIN\n%3END")
+                        .arg(name, def.table, counterAdjust(def, "NEW", 1)))
+          && query.exec(QString("CREATE TRIGGER IF NOT EXISTS %1_delete AFTER DELETE ON %2 BEGIN\n%3END")
+                        .arg(name, def.table, counterAdjust(def, "OLD", -1)));
+
+        if (ok && !def.columns.isEmpty()) {
+            QStringList changed;
+            for (const QString& column : def.columns) {
+                changed << QString("OLD.%1 IS NOT NEW.%1").arg(column);
+            }
+            ok = query.exec(QString("CREATE TRIGGER IF NOT EXISTS %1_update AFTER UPDATE OF %2 ON %3 WHEN %4 BEGIN\n%5%6END")
+                            .arg(name, def.columns.join(", "), def.table, changed.join(" OR "),
+                                 counterAdjust(def, "OLD", -1), counterAdjust(def, "NEW", 1)));
+        }
+    }
+
+    if (!ok) {
+        DBLogger::warning("创建计数表", QString("计数表不可用，统计使用COUNT查询: %1").arg(query.lastError().text()));
+        db.rollback();
+        return false;
+    }
+
+    if (!db.commit()) {
+        DBLogger::error("创建计数表", db.lastError());
+        db.rollback();
+        return false;
+    }
+
+    DBLogger::info("创建计数表", exists ? "计数表已就绪" : "计数表创建成功，已导入现有数据");
+    return true;
+}
+
 WorkOrderRepository* DatabaseManager::workOrderRepository() const
 {
     return workOrderRepo_;
@@ -208,29 +450,82 @@ SessionRepository* DatabaseManager::sessionRepository() const
     return sessionRepo_;
 }
 
+CounterRepository* DatabaseManager::counterRepository() const
+{
+    return counterRepo_;
+}
+
 bool DatabaseManager::beginTransaction()
 {
-    return db_.transaction();
+    return database().transaction();
 }
 
 bool DatabaseManager::commitTransaction()
 {
-    return db_.commit();
+    return database().commit();
 }
 
 bool DatabaseManager::rollbackTransaction()
 {
-    return db_.rollback();
+    return database().rollback();
+}
+
+bool DatabaseManager::runInTransaction(const std::function<bool()>& work)
+{
+    if (groupCommitWriter_) {
+        return groupCommitWriter_->execute(work);
+    }
+    
+    UnitOfWork unit(database());
+    if (!unit.isActive() || !work()) {
+        return false;
+    }
+    return unit.commit();
+}
+
+void DatabaseManager::logStatistics() const
+{
+    if (!pool_) {
+        return;
+    }
+    
+    const StatementCacheStats stats = pool_->statementCacheStats();
+    const quint64 total = stats.hits + stats.misses;
+    DBLogger::info("数据库统计", QString("连接数: %1, 缓存语句: %2, 语句缓存命中: %3, 未命中: %4, 命中率: %5%")
+                   .arg(pool_->openConnectionCount())
+                   .arg(stats.statements)
+                   .arg(stats.hits)
+                   .arg(stats.misses)
+                   .arg(total > 0 ? 100.0 * stats.hits / total : 0.0, 0, 'f', 1));
+    
+    if (groupCommitWriter_) {
+        const quint64 batches = groupCommitWriter_->batchCount();
+        const quint64 tasks = groupCommitWriter_->taskCount();
+        DBLogger::info("数据库统计", QString("组提交批次: %1, 写操作组: %2, 平均每批: %3")
+                       .arg(batches)
+                       .arg(tasks)
+                       .arg(batches > 0 ? double(tasks) / batches : 0.0, 0, 'f', 1));
+    }
+    
+    if (counterRepo_ && counterRepo_->isAvailable()) {
+        const CounterCacheStats counters = counterRepo_->stats();
+        const quint64 reads = counters.hits + counters.misses;
+        DBLogger::info("数据库统计", QString("计数镜像条目: %1, 命中: %2, 未命中: %3, 命中率: %4%")
+                       .arg(counters.size)
+                       .arg(counters.hits)
+                       .arg(counters.misses)
+                       .arg(reads > 0 ? 100.0 * counters.hits / reads : 0.0, 0, 'f', 1));
+    }
 }
 
 QSqlDatabase& DatabaseManager::database()
 {
-    return db_;
+    return pool_->connection();
 }
 
 bool DatabaseManager::isConnected() const
 {
-    return db_.isOpen();
+    return pool_ && pool_->connection().isOpen();
 }
 
 
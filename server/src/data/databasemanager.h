@@ -4,12 +4,18 @@
 #include <QObject>
 #include <QSqlDatabase>
 #include <QDir>
+#include <functional>
 
 
 // 前向声明
+class ConnectionPool;
+class DBExecutor;
+class GroupCommitWriter;
 class WorkOrderRepository;
 class UserRepository;
 class SessionRepository;
+class CounterRepository;
+enum class WorkOrderSearchMode;
 
 class DatabaseManager : public QObject
 {
@@ -21,31 +27,58 @@ public:
     // 初始化数据库
     bool initialize();
     
+    // 数据库执行线程数（需在initialize之前设置）
+    void setExecutorThreadCount(int count);
+    
+    // 组提交时间窗口（毫秒，需在initialize之前设置），0 表示关闭
+    void setGroupCommitWindow(int windowMs);
+    
+    // 数据库执行器，供网络层把查询移出网络线程
+    DBExecutor* executor() const { return executor_; }
+    
     // 获取各个Repository实例
     WorkOrderRepository* workOrderRepository() const;
     UserRepository* userRepository() const;
     SessionRepository* sessionRepository() const;
+    CounterRepository* counterRepository() const;
     
     // 事务管理
     bool beginTransaction();
     bool commitTransaction();
     bool rollbackTransaction();
     
-    // 数据库连接管理
+    // 工作单元：work 中的写操作在同一事务内提交，work 返回false时整体回滚
+    // 开启组提交时由写线程执行，并与其它请求的写操作合并为一次提交
+    bool runInTransaction(const std::function<bool()>& work);
+    
+    // 数据库连接管理（返回调用线程的连接）
     QSqlDatabase& database();
     bool isConnected() const;
+    ConnectionPool* connectionPool() const { return pool_; }
+    
+    // 记录连接数、预编译语句缓存与计数镜像命中率
+    void logStatistics() const;
     
 private:
-    QSqlDatabase db_;
+    ConnectionPool* pool_;
+    DBExecutor* executor_;
+    int executorThreadCount_;
+    GroupCommitWriter* groupCommitWriter_;
+    int groupCommitWindowMs_;
+    WorkOrderSearchMode searchMode_;
     WorkOrderRepository* workOrderRepo_;
     UserRepository* userRepo_;
     SessionRepository* sessionRepo_;
+    CounterRepository* counterRepo_;
+    bool countersAvailable_;
     
     // 私有方法
     bool createTables();
     bool createWorkOrderTables();
+    WorkOrderSearchMode createWorkOrderSearchIndex();
     bool createUserTables();
     bool createSessionTables();
+    bool createCounterTables();
     bool ensureDatabaseDirectory();
 };
 
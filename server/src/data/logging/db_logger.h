@@ -17,6 +17,12 @@ public:
     static void info(const QString &operation, const QString &message);
     static void debug(const QString &operation, const QString &message);
     
+    // 调试级别是否开启，用于跳过热路径上的消息构造
+    static bool isDebugEnabled()
+    {
+        return LogManager::getInstance()->isEnabled(LogModule::DATABASE, LogLayer::DATA, LogLevel::DEBUG);
+    }
+    
     // 查询相关日志
     static void queryExecution(const QString &operation, const QSqlQuery &query, bool success);
     static void queryExecution(const QString &operation, const QString &sql, bool success, const QString &errorMessage = QString());
@@ -48,4 +54,8 @@ private:
     static QString getDatabaseContext(const QSqlQuery &query);
 };
 
+// 数据层惰性调试日志：级别未开启时不求值消息参数
+#define DB_LOG_DEBUG(operation, message) \
+    LOG_DEBUG(LogModule::DATABASE, LogLayer::DATA, operation, message)
+
 #endif // DB_LOGGER_H
@@ -62,6 +62,26 @@ WorkOrderModel WorkOrderModel::fromJson(const QJsonObject& json)
     return model;
 }
 
+// WorkOrderSummary 实现
+QJsonObject WorkOrderSummary::toJson() const
+{
+    QJsonObject json;
+    json["id"] = id;
+    json["ticket_id"] = ticketId;
+    json["title"] = title;
+    json["creator_id"] = creatorId;
+    json["status"] = status;
+    json["priority"] = priority;
+    json["category"] = category;
+    json["assigned_to"] = assignedTo;
+    json["created_at"] = createdAt.toString(Qt::ISODate);
+    json["updated_at"] = updatedAt.toString(Qt::ISODate);
+    if (closedAt.isValid()) {
+        json["closed_at"] = closedAt.toString(Qt::ISODate);
+    }
+    return json;
+}
+
 // ParticipantModel 实现
 bool ParticipantModel::isValid() const
 {
@@ -4,6 +4,7 @@
 #include <QString>
 #include <QDateTime>
 #include <QJsonObject>
+#include <QList>
 #include <QJsonArray>
 
 struct WorkOrderModel {
@@ -59,4 +60,28 @@ struct ParticipantModel {
     static const QString ROLE_VIEWER;
 };
 
+// 工单摘要 - 列表视图只需要的字段，不含描述（详情另行查询）
+struct WorkOrderSummary {
+    int id = -1;
+    QString ticketId;
+    QString title;
+    int creatorId = -1;
+    QString status;
+    QString priority;
+    QString category;
+    int assignedTo = -1;
+    QDateTime createdAt;
+    QDateTime updatedAt;
+    QDateTime closedAt;
+    
+    QJsonObject toJson() const;
+};
+
+// 工单分页结果（键集分页，按 created_at、id 倒序）
+struct WorkOrderPage {
+    QList<WorkOrderSummary> items;
+    QString nextCursor;     // 下一页游标，没有更多时为空
+    bool hasMore = false;
+};
+
 #endif // WORKORDER_MODEL_H
@@ -0,0 +1,99 @@
+#include "counter_repository.h"
+#include "../logging/db_logger.h"
+#include <QSqlQuery>
+
+CounterRepository::CounterRepository(QObject *parent)
+    : DBBase(parent)
+    , available_(false)
+    , hits_(0)
+    , misses_(0)
+{
+}
+
+CounterRepository::~CounterRepository() {}
+
+int CounterRepository::count(const QString& scope, const QString& key)
+{
+    if (!available_) {
+        return -1;
+    }
+
+    const QString domain = domainOf(scope);
+    quint64 generation = 0;
+    {
+        QMutexLocker locker(&mutex_);
+        auto scopeIt = mirror_.constFind(scope);
+        if (scopeIt != mirror_.constEnd()) {
+            auto it = scopeIt->constFind(key);
+            if (it != scopeIt->constEnd()) {
+                ++hits_;
+                return it.value();
+            }
+        }
+        ++misses_;
+        generation = generations_.value(domain);
+    }
+
+    int value = 0;
+    if (!loadCount(scope, key, value)) {
+        return -1;
+    }
+
+    // 读取期间该域发生过写入则不缓存，下次重新读取
+    QMutexLocker locker(&mutex_);
+    if (generations_.value(domain) == generation) {
+        mirror_[scope].insert(key, value);
+    }
+    return value;
+}
+
+void CounterRepository::invalidate(const QString& domain)
+{
+    QMutexLocker locker(&mutex_);
+    ++generations_[domain];
+    for (auto it = mirror_.begin(); it != mirror_.end();) {
+        if (domainOf(it.key()) == domain) {
+            it = mirror_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+CounterCacheStats CounterRepository::stats() const
+{
+    QMutexLocker locker(&mutex_);
+    CounterCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    for (const QHash<QString, int>& keys : mirror_) {
+        stats.size += keys.size();
+    }
+    return stats;
+}
+
+bool CounterRepository::loadCount(const QString& scope, const QString& key, int& value)
+{
+    if (!checkConnection("Load counter")) {
+        return false;
+    }
+
+    PreparedStatement statement = prepareCached("counter.find", "SELECT count FROM entity_counters WHERE scope = ? AND key = ?");
+    QSqlQuery& query = statement.query();
+    query.addBindValue(scope);
+    query.addBindValue(key);
+
+    if (!query.exec()) {
+        DBLogger::error("Load counter", query.lastError());
+        return false;
+    }
+
+    // 没有行表示从未计数过
+    value = query.next() ? query.value(0).toInt() : 0;
+    return true;
+}
+
+QString CounterRepository::domainOf(const QString& scope)
+{
+    return scope.section('.', 0, 0);
+}
@@ -0,0 +1,71 @@
+#ifndef COUNTER_REPOSITORY_H
+#define COUNTER_REPOSITORY_H
+
+#include "../base/db_base.h"
+#include <QHash>
+#include <QString>
+#include <QMutex>
+
+// 计数范围（entity_counters.scope），由 DatabaseManager 建立的触发器维护
+namespace CounterScope {
+    const QString WORKORDER_ALL = "workorder.all";
+    const QString WORKORDER_STATUS = "workorder.status";
+    const QString WORKORDER_CREATOR = "workorder.creator";
+    const QString WORKORDER_ASSIGNEE = "workorder.assignee";
+    const QString USER_ALL = "user.all";
+    const QString USER_TYPE = "user.type";
+    const QString SESSION_ALL = "session.all";
+    const QString SESSION_STATUS = "session.status";
+    const QString SESSION_USER = "session.user";
+    const QString SESSION_ROOM = "session.room";    // 只统计 active 会话
+}
+
+// 失效粒度：scope 的前缀
+namespace CounterDomain {
+    const QString WORKORDER = "workorder";
+    const QString USER = "user";
+    const QString SESSION = "session";
+}
+
+// 计数镜像统计
+struct CounterCacheStats {
+    quint64 hits = 0;
+    quint64 misses = 0;
+    int size = 0;
+};
+
+// 计数仓储 - 读取触发器维护的计数表，并在内存中保留镜像
+// 写操作提交后由业务层调用 invalidate()；未命中时按主键读取一行，不再扫描业务表
+class CounterRepository : public DBBase
+{
+    Q_OBJECT
+public:
+    explicit CounterRepository(QObject *parent = nullptr);
+    ~CounterRepository();
+
+    // 计数表不可用时（建表失败）count 返回-1，调用方回退到 COUNT(*) 查询
+    void setAvailable(bool available) { available_ = available; }
+    bool isAvailable() const { return available_; }
+
+    // 读取计数，key 为空表示整个范围（如 workorder.all）
+    int count(const QString& scope, const QString& key = QString());
+    int count(const QString& scope, int key) { return count(scope, QString::number(key)); }
+
+    // 丢弃某个域的镜像，须在写事务提交之后调用
+    void invalidate(const QString& domain);
+
+    CounterCacheStats stats() const;
+
+private:
+    bool loadCount(const QString& scope, const QString& key, int& value);
+    static QString domainOf(const QString& scope);
+
+    bool available_;
+    QHash<QString, QHash<QString, int>> mirror_;    // scope -> key -> count
+    QHash<QString, quint64> generations_;           // 每次失效递增，防止旧读数覆盖失效
+    quint64 hits_;
+    quint64 misses_;
+    mutable QMutex mutex_;
+};
+
+#endif // COUNTER_REPOSITORY_H
@@ -6,6 +6,17 @@
 #include <QUuid>
 #include "../logging/db_logger.h"
 
+// 显式列清单，按下标取值（顺序与 SessionColumn 一致）
+#define SESSION_COLUMNS "id, session_id, user_id, room_id, status, created_at, last_activity, expires_at"
+
+namespace {
+
+enum SessionColumn {
+    COL_ID, COL_SESSION_ID, COL_USER_ID, COL_ROOM_ID, COL_STATUS, COL_CREATED_AT, COL_LAST_ACTIVITY, COL_EXPIRES_AT
+};
+
+} // namespace
+
 SessionRepository::SessionRepository(QObject *parent) : DBBase(parent) {}
 
 SessionRepository::~SessionRepository() {}
@@ -17,11 +28,11 @@ bool SessionRepository::create(const SessionModel& session, int& sessionId)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare(R"(
+    PreparedStatement statement = prepareCached("session.create", R"(
         INSERT INTO sessions (session_id, user_id, room_id, status, created_at, last_activity, expires_at)
         VALUES (:session_id, :user_id, :room_id, :status, :created_at, :last_activity, :expires_at)
     )");
+    QSqlQuery& query = statement.query();
 
     query.bindValue(":session_id", session.sessionId);
     query.bindValue(":user_id", session.userId);
@@ -46,8 +57,8 @@ bool SessionRepository::findById(int sessionId, SessionModel& session)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM sessions WHERE id = :id");
+    PreparedStatement statement = prepareCached("session.findById", "SELECT " SESSION_COLUMNS " FROM sessions WHERE id = :id");
+    QSqlQuery& query = statement.query();
     query.bindValue(":id", sessionId);
 
     if (!executeQuery(query, "Find Session By ID")) {
@@ -55,7 +66,7 @@ bool SessionRepository::findById(int sessionId, SessionModel& session)
     }
 
     if (query.next()) {
-        session = mapToModel(query.record());
+        session = mapToModel(query);
         return true;
     }
 
@@ -68,8 +79,8 @@ bool SessionRepository::findBySessionId(const QString& sessionId, SessionModel&
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM sessions WHERE session_id = :session_id");
+    PreparedStatement statement = prepareCached("session.findBySessionId", "SELECT " SESSION_COLUMNS " FROM sessions WHERE session_id = :session_id");
+    QSqlQuery& query = statement.query();
     query.bindValue(":session_id", sessionId);
 
     if (!executeQuery(query, "Find Session By Session ID")) {
@@ -77,7 +88,7 @@ bool SessionRepository::findBySessionId(const QString& sessionId, SessionModel&
     }
 
     if (query.next()) {
-        session = mapToModel(query.record());
+        session = mapToModel(query);
         return true;
     }
 
@@ -90,13 +101,13 @@ bool SessionRepository::update(const SessionModel& session)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare(R"(
+    PreparedStatement statement = prepareCached("session.update", R"(
         UPDATE sessions 
         SET user_id = :user_id, room_id = :room_id, status = :status, 
             last_activity = :last_activity, expires_at = :expires_at
         WHERE id = :id
     )");
+    QSqlQuery& query = statement.query();
 
     query.bindValue(":id", session.id);
     query.bindValue(":user_id", session.userId);
@@ -119,8 +130,8 @@ bool SessionRepository::remove(int sessionId)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("DELETE FROM sessions WHERE id = :id");
+    PreparedStatement statement = prepareCached("session.remove", "DELETE FROM sessions WHERE id = :id");
+    QSqlQuery& query = statement.query();
     query.bindValue(":id", sessionId);
 
     if (!executeQuery(query, "Remove Session")) {
@@ -131,6 +142,29 @@ bool SessionRepository::remove(int sessionId)
     return true;
 }
 
+int SessionRepository::removeExpired(const QDateTime& now, const QDateTime& inactiveBefore)
+{
+    if (!checkConnection("Remove Expired Sessions")) {
+        return -1;
+    }
+
+    PreparedStatement statement = prepareCached("session.removeExpired", R"(
+        DELETE FROM sessions
+        WHERE (expires_at IS NOT NULL AND expires_at < :current_time)
+           OR (last_activity < :inactive_time AND status = :active_status)
+    )");
+    QSqlQuery& query = statement.query();
+    query.bindValue(":current_time", now);
+    query.bindValue(":inactive_time", inactiveBefore);
+    query.bindValue(":active_status", SessionModel::STATUS_ACTIVE);
+
+    if (!executeQuery(query, "Remove Expired Sessions")) {
+        return -1;
+    }
+
+    return query.numRowsAffected();
+}
+
 // 会话管理
 bool SessionRepository::updateLastActivity(int sessionId)
 {
@@ -138,8 +172,8 @@ bool SessionRepository::updateLastActivity(int sessionId)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("UPDATE sessions SET last_activity = :last_activity WHERE id = :id");
+    PreparedStatement statement = prepareCached("session.updateLastActivity", "UPDATE sessions SET last_activity = :last_activity WHERE id = :id");
+    QSqlQuery& query = statement.query();
     query.bindValue(":id", sessionId);
     query.bindValue(":last_activity", QDateTime::currentDateTime());
 
@@ -150,14 +184,53 @@ bool SessionRepository::updateLastActivity(int sessionId)
     return true;
 }
 
+bool SessionRepository::updateLastActivityBatch(const QHash<int, QDateTime>& activities)
+{
+    if (activities.isEmpty()) {
+        return true;
+    }
+
+    if (!checkConnection("Batch Update Session Last Activity")) {
+        return false;
+    }
+
+    // 所有行在同一个事务中更新，只提交一次
+    if (!database().transaction()) {
+        DBLogger::error("Batch Update Session Last Activity", database().lastError());
+        return false;
+    }
+
+    PreparedStatement statement = prepareCached("session.updateLastActivity", "UPDATE sessions SET last_activity = :last_activity WHERE id = :id");
+    QSqlQuery& query = statement.query();
+
+    for (auto it = activities.constBegin(); it != activities.constEnd(); ++it) {
+        query.bindValue(":id", it.key());
+        query.bindValue(":last_activity", it.value());
+        if (!query.exec()) {
+            DBLogger::error("Batch Update Session Last Activity", query.lastError());
+            database().rollback();
+            return false;
+        }
+    }
+
+    if (!database().commit()) {
+        DBLogger::error("Batch Update Session Last Activity", database().lastError());
+        database().rollback();
+        return false;
+    }
+
+    DB_LOG_DEBUG("Session Repository", QString("Batch updated last activity for %1 sessions").arg(activities.size()));
+    return true;
+}
+
 bool SessionRepository::updateStatus(int sessionId, const QString& status)
 {
     if (!checkConnection("Update Session Status")) {
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("UPDATE sessions SET status = :status WHERE id = :id");
+    PreparedStatement statement = prepareCached("session.updateStatus", "UPDATE sessions SET status = :status WHERE id = :id");
+    QSqlQuery& query = statement.query();
     query.bindValue(":id", sessionId);
     query.bindValue(":status", status);
 
@@ -183,8 +256,8 @@ QList<SessionModel> SessionRepository::findByUserId(int userId)
         return sessions;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM sessions WHERE user_id = :user_id ORDER BY last_activity DESC");
+    PreparedStatement statement = prepareCached("session.findByUserId", "SELECT " SESSION_COLUMNS " FROM sessions WHERE user_id = :user_id ORDER BY last_activity DESC");
+    QSqlQuery& query = statement.query();
     query.bindValue(":user_id", userId);
 
     if (!executeQuery(query, "Find Sessions By User ID")) {
@@ -192,7 +265,7 @@ QList<SessionModel> SessionRepository::findByUserId(int userId)
     }
 
     while (query.next()) {
-        sessions.append(mapToModel(query.record()));
+        sessions.append(mapToModel(query));
     }
 
     return sessions;
@@ -206,8 +279,8 @@ QList<SessionModel> SessionRepository::findByRoomId(const QString& roomId)
         return sessions;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM sessions WHERE room_id = :room_id AND status = :status ORDER BY last_activity DESC");
+    PreparedStatement statement = prepareCached("session.findByRoomId", "SELECT " SESSION_COLUMNS " FROM sessions WHERE room_id = :room_id AND status = :status ORDER BY last_activity DESC");
+    QSqlQuery& query = statement.query();
     query.bindValue(":room_id", roomId);
     query.bindValue(":status", SessionModel::STATUS_ACTIVE);
 
@@ -216,7 +289,7 @@ QList<SessionModel> SessionRepository::findByRoomId(const QString& roomId)
     }
 
     while (query.next()) {
-        sessions.append(mapToModel(query.record()));
+        sessions.append(mapToModel(query));
     }
 
     return sessions;
@@ -230,8 +303,8 @@ QList<SessionModel> SessionRepository::findByStatus(const QString& status)
         return sessions;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM sessions WHERE status = :status ORDER BY last_activity DESC");
+    PreparedStatement statement = prepareCached("session.findByStatus", "SELECT " SESSION_COLUMNS " FROM sessions WHERE status = :status ORDER BY last_activity DESC");
+    QSqlQuery& query = statement.query();
     query.bindValue(":status", status);
 
     if (!executeQuery(query, "Find Sessions By Status")) {
@@ -239,7 +312,7 @@ QList<SessionModel> SessionRepository::findByStatus(const QString& status)
     }
 
     while (query.next()) {
-        sessions.append(mapToModel(query.record()));
+        sessions.append(mapToModel(query));
     }
 
     return sessions;
@@ -253,13 +326,13 @@ QList<SessionModel> SessionRepository::findExpiredSessions()
         return sessions;
     }
 
-    QSqlQuery query(database());
-    query.prepare(R"(
-        SELECT * FROM sessions 
+    PreparedStatement statement = prepareCached("session.findExpiredSessions", R"(
+        SELECT )" SESSION_COLUMNS R"( FROM sessions 
         WHERE (expires_at IS NOT NULL AND expires_at < :current_time) 
            OR (last_activity < :inactive_time AND status = :active_status)
         ORDER BY last_activity ASC
     )");
+    QSqlQuery& query = statement.query();
     
     QDateTime currentTime = QDateTime::currentDateTime();
     QDateTime inactiveTime = currentTime.addSecs(-3600); // 1小时无活动视为过期
@@ -273,7 +346,7 @@ QList<SessionModel> SessionRepository::findExpiredSessions()
     }
 
     while (query.next()) {
-        sessions.append(mapToModel(query.record()));
+        sessions.append(mapToModel(query));
     }
 
     return sessions;
@@ -287,7 +360,7 @@ QList<SessionModel> SessionRepository::findAll(int limit, int offset)
         return sessions;
     }
 
-    QString sql = "SELECT * FROM sessions ORDER BY last_activity DESC";
+    QString sql = "SELECT " SESSION_COLUMNS " FROM sessions ORDER BY last_activity DESC";
     if (limit > 0) {
         sql += QString(" LIMIT %1 OFFSET %2").arg(limit).arg(offset);
     }
@@ -300,7 +373,7 @@ QList<SessionModel> SessionRepository::findAll(int limit, int offset)
     }
 
     while (query.next()) {
-        sessions.append(mapToModel(query.record()));
+        sessions.append(mapToModel(query));
     }
 
     return sessions;
@@ -313,8 +386,8 @@ int SessionRepository::countByUserId(int userId)
         return 0;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM sessions WHERE user_id = :user_id");
+    PreparedStatement statement = prepareCached("session.countByUserId", "SELECT COUNT(*) FROM sessions WHERE user_id = :user_id");
+    QSqlQuery& query = statement.query();
     query.bindValue(":user_id", userId);
 
     if (!executeQuery(query, "Count Sessions By User ID")) {
@@ -334,8 +407,8 @@ int SessionRepository::countByRoomId(const QString& roomId)
         return 0;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM sessions WHERE room_id = :room_id AND status = :status");
+    PreparedStatement statement = prepareCached("session.countByRoomId", "SELECT COUNT(*) FROM sessions WHERE room_id = :room_id AND status = :status");
+    QSqlQuery& query = statement.query();
     query.bindValue(":room_id", roomId);
     query.bindValue(":status", SessionModel::STATUS_ACTIVE);
 
@@ -356,8 +429,8 @@ int SessionRepository::countByStatus(const QString& status)
         return 0;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM sessions WHERE status = :status");
+    PreparedStatement statement = prepareCached("session.countByStatus", "SELECT COUNT(*) FROM sessions WHERE status = :status");
+    QSqlQuery& query = statement.query();
     query.bindValue(":status", status);
 
     if (!executeQuery(query, "Count Sessions By Status")) {
@@ -377,8 +450,8 @@ int SessionRepository::countAll()
         return 0;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM sessions");
+    PreparedStatement statement = prepareCached("session.countAll", "SELECT COUNT(*) FROM sessions");
+    QSqlQuery& query = statement.query();
 
     if (!executeQuery(query, "Count All Sessions")) {
         return 0;
@@ -397,8 +470,8 @@ bool SessionRepository::exists(const QString& sessionId)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM sessions WHERE session_id = :session_id");
+    PreparedStatement statement = prepareCached("session.exists", "SELECT COUNT(*) FROM sessions WHERE session_id = :session_id");
+    QSqlQuery& query = statement.query();
     query.bindValue(":session_id", sessionId);
 
     if (!executeQuery(query, "Check Session Exists")) {
@@ -413,19 +486,19 @@ bool SessionRepository::exists(const QString& sessionId)
 }
 
 // 私有辅助方法
-SessionModel SessionRepository::mapToModel(const QSqlRecord& record)
+SessionModel SessionRepository::mapToModel(const QSqlQuery& query)
 {
     SessionModel model;
-    model.id = record.value("id").toInt();
-    model.sessionId = record.value("session_id").toString();
-    model.userId = record.value("user_id").toInt();
-    model.roomId = record.value("room_id").toString();
-    model.status = record.value("status").toString();
-    model.createdAt = record.value("created_at").toDateTime();
-    model.lastActivity = record.value("last_activity").toDateTime();
+    model.id = query.value(COL_ID).toInt();
+    model.sessionId = query.value(COL_SESSION_ID).toString();
+    model.userId = query.value(COL_USER_ID).toInt();
+    model.roomId = query.value(COL_ROOM_ID).toString();
+    model.status = query.value(COL_STATUS).toString();
+    model.createdAt = query.value(COL_CREATED_AT).toDateTime();
+    model.lastActivity = query.value(COL_LAST_ACTIVITY).toDateTime();
     
-    if (!record.value("expires_at").isNull()) {
-        model.expiresAt = record.value("expires_at").toDateTime();
+    if (!query.isNull(COL_EXPIRES_AT)) {
+        model.expiresAt = query.value(COL_EXPIRES_AT).toDateTime();
     }
     
     return model;
@@ -4,6 +4,7 @@
 #include "../base/db_base.h"
 #include "../models/session_model.h"
 #include <QList>
+#include <QHash>
 
 class SessionRepository : public DBBase
 {
@@ -23,6 +24,11 @@ public:
     bool updateLastActivity(int sessionId);
     bool updateStatus(int sessionId, const QString& status);
     bool expireSession(int sessionId);
+    bool updateLastActivityBatch(const QHash<int, QDateTime>& activities);
+    
+    // 一条DELETE删除所有过期会话，条件与 findExpiredSessions 相同（按 expires_at / last_activity 索引），
+    // 返回删除行数，失败返回-1
+    int removeExpired(const QDateTime& now, const QDateTime& inactiveBefore);
     
     // 查询操作（预留实现位置）
     QList<SessionModel> findByUserId(int userId);
@@ -40,7 +46,7 @@ public:
 
 private:
     // 私有辅助方法（预留实现位置）
-    SessionModel mapToModel(const QSqlRecord& record);
+    SessionModel mapToModel(const QSqlQuery& query);  // 按 SESSION_COLUMNS 的列下标取值
     bool executeSessionQuery(QSqlQuery& query, const QString& operation);
 };
 
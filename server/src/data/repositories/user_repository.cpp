@@ -4,6 +4,17 @@
 #include <QSqlRecord>
 #include <QCryptographicHash>
 
+// 显式列清单，按下标取值（顺序与 UserColumn 一致）
+#define USER_COLUMNS "id, username, password_hash, email, phone, user_type, created_at"
+
+namespace {
+
+enum UserColumn {
+    COL_ID, COL_USERNAME, COL_PASSWORD_HASH, COL_EMAIL, COL_PHONE, COL_USER_TYPE, COL_CREATED_AT
+};
+
+} // namespace
+
 UserRepository::UserRepository(QObject *parent) : DBBase(parent) {}
 
 UserRepository::~UserRepository() {}
@@ -15,8 +26,8 @@ bool UserRepository::create(const UserModel& user, int& userId)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("INSERT INTO users (username, password_hash, email, phone, user_type) VALUES (?, ?, ?, ?, ?)");
+    PreparedStatement statement = prepareCached("user.create", "INSERT INTO users (username, password_hash, email, phone, user_type) VALUES (?, ?, ?, ?, ?)");
+    QSqlQuery& query = statement.query();
     query.addBindValue(user.username);
     query.addBindValue(user.passwordHash);
     query.addBindValue(user.email);
@@ -38,8 +49,8 @@ bool UserRepository::findById(int userId, UserModel& user)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM users WHERE id = ?");
+    PreparedStatement statement = prepareCached("user.findById", "SELECT " USER_COLUMNS " FROM users WHERE id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(userId);
 
     if (!executeUserQuery(query, "Find user by ID")) {
@@ -47,7 +58,7 @@ bool UserRepository::findById(int userId, UserModel& user)
     }
 
     if (query.next()) {
-        user = mapToModel(query.record());
+        user = mapToModel(query);
         return true;
     }
 
@@ -60,8 +71,8 @@ bool UserRepository::findByUsername(const QString& username, UserModel& user)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM users WHERE username = ?");
+    PreparedStatement statement = prepareCached("user.findByUsername", "SELECT " USER_COLUMNS " FROM users WHERE username = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(username);
 
     if (!executeUserQuery(query, "Find user by username")) {
@@ -69,7 +80,7 @@ bool UserRepository::findByUsername(const QString& username, UserModel& user)
     }
 
     if (query.next()) {
-        user = mapToModel(query.record());
+        user = mapToModel(query);
         return true;
     }
 
@@ -82,12 +93,12 @@ bool UserRepository::update(const UserModel& user)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare(R"(
+    PreparedStatement statement = prepareCached("user.update", R"(
         UPDATE users 
         SET username = ?, password_hash = ?, email = ?, phone = ?, user_type = ? 
         WHERE id = ?
     )");
+    QSqlQuery& query = statement.query();
     
     query.addBindValue(user.username);
     query.addBindValue(user.passwordHash);
@@ -105,8 +116,8 @@ bool UserRepository::remove(int userId)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("DELETE FROM users WHERE id = ?");
+    PreparedStatement statement = prepareCached("user.remove", "DELETE FROM users WHERE id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(userId);
 
     return executeUserQuery(query, "Remove user");
@@ -119,8 +130,10 @@ bool UserRepository::updateField(int userId, const QString& field, const QVarian
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare(QString("UPDATE users SET %1 = ? WHERE id = ?").arg(field));
+    // 字段名只来自本类的固定调用，每个字段对应一条缓存语句
+    PreparedStatement statement = prepareCached("user.updateField." + field,
+                                                QString("UPDATE users SET %1 = ? WHERE id = ?").arg(field));
+    QSqlQuery& query = statement.query();
     query.addBindValue(value);
     query.addBindValue(userId);
 
@@ -146,8 +159,8 @@ QList<UserModel> UserRepository::findByUserType(int userType)
         return users;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM users WHERE user_type = ? ORDER BY created_at DESC");
+    PreparedStatement statement = prepareCached("user.findByUserType", "SELECT " USER_COLUMNS " FROM users WHERE user_type = ? ORDER BY created_at DESC");
+    QSqlQuery& query = statement.query();
     query.addBindValue(userType);
 
     if (!executeUserQuery(query, "Find users by type")) {
@@ -155,7 +168,7 @@ QList<UserModel> UserRepository::findByUserType(int userType)
     }
 
     while (query.next()) {
-        users.append(mapToModel(query.record()));
+        users.append(mapToModel(query));
     }
 
     return users;
@@ -169,7 +182,7 @@ QList<UserModel> UserRepository::findAll(int limit, int offset)
         return users;
     }
 
-    QString sql = "SELECT * FROM users ORDER BY created_at DESC";
+    QString sql = "SELECT " USER_COLUMNS " FROM users ORDER BY created_at DESC";
     if (limit > 0) {
         sql += QString(" LIMIT %1 OFFSET %2").arg(limit).arg(offset);
     }
@@ -182,7 +195,7 @@ QList<UserModel> UserRepository::findAll(int limit, int offset)
     }
 
     while (query.next()) {
-        users.append(mapToModel(query.record()));
+        users.append(mapToModel(query));
     }
 
     return users;
@@ -195,8 +208,8 @@ int UserRepository::countByUserType(int userType)
         return 0;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM users WHERE user_type = ?");
+    PreparedStatement statement = prepareCached("user.countByUserType", "SELECT COUNT(*) FROM users WHERE user_type = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(userType);
 
     if (!executeUserQuery(query, "Count users by type")) {
@@ -216,8 +229,8 @@ int UserRepository::countAll()
         return 0;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM users");
+    PreparedStatement statement = prepareCached("user.countAll", "SELECT COUNT(*) FROM users");
+    QSqlQuery& query = statement.query();
 
     if (!executeUserQuery(query, "Count all users")) {
         return 0;
@@ -236,8 +249,8 @@ bool UserRepository::exists(const QString& username)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM users WHERE username = ?");
+    PreparedStatement statement = prepareCached("user.exists", "SELECT COUNT(*) FROM users WHERE username = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(username);
 
     if (!executeUserQuery(query, "Check user exists")) {
@@ -258,8 +271,8 @@ int UserRepository::getUserId(const QString& username)
         return -1;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT id FROM users WHERE username = ?");
+    PreparedStatement statement = prepareCached("user.getUserId", "SELECT id FROM users WHERE username = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(username);
 
     if (!executeUserQuery(query, "Get user ID")) {
@@ -281,8 +294,8 @@ int UserRepository::getUserType(const QString& username)
         return -1;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT user_type FROM users WHERE username = ?");
+    PreparedStatement statement = prepareCached("user.getUserType", "SELECT user_type FROM users WHERE username = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(username);
 
     if (!executeUserQuery(query, "Get user type")) {
@@ -304,8 +317,8 @@ QString UserRepository::getUserEmail(const QString& username)
         return QString();
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT email FROM users WHERE username = ?");
+    PreparedStatement statement = prepareCached("user.getUserEmail", "SELECT email FROM users WHERE username = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(username);
 
     if (!executeUserQuery(query, "Get user email")) {
@@ -327,8 +340,8 @@ QString UserRepository::getUserPhone(const QString& username)
         return QString();
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT phone FROM users WHERE username = ?");
+    PreparedStatement statement = prepareCached("user.getUserPhone", "SELECT phone FROM users WHERE username = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(username);
 
     if (!executeUserQuery(query, "Get user phone")) {
@@ -345,16 +358,16 @@ QString UserRepository::getUserPhone(const QString& username)
 }
 
 // =========私有辅助方法=========
-UserModel UserRepository::mapToModel(const QSqlRecord& record)
+UserModel UserRepository::mapToModel(const QSqlQuery& query)
 {
     UserModel model;
-    model.id = record.value("id").toInt();
-    model.username = record.value("username").toString();
-    model.passwordHash = record.value("password_hash").toString();
-    model.email = record.value("email").toString();
-    model.phone = record.value("phone").toString();
-    model.userType = record.value("user_type").toInt();
-    model.createdAt = record.value("created_at").toDateTime();
+    model.id = query.value(COL_ID).toInt();
+    model.username = query.value(COL_USERNAME).toString();
+    model.passwordHash = query.value(COL_PASSWORD_HASH).toString();
+    model.email = query.value(COL_EMAIL).toString();
+    model.phone = query.value(COL_PHONE).toString();
+    model.userType = query.value(COL_USER_TYPE).toInt();
+    model.createdAt = query.value(COL_CREATED_AT).toDateTime();
     return model;
 }
 
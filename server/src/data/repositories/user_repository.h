@@ -46,7 +46,7 @@ public:
 
 private:
     // 私有辅助方法
-    UserModel mapToModel(const QSqlRecord& record);
+    UserModel mapToModel(const QSqlQuery& query);  // 按 USER_COLUMNS 的列下标取值
     bool executeUserQuery(QSqlQuery& query, const QString& operation);
 };
 
@@ -1,10 +1,61 @@
 #include "workorder_repository.h"
+#include "../base/unit_of_work.h"
 #include "../logging/db_logger.h"
 #include <QSqlQuery>
 #include <QSqlRecord>
 #include <QDateTime>
+#include <QRegularExpression>
+
+// 显式列清单，按下标取值：不为每行构造 QSqlRecord，也不按列名查找
+// 摘要列在前，完整工单在末尾追加 description，两者共用 WorkOrderColumn 下标
+#define WORK_ORDER_SUMMARY_COLUMNS \
+    "id, ticket_id, title, creator_id, status, priority, category, assigned_to, created_at, updated_at, closed_at"
+#define WORK_ORDER_COLUMNS WORK_ORDER_SUMMARY_COLUMNS ", description"
+// 与全文索引表连接时限定表名（两表都有 title/description/category）
+#define WORK_ORDER_SUMMARY_COLUMNS_W \
+    "w.id, w.ticket_id, w.title, w.creator_id, w.status, w.priority, w.category, w.assigned_to, w.created_at, w.updated_at, w.closed_at"
+#define PARTICIPANT_COLUMNS \
+    "id, work_order_id, user_id, role, joined_at, left_at, permissions"
+
+namespace {
+
+enum WorkOrderColumn {
+    COL_ID, COL_TICKET_ID, COL_TITLE, COL_CREATOR_ID, COL_STATUS, COL_PRIORITY, COL_CATEGORY,
+    COL_ASSIGNED_TO, COL_CREATED_AT, COL_UPDATED_AT, COL_CLOSED_AT,
+    COL_DESCRIPTION     // 仅 WORK_ORDER_COLUMNS
+};
+
+enum ParticipantColumn {
+    PCOL_ID, PCOL_WORK_ORDER_ID, PCOL_USER_ID, PCOL_ROLE, PCOL_JOINED_AT, PCOL_LEFT_AT, PCOL_PERMISSIONS
+};
+
+// 摘要与完整工单共有的字段
+template <typename Model>
+void mapSummaryColumns(const QSqlQuery& query, Model& model)
+{
+    model.id = query.value(COL_ID).toInt();
+    model.ticketId = query.value(COL_TICKET_ID).toString();
+    model.title = query.value(COL_TITLE).toString();
+    model.creatorId = query.value(COL_CREATOR_ID).toInt();
+    model.status = query.value(COL_STATUS).toString();
+    model.priority = query.value(COL_PRIORITY).toString();
+    model.category = query.value(COL_CATEGORY).toString();
+    model.assignedTo = query.value(COL_ASSIGNED_TO).toInt();
+    model.createdAt = query.value(COL_CREATED_AT).toDateTime();
+    model.updatedAt = query.value(COL_UPDATED_AT).toDateTime();
+    
+    if (!query.isNull(COL_CLOSED_AT)) {
+        model.closedAt = query.value(COL_CLOSED_AT).toDateTime();
+    }
+}
+
+} // namespace
 
-WorkOrderRepository::WorkOrderRepository(QObject *parent) : DBBase(parent) {}
+WorkOrderRepository::WorkOrderRepository(QObject *parent)
+    : DBBase(parent)
+    , searchMode_(WorkOrderSearchMode::LIKE_SCAN)
+{
+}
 
 WorkOrderRepository::~WorkOrderRepository() {}
 
@@ -21,11 +72,11 @@ bool WorkOrderRepository::create(const WorkOrderModel& workOrder, int& workOrder
                    .arg(workOrder.assignedTo)
                    .arg(workOrder.status));
 
-    QSqlQuery query(database());
-    query.prepare(R"(
+    PreparedStatement statement = prepareCached("workorder.create", R"(
         INSERT INTO work_orders (ticket_id, title, description, creator_id, priority, category, status, assigned_to, created_at, updated_at)
         VALUES (?, ?, ?, ?, ?, ?, ?, ?, CURRENT_TIMESTAMP, CURRENT_TIMESTAMP)
     )");
+    QSqlQuery& query = statement.query();
     
     query.addBindValue(workOrder.ticketId);
     query.addBindValue(workOrder.title);
@@ -36,7 +87,7 @@ bool WorkOrderRepository::create(const WorkOrderModel& workOrder, int& workOrder
     query.addBindValue(workOrder.status);
     query.addBindValue(workOrder.assignedTo);
 
-    DBLogger::debug("Create work order", QString("SQL prepared with values - AssignedTo: %1, Status: %2")
+    DB_LOG_DEBUG("Create work order", QString("SQL prepared with values - AssignedTo: %1, Status: %2")
                     .arg(workOrder.assignedTo)
                     .arg(workOrder.status));
 
@@ -61,8 +112,8 @@ bool WorkOrderRepository::findById(int workOrderId, WorkOrderModel& workOrder)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM work_orders WHERE id = ?");
+    PreparedStatement statement = prepareCached("workorder.findById", "SELECT " WORK_ORDER_COLUMNS " FROM work_orders WHERE id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(workOrderId);
 
     if (!executeWorkOrderQuery(query, "Find work order by ID")) {
@@ -70,7 +121,7 @@ bool WorkOrderRepository::findById(int workOrderId, WorkOrderModel& workOrder)
     }
 
     if (query.next()) {
-        workOrder = mapToModel(query.record());
+        workOrder = mapToModel(query);
         return true;
     }
 
@@ -83,8 +134,8 @@ bool WorkOrderRepository::findByTicketId(const QString& ticketId, WorkOrderModel
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM work_orders WHERE ticket_id = ?");
+    PreparedStatement statement = prepareCached("workorder.findByTicketId", "SELECT " WORK_ORDER_COLUMNS " FROM work_orders WHERE ticket_id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(ticketId);
 
     if (!executeWorkOrderQuery(query, "Find work order by ticket ID")) {
@@ -92,7 +143,7 @@ bool WorkOrderRepository::findByTicketId(const QString& ticketId, WorkOrderModel
     }
 
     if (query.next()) {
-        workOrder = mapToModel(query.record());
+        workOrder = mapToModel(query);
         return true;
     }
 
@@ -105,13 +156,13 @@ bool WorkOrderRepository::update(const WorkOrderModel& workOrder)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare(R"(
+    PreparedStatement statement = prepareCached("workorder.update", R"(
         UPDATE work_orders 
         SET title = ?, description = ?, status = ?, priority = ?, category = ?, 
             assigned_to = ?, updated_at = CURRENT_TIMESTAMP
         WHERE id = ?
     )");
+    QSqlQuery& query = statement.query();
     
     query.addBindValue(workOrder.title);
     query.addBindValue(workOrder.description);
@@ -130,9 +181,12 @@ bool WorkOrderRepository::remove(int workOrderId)
         return false;
     }
 
+    // 两条DELETE在同一事务中执行
+    UnitOfWork unit(database());
+
     // 先删除参与者
-    QSqlQuery participantQuery(database());
-    participantQuery.prepare("DELETE FROM work_order_participants WHERE work_order_id = ?");
+    PreparedStatement participantStatement = prepareCached("workorder.removeParticipants", "DELETE FROM work_order_participants WHERE work_order_id = ?");
+    QSqlQuery& participantQuery = participantStatement.query();
     participantQuery.addBindValue(workOrderId);
     
     if (!executeParticipantQuery(participantQuery, "Remove work order participants")) {
@@ -140,94 +194,40 @@ bool WorkOrderRepository::remove(int workOrderId)
     }
 
     // 再删除工单
-    QSqlQuery query(database());
-    query.prepare("DELETE FROM work_orders WHERE id = ?");
+    PreparedStatement statement = prepareCached("workorder.remove", "DELETE FROM work_orders WHERE id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(workOrderId);
 
-    return executeWorkOrderQuery(query, "Remove work order");
+    return executeWorkOrderQuery(query, "Remove work order") && unit.commit();
 }
 
 // =========查询操作=========
 
-QList<WorkOrderModel> WorkOrderRepository::findByStatus(const QString& status)
+QList<WorkOrderSummary> WorkOrderRepository::findByStatus(const QString& status, int limit, int offset)
 {
-    QList<WorkOrderModel> workOrders;
-    
-    if (!checkConnection("Find work orders by status")) {
-        return workOrders;
-    }
-
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM work_orders WHERE status = ? ORDER BY created_at DESC");
-    query.addBindValue(status);
-
-    if (!executeWorkOrderQuery(query, "Find work orders by status")) {
-        return workOrders;
-    }
-
-    while (query.next()) {
-        workOrders.append(mapToModel(query.record()));
-    }
-
-    return workOrders;
+    return findByColumn("status", status, limit, offset, "Find work orders by status");
 }
 
-QList<WorkOrderModel> WorkOrderRepository::findByCreator(int creatorId)
+QList<WorkOrderSummary> WorkOrderRepository::findByCreator(int creatorId, int limit, int offset)
 {
-    QList<WorkOrderModel> workOrders;
-    
-    if (!checkConnection("Find work orders by creator")) {
-        return workOrders;
-    }
-
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM work_orders WHERE creator_id = ? ORDER BY created_at DESC");
-    query.addBindValue(creatorId);
-
-    if (!executeWorkOrderQuery(query, "Find work orders by creator")) {
-        return workOrders;
-    }
-
-    while (query.next()) {
-        workOrders.append(mapToModel(query.record()));
-    }
-
-    return workOrders;
+    return findByColumn("creator_id", creatorId, limit, offset, "Find work orders by creator");
 }
 
-QList<WorkOrderModel> WorkOrderRepository::findByAssignee(int assigneeId)
+QList<WorkOrderSummary> WorkOrderRepository::findByAssignee(int assigneeId, int limit, int offset)
 {
-    QList<WorkOrderModel> workOrders;
-    
-    if (!checkConnection("Find work orders by assignee")) {
-        return workOrders;
-    }
-
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM work_orders WHERE assigned_to = ? ORDER BY created_at DESC");
-    query.addBindValue(assigneeId);
-
-    if (!executeWorkOrderQuery(query, "Find work orders by assignee")) {
-        return workOrders;
-    }
-
-    while (query.next()) {
-        workOrders.append(mapToModel(query.record()));
-    }
-
-    return workOrders;
+    return findByColumn("assigned_to", assigneeId, limit, offset, "Find work orders by assignee");
 }
 
-QList<WorkOrderModel> WorkOrderRepository::findByPriority(const QString& priority)
+QList<WorkOrderSummary> WorkOrderRepository::findByPriority(const QString& priority)
 {
-    QList<WorkOrderModel> workOrders;
+    QList<WorkOrderSummary> workOrders;
     
     if (!checkConnection("Find work orders by priority")) {
         return workOrders;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM work_orders WHERE priority = ? ORDER BY created_at DESC");
+    PreparedStatement statement = prepareCached("workorder.findByPriority", "SELECT " WORK_ORDER_SUMMARY_COLUMNS " FROM work_orders WHERE priority = ? ORDER BY created_at DESC");
+    QSqlQuery& query = statement.query();
     query.addBindValue(priority);
 
     if (!executeWorkOrderQuery(query, "Find work orders by priority")) {
@@ -235,22 +235,22 @@ QList<WorkOrderModel> WorkOrderRepository::findByPriority(const QString& priorit
     }
 
     while (query.next()) {
-        workOrders.append(mapToModel(query.record()));
+        workOrders.append(mapToSummary(query));
     }
 
     return workOrders;
 }
 
-QList<WorkOrderModel> WorkOrderRepository::findByCategory(const QString& category)
+QList<WorkOrderSummary> WorkOrderRepository::findByCategory(const QString& category)
 {
-    QList<WorkOrderModel> workOrders;
+    QList<WorkOrderSummary> workOrders;
     
     if (!checkConnection("Find work orders by category")) {
         return workOrders;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT * FROM work_orders WHERE category = ? ORDER BY created_at DESC");
+    PreparedStatement statement = prepareCached("workorder.findByCategory", "SELECT " WORK_ORDER_SUMMARY_COLUMNS " FROM work_orders WHERE category = ? ORDER BY created_at DESC");
+    QSqlQuery& query = statement.query();
     query.addBindValue(category);
 
     if (!executeWorkOrderQuery(query, "Find work orders by category")) {
@@ -258,21 +258,21 @@ QList<WorkOrderModel> WorkOrderRepository::findByCategory(const QString& categor
     }
 
     while (query.next()) {
-        workOrders.append(mapToModel(query.record()));
+        workOrders.append(mapToSummary(query));
     }
 
     return workOrders;
 }
 
-QList<WorkOrderModel> WorkOrderRepository::findAll(int limit, int offset)
+QList<WorkOrderSummary> WorkOrderRepository::findAll(int limit, int offset)
 {
-    QList<WorkOrderModel> workOrders;
+    QList<WorkOrderSummary> workOrders;
     
     if (!checkConnection("Find all work orders")) {
         return workOrders;
     }
 
-    QString sql = "SELECT * FROM work_orders ORDER BY created_at DESC";
+    QString sql = "SELECT " WORK_ORDER_SUMMARY_COLUMNS " FROM work_orders ORDER BY created_at DESC";
     if (limit > 0) {
         sql += QString(" LIMIT %1 OFFSET %2").arg(limit).arg(offset);
     }
@@ -285,24 +285,49 @@ QList<WorkOrderModel> WorkOrderRepository::findAll(int limit, int offset)
     }
 
     while (query.next()) {
-        workOrders.append(mapToModel(query.record()));
+        workOrders.append(mapToSummary(query));
     }
 
     return workOrders;
 }
 
+WorkOrderPage WorkOrderRepository::findPageByStatus(const QString& status, const QString& cursor, int limit)
+{
+    return findPageByColumn("status", status, cursor, limit, "Find work order page by status");
+}
+
+WorkOrderPage WorkOrderRepository::findPageByCreator(int creatorId, const QString& cursor, int limit)
+{
+    return findPageByColumn("creator_id", creatorId, cursor, limit, "Find work order page by creator");
+}
+
+WorkOrderPage WorkOrderRepository::findPageByAssignee(int assigneeId, const QString& cursor, int limit)
+{
+    return findPageByColumn("assigned_to", assigneeId, cursor, limit, "Find work order page by assignee");
+}
+
+WorkOrderPage WorkOrderRepository::searchByCreator(const QString& text, int creatorId, const QString& cursor, int limit)
+{
+    return searchByColumn("creator_id", creatorId, text, cursor, limit, "Search work orders by creator");
+}
+
+WorkOrderPage WorkOrderRepository::searchByAssignee(const QString& text, int assigneeId, const QString& cursor, int limit)
+{
+    return searchByColumn("assigned_to", assigneeId, text, cursor, limit, "Search work orders by assignee");
+}
+
 bool WorkOrderRepository::addParticipant(int workOrderId, int userId, const QString& role, const QString& permissions)
 {
     if (!checkConnection("Add work order participant")) {
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare(R"(
+    PreparedStatement statement = prepareCached("workorder.addParticipant", R"(
         INSERT OR REPLACE INTO work_order_participants 
         (work_order_id, user_id, role, permissions, joined_at) 
         VALUES (?, ?, ?, ?, CURRENT_TIMESTAMP)
     )");
+    QSqlQuery& query = statement.query();
     
     query.addBindValue(workOrderId);
     query.addBindValue(userId);
@@ -318,12 +343,12 @@ bool WorkOrderRepository::removeParticipant(int workOrderId, int userId)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare(R"(
+    PreparedStatement statement = prepareCached("workorder.removeParticipant", R"(
         UPDATE work_order_participants 
         SET left_at = CURRENT_TIMESTAMP 
         WHERE work_order_id = ? AND user_id = ?
     )");
+    QSqlQuery& query = statement.query();
     
     query.addBindValue(workOrderId);
     query.addBindValue(userId);
@@ -337,12 +362,12 @@ bool WorkOrderRepository::updateParticipantRole(int workOrderId, int userId, con
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare(R"(
+    PreparedStatement statement = prepareCached("workorder.updateParticipantRole", R"(
         UPDATE work_order_participants 
         SET role = ? 
         WHERE work_order_id = ? AND user_id = ?
     )");
+    QSqlQuery& query = statement.query();
     
     query.addBindValue(role);
     query.addBindValue(workOrderId);
@@ -359,12 +384,12 @@ QList<ParticipantModel> WorkOrderRepository::getParticipants(int workOrderId)
         return participants;
     }
 
-    QSqlQuery query(database());
-    query.prepare(R"(
-        SELECT * FROM work_order_participants 
+    PreparedStatement statement = prepareCached("workorder.getParticipants", R"(
+        SELECT )" PARTICIPANT_COLUMNS R"( FROM work_order_participants 
         WHERE work_order_id = ? AND left_at IS NULL 
         ORDER BY joined_at ASC
     )");
+    QSqlQuery& query = statement.query();
     query.addBindValue(workOrderId);
 
     if (!executeParticipantQuery(query, "Get work order participants")) {
@@ -372,7 +397,7 @@ QList<ParticipantModel> WorkOrderRepository::getParticipants(int workOrderId)
     }
 
     while (query.next()) {
-        participants.append(mapToParticipantModel(query.record()));
+        participants.append(mapToParticipantModel(query));
     }
 
     return participants;
@@ -384,11 +409,11 @@ bool WorkOrderRepository::isParticipant(int workOrderId, int userId)
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare(R"(
+    PreparedStatement statement = prepareCached("workorder.isParticipant", R"(
         SELECT COUNT(*) FROM work_order_participants 
         WHERE work_order_id = ? AND user_id = ? AND left_at IS NULL
     )");
+    QSqlQuery& query = statement.query();
     query.addBindValue(workOrderId);
     query.addBindValue(userId);
 
@@ -409,8 +434,10 @@ bool WorkOrderRepository::updateField(int workOrderId, const QString& field, con
         return false;
     }
 
-    QSqlQuery query(database());
-    query.prepare(QString("UPDATE work_orders SET %1 = ?, updated_at = CURRENT_TIMESTAMP WHERE id = ?").arg(field));
+    // 字段名只来自本类的固定调用，每个字段对应一条缓存语句
+    PreparedStatement statement = prepareCached("workorder.updateField." + field,
+                                                QString("UPDATE work_orders SET %1 = ?, updated_at = CURRENT_TIMESTAMP WHERE id = ?").arg(field));
+    QSqlQuery& query = statement.query();
     
     query.addBindValue(value);
     query.addBindValue(workOrderId);
@@ -439,8 +466,8 @@ int WorkOrderRepository::countByStatus(const QString& status)
         return 0;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM work_orders WHERE status = ?");
+    PreparedStatement statement = prepareCached("workorder.countByStatus", "SELECT COUNT(*) FROM work_orders WHERE status = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(status);
 
     if (!executeWorkOrderQuery(query, "Count work orders by status")) {
@@ -460,8 +487,8 @@ int WorkOrderRepository::countByCreator(int creatorId)
         return 0;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM work_orders WHERE creator_id = ?");
+    PreparedStatement statement = prepareCached("workorder.countByCreator", "SELECT COUNT(*) FROM work_orders WHERE creator_id = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(creatorId);
 
     if (!executeWorkOrderQuery(query, "Count work orders by creator")) {
@@ -481,8 +508,8 @@ int WorkOrderRepository::countByAssignee(int assigneeId)
         return 0;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM work_orders WHERE assigned_to = ?");
+    PreparedStatement statement = prepareCached("workorder.countByAssignee", "SELECT COUNT(*) FROM work_orders WHERE assigned_to = ?");
+    QSqlQuery& query = statement.query();
     query.addBindValue(assigneeId);
 
     if (!executeWorkOrderQuery(query, "Count work orders by assignee")) {
@@ -502,8 +529,8 @@ int WorkOrderRepository::countAll()
         return 0;
     }
 
-    QSqlQuery query(database());
-    query.prepare("SELECT COUNT(*) FROM work_orders");
+    PreparedStatement statement = prepareCached("workorder.countAll", "SELECT COUNT(*) FROM work_orders");
+    QSqlQuery& query = statement.query();
 
     if (!executeWorkOrderQuery(query, "Count all work orders")) {
         return 0;
@@ -518,40 +545,33 @@ int WorkOrderRepository::countAll()
 
 
 
-WorkOrderModel WorkOrderRepository::mapToModel(const QSqlRecord& record)
+WorkOrderModel WorkOrderRepository::mapToModel(const QSqlQuery& query)
 {
     WorkOrderModel model;
-    model.id = record.value("id").toInt();
-    model.ticketId = record.value("ticket_id").toString();
-    model.title = record.value("title").toString();
-    model.description = record.value("description").toString();
-    model.creatorId = record.value("creator_id").toInt();
-    model.status = record.value("status").toString();
-    model.priority = record.value("priority").toString();
-    model.category = record.value("category").toString();
-    model.assignedTo = record.value("assigned_to").toInt();
-    model.createdAt = record.value("created_at").toDateTime();
-    model.updatedAt = record.value("updated_at").toDateTime();
-    
-    if (!record.value("closed_at").isNull()) {
-        model.closedAt = record.value("closed_at").toDateTime();
-    }
-    
+    mapSummaryColumns(query, model);
+    model.description = query.value(COL_DESCRIPTION).toString();
     return model;
 }
 
-ParticipantModel WorkOrderRepository::mapToParticipantModel(const QSqlRecord& record)
+WorkOrderSummary WorkOrderRepository::mapToSummary(const QSqlQuery& query)
+{
+    WorkOrderSummary summary;
+    mapSummaryColumns(query, summary);
+    return summary;
+}
+
+ParticipantModel WorkOrderRepository::mapToParticipantModel(const QSqlQuery& query)
 {
     ParticipantModel model;
-    model.id = record.value("id").toInt();
-    model.workOrderId = record.value("work_order_id").toInt();
-    model.userId = record.value("user_id").toInt();
-    model.role = record.value("role").toString();
-    model.joinedAt = record.value("joined_at").toDateTime();
-    model.permissions = record.value("permissions").toString();
+    model.id = query.value(PCOL_ID).toInt();
+    model.workOrderId = query.value(PCOL_WORK_ORDER_ID).toInt();
+    model.userId = query.value(PCOL_USER_ID).toInt();
+    model.role = query.value(PCOL_ROLE).toString();
+    model.joinedAt = query.value(PCOL_JOINED_AT).toDateTime();
+    model.permissions = query.value(PCOL_PERMISSIONS).toString();
     
-    if (!record.value("left_at").isNull()) {
-        model.leftAt = record.value("left_at").toDateTime();
+    if (!query.isNull(PCOL_LEFT_AT)) {
+        model.leftAt = query.value(PCOL_LEFT_AT).toDateTime();
     }
     
     return model;
@@ -566,3 +586,209 @@ bool WorkOrderRepository::executeParticipantQuery(QSqlQuery& query, const QStrin
 {
     return executeQuery(query, operation);
 }
+
+QList<WorkOrderSummary> WorkOrderRepository::findByColumn(const QString& column, const QVariant& value,
+                                                        int limit, int offset, const QString& operation)
+{
+    QList<WorkOrderSummary> workOrders;
+
+    if (!checkConnection(operation)) {
+        return workOrders;
+    }
+
+    // column 只来自本类内部的固定字段名；LIMIT -1 表示不限制
+    PreparedStatement statement = prepareCached("workorder.findBy." + column,
+                                                QString("SELECT " WORK_ORDER_SUMMARY_COLUMNS " FROM work_orders WHERE %1 = ? ORDER BY created_at DESC, id DESC LIMIT ? OFFSET ?").arg(column));
+    QSqlQuery& query = statement.query();
+    query.addBindValue(value);
+    query.addBindValue(limit > 0 ? limit : -1);
+    query.addBindValue(limit > 0 ? qMax(0, offset) : 0);
+
+    if (!executeWorkOrderQuery(query, operation)) {
+        return workOrders;
+    }
+
+    while (query.next()) {
+        workOrders.append(mapToSummary(query));
+    }
+
+    return workOrders;
+}
+
+WorkOrderPage WorkOrderRepository::findPageByColumn(const QString& column, const QVariant& value,
+                                                    const QString& cursor, int limit, const QString& operation)
+{
+    WorkOrderPage page;
+    limit = qMax(1, limit);
+
+    if (!checkConnection(operation)) {
+        return page;
+    }
+
+    QString cursorCreatedAt;
+    int cursorId = 0;
+    const bool hasCursor = !cursor.isEmpty();
+    if (hasCursor && !decodeCursor(cursor, cursorCreatedAt, cursorId)) {
+        DBLogger::warning(operation, QString("Invalid page cursor: %1").arg(cursor));
+        return page;
+    }
+
+    // 沿 (column, created_at, id) 复合索引定位，不随页码增加扫描量；多取一行判断是否还有下一页
+    QString sql = QString("SELECT " WORK_ORDER_SUMMARY_COLUMNS " FROM work_orders WHERE %1 = ?").arg(column);
+    if (hasCursor) {
+        sql += " AND (created_at < ? OR (created_at = ? AND id < ?))";
+    }
+    sql += " ORDER BY created_at DESC, id DESC LIMIT ?";
+
+    PreparedStatement statement = prepareCached(QString("workorder.page.%1.%2").arg(column).arg(hasCursor ? "next" : "first"), sql);
+    QSqlQuery& query = statement.query();
+    query.addBindValue(value);
+    if (hasCursor) {
+        query.addBindValue(cursorCreatedAt);
+        query.addBindValue(cursorCreatedAt);
+        query.addBindValue(cursorId);
+    }
+    query.addBindValue(limit + 1);
+
+    if (!executeWorkOrderQuery(query, operation)) {
+        return page;
+    }
+
+    QString lastCreatedAt;
+    int lastId = 0;
+    while (query.next()) {
+        if (page.items.size() >= limit) {
+            page.hasMore = true;
+            break;
+        }
+        page.items.append(mapToSummary(query));
+        lastCreatedAt = query.value(COL_CREATED_AT).toString();
+        lastId = query.value(COL_ID).toInt();
+    }
+
+    if (page.hasMore) {
+        page.nextCursor = encodeCursor(lastCreatedAt, lastId);
+    }
+
+    return page;
+}
+
+WorkOrderPage WorkOrderRepository::searchByColumn(const QString& column, const QVariant& value, const QString& text,
+                                                  const QString& cursor, int limit, const QString& operation)
+{
+    WorkOrderPage page;
+    limit = qMax(1, limit);
+
+    if (!checkConnection(operation)) {
+        return page;
+    }
+
+    // 按相关度排序的结果无法用键集定位，游标为偏移量
+    int offset = 0;
+    if (!cursor.isEmpty()) {
+        bool ok = false;
+        offset = QString::fromLatin1(QByteArray::fromBase64(cursor.toLatin1(), QByteArray::Base64UrlEncoding)).toInt(&ok);
+        if (!ok || offset < 0) {
+            DBLogger::warning(operation, QString("Invalid search cursor: %1").arg(cursor));
+            return page;
+        }
+    }
+
+    const QString match = buildMatchExpression(text);
+    QString sql;
+    if (!match.isEmpty()) {
+        // bm25 越小越相关；标题权重最高，其次类别、描述
+        sql = QString("SELECT " WORK_ORDER_SUMMARY_COLUMNS_W R"(
+            FROM work_orders_fts
+            JOIN work_orders w ON w.id = work_orders_fts.rowid
+            WHERE work_orders_fts MATCH ? AND w.%1 = ?
+            ORDER BY bm25(work_orders_fts, 10.0, 1.0, 5.0), w.id DESC
+            LIMIT ? OFFSET ?
+        )").arg(column);
+    } else {
+        sql = QString("SELECT " WORK_ORDER_SUMMARY_COLUMNS R"(
+            FROM work_orders
+            WHERE %1 = ? AND (title LIKE ? ESCAPE '\' OR description LIKE ? ESCAPE '\' OR category LIKE ? ESCAPE '\')
+            ORDER BY created_at DESC, id DESC
+            LIMIT ? OFFSET ?
+        )").arg(column);
+    }
+
+    PreparedStatement statement = prepareCached(QString("workorder.search.%1.%2").arg(column).arg(match.isEmpty() ? "like" : "fts"), sql);
+    QSqlQuery& query = statement.query();
+    if (!match.isEmpty()) {
+        query.addBindValue(match);
+        query.addBindValue(value);
+    } else {
+        QString pattern = text.trimmed();
+        pattern.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+        pattern = "%" + pattern + "%";
+        query.addBindValue(value);
+        query.addBindValue(pattern);
+        query.addBindValue(pattern);
+        query.addBindValue(pattern);
+    }
+    query.addBindValue(limit + 1);
+    query.addBindValue(offset);
+
+    if (!executeWorkOrderQuery(query, operation)) {
+        return page;
+    }
+
+    while (query.next()) {
+        if (page.items.size() >= limit) {
+            page.hasMore = true;
+            break;
+        }
+        page.items.append(mapToSummary(query));
+    }
+
+    if (page.hasMore) {
+        const QByteArray next = QByteArray::number(offset + limit);
+        page.nextCursor = QString::fromLatin1(next.toBase64(QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals));
+    }
+
+    return page;
+}
+
+QString WorkOrderRepository::buildMatchExpression(const QString& text) const
+{
+    if (searchMode_ == WorkOrderSearchMode::LIKE_SCAN) {
+        return QString();
+    }
+
+    const QStringList terms = text.split(QRegularExpression("\\s+"), QString::SkipEmptyParts);
+    QStringList quoted;
+    for (QString term : terms) {
+        // trigram 至少需要3个字符才能命中索引，过短的词改用LIKE
+        if (searchMode_ == WorkOrderSearchMode::FTS_TRIGRAM && term.size() < 3) {
+            return QString();
+        }
+        term.replace("\"", "\"\"");
+        quoted.append(searchMode_ == WorkOrderSearchMode::FTS_WORD
+                      ? QString("\"%1\"*").arg(term)
+                      : QString("\"%1\"").arg(term));
+    }
+    return quoted.join(' ');
+}
+
+QString WorkOrderRepository::encodeCursor(const QString& createdAt, int id)
+{
+    const QByteArray raw = QString("%1|%2").arg(createdAt).arg(id).toUtf8();
+    return QString::fromLatin1(raw.toBase64(QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals));
+}
+
+bool WorkOrderRepository::decodeCursor(const QString& cursor, QString& createdAt, int& id)
+{
+    const QString raw = QString::fromUtf8(QByteArray::fromBase64(cursor.toLatin1(),
+                                                                 QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals));
+    const int separator = raw.lastIndexOf('|');
+    if (separator <= 0) {
+        return false;
+    }
+
+    bool ok = false;
+    createdAt = raw.left(separator);
+    id = raw.mid(separator + 1).toInt(&ok);
+    return ok;
+}
@@ -5,6 +5,13 @@
 #include "../models/workorder_model.h"
 #include <QList>
 
+// 工单全文检索方式（取决于SQLite是否支持FTS5及trigram分词器）
+enum class WorkOrderSearchMode {
+    LIKE_SCAN,      // 不支持FTS5，逐行LIKE匹配
+    FTS_WORD,       // FTS5 unicode61 分词，按词前缀匹配
+    FTS_TRIGRAM     // FTS5 trigram 分词，支持任意子串（中文）匹配
+};
+
 class WorkOrderRepository : public DBBase
 {
     Q_OBJECT
@@ -19,13 +26,23 @@ public:
     bool update(const WorkOrderModel& workOrder);
     bool remove(int workOrderId);
     
-    // 查询操作
-    QList<WorkOrderModel> findByStatus(const QString& status);
-    QList<WorkOrderModel> findByCreator(int creatorId);
-    QList<WorkOrderModel> findByAssignee(int assigneeId);
-    QList<WorkOrderModel> findByPriority(const QString& priority);
-    QList<WorkOrderModel> findByCategory(const QString& category);
-    QList<WorkOrderModel> findAll(int limit = -1, int offset = 0);
+    // 查询操作（列表只返回摘要，不读取描述）
+    QList<WorkOrderSummary> findByStatus(const QString& status, int limit = -1, int offset = 0);
+    QList<WorkOrderSummary> findByCreator(int creatorId, int limit = -1, int offset = 0);
+    QList<WorkOrderSummary> findByAssignee(int assigneeId, int limit = -1, int offset = 0);
+    QList<WorkOrderSummary> findByPriority(const QString& priority);
+    QList<WorkOrderSummary> findByCategory(const QString& category);
+    QList<WorkOrderSummary> findAll(int limit = -1, int offset = 0);
+    
+    // 键集分页查询：cursor 为上一页返回的 nextCursor，首页传空
+    WorkOrderPage findPageByStatus(const QString& status, const QString& cursor, int limit);
+    WorkOrderPage findPageByCreator(int creatorId, const QString& cursor, int limit);
+    WorkOrderPage findPageByAssignee(int assigneeId, const QString& cursor, int limit);
+    
+    // 全文搜索（标题/描述/类别），结果按相关度排序；cursor 为上一页返回的 nextCursor
+    void setSearchMode(WorkOrderSearchMode mode) { searchMode_ = mode; }
+    WorkOrderPage searchByCreator(const QString& text, int creatorId, const QString& cursor, int limit);
+    WorkOrderPage searchByAssignee(const QString& text, int assigneeId, const QString& cursor, int limit);
     
     // 数据字段更新操作
     bool updateField(int workOrderId, const QString& field, const QVariant& value);
@@ -48,10 +65,27 @@ public:
 
 private:
     // 私有辅助方法
-    WorkOrderModel mapToModel(const QSqlRecord& record);
-    ParticipantModel mapToParticipantModel(const QSqlRecord& record);
+    // 按列下标取值，query 须使用本类中对应的列清单
+    WorkOrderModel mapToModel(const QSqlQuery& query);
+    WorkOrderSummary mapToSummary(const QSqlQuery& query);
+    ParticipantModel mapToParticipantModel(const QSqlQuery& query);
     bool executeWorkOrderQuery(QSqlQuery& query, const QString& operation);
     bool executeParticipantQuery(QSqlQuery& query, const QString& operation);
+    QList<WorkOrderSummary> findByColumn(const QString& column, const QVariant& value,
+                                         int limit, int offset, const QString& operation);
+    WorkOrderPage findPageByColumn(const QString& column, const QVariant& value,
+                                   const QString& cursor, int limit, const QString& operation);
+    WorkOrderPage searchByColumn(const QString& column, const QVariant& value, const QString& text,
+                                 const QString& cursor, int limit, const QString& operation);
+    
+    // 把用户输入转换为FTS5查询表达式（每个词加引号，按AND组合），无法使用全文索引时返回空
+    QString buildMatchExpression(const QString& text) const;
+    
+    // 游标为 "created_at|id" 的 base64，created_at 保持数据库原始文本以保证比较一致
+    static QString encodeCursor(const QString& createdAt, int id);
+    static bool decodeCursor(const QString& cursor, QString& createdAt, int& id);
+    
+    WorkOrderSearchMode searchMode_;
 };
 
 #endif // WORKORDER_REPOSITORY_H
@@ -6,9 +6,11 @@
 #include <QStandardPaths>
 #include <QDebug>
 #include <QTimer>
+#include <QThread>
 
 // 数据层
 #include "data/databasemanager.h"
+#include "data/base/db_executor.h"
 
 // 业务逻辑层
 #include "business/services/user_service.h"
@@ -64,6 +66,41 @@ int main(int argc, char *argv[])
                                     "path", "logs/server.log");
     parser.addOption(logFileOption);
     
+    QCommandLineOption sessionFlushOption(QStringList() << "s" << "session-flush",
+                                         "会话活动写回数据库的间隔秒数 (默认: 5)",
+                                         "seconds", "5");
+    parser.addOption(sessionFlushOption);
+    
+    QCommandLineOption ioThreadsOption(QStringList() << "t" << "io-threads",
+                                      "I/O线程数，0表示在主线程处理所有连接 (默认: CPU核心数)",
+                                      "count", QString::number(QThread::idealThreadCount()));
+    parser.addOption(ioThreadsOption);
+    
+    QCommandLineOption ioBalanceOption(QStringList() << "b" << "io-balance",
+                                      "新连接分配策略 (least, round-robin) (默认: least)",
+                                      "policy", "least");
+    parser.addOption(ioBalanceOption);
+    
+    QCommandLineOption sendBudgetOption(QStringList() << "q" << "send-budget",
+                                       "每个客户端允许积压的发送数据量KB，超出时丢弃过期视频帧 (默认: 4096)",
+                                       "kb", "4096");
+    parser.addOption(sendBudgetOption);
+    
+    QCommandLineOption asyncLogOption(QStringList() << "a" << "async-log",
+                                     "异步日志队列满时的策略: drop | block | off (默认: drop)",
+                                     "policy", "drop");
+    parser.addOption(asyncLogOption);
+    
+    QCommandLineOption dbThreadsOption(QStringList() << "w" << "db-threads",
+                                      "数据库执行线程数，登录/工单查询在这些线程中执行 (默认: 2)",
+                                      "count", "2");
+    parser.addOption(dbThreadsOption);
+    
+    QCommandLineOption groupCommitOption(QStringList() << "g" << "group-commit",
+                                        "组提交时间窗口毫秒数，合并并发写操作为一次提交，0表示关闭 (默认: 0)",
+                                        "ms", "0");
+    parser.addOption(groupCommitOption);
+    
     parser.process(app);
     
     // 获取参数值
@@ -72,6 +109,13 @@ int main(int argc, char *argv[])
     QString dbPath = parser.value(dbPathOption);
     QString logLevelStr = parser.value(logLevelOption);
     QString logFilePath = parser.value(logFileOption);
+    int sessionFlushSeconds = parser.value(sessionFlushOption).toInt();
+    int ioThreadCount = parser.value(ioThreadsOption).toInt();
+    QString ioBalanceStr = parser.value(ioBalanceOption);
+    qint64 sendBudgetKb = parser.value(sendBudgetOption).toLongLong();
+    QString asyncLogStr = parser.value(asyncLogOption).toLower();
+    int dbThreadCount = parser.value(dbThreadsOption).toInt();
+    int groupCommitMs = parser.value(groupCommitOption).toInt();
     
     // 解析日志级别
     LogLevel logLevel = LogLevel::INFO;
@@ -102,6 +146,13 @@ int main(int argc, char *argv[])
     // 初始化日志系统
     LogManager* logManager = LogManager::getInstance();
     logManager->initialize(logLevel, logFilePath);
+    if (asyncLogStr != "off") {
+        AsyncLogOptions asyncOptions;
+        asyncOptions.overflowPolicy = asyncLogStr == "block"
+                                    ? LogOverflowPolicy::BLOCK
+                                    : LogOverflowPolicy::DROP;
+        logManager->enableAsync(asyncOptions);
+    }
     
     qInfo() << "=== RemoteExpert 服务器启动 ===";
     qInfo() << "版本:" << app.applicationVersion();
@@ -109,9 +160,13 @@ int main(int argc, char *argv[])
     qInfo() << "数据库路径:" << dbPath;
     qInfo() << "日志级别:" << logLevelStr;
     qInfo() << "日志文件:" << logFilePath;
+    qInfo() << "I/O线程数:" << ioThreadCount;
+    qInfo() << "数据库线程数:" << dbThreadCount;
     
     // 创建数据库管理器
     DatabaseManager* dbManager = new DatabaseManager(&app);
+    dbManager->setExecutorThreadCount(dbThreadCount);
+    dbManager->setGroupCommitWindow(groupCommitMs);
     if (!dbManager->initialize()) {
         qCritical() << "数据库初始化失败";
         return 1;
@@ -121,10 +176,21 @@ int main(int argc, char *argv[])
     // 创建业务服务
     UserService* userService = new UserService(dbManager, &app);
     WorkOrderService* workOrderService = new WorkOrderService(dbManager, userService, &app);
+    if (sessionFlushSeconds > 0) {
+        userService->getSessionService()->setActivityFlushInterval(sessionFlushSeconds);
+    }
     qInfo() << "业务服务初始化成功";
     
     // 创建网络服务器
     NetworkServer* networkServer = new NetworkServer(&app);
+    networkServer->setIOThreadCount(ioThreadCount);
+    networkServer->setIOBalancePolicy(ioBalanceStr.toLower() == "round-robin"
+                                      ? IOWorkerPool::ROUND_ROBIN
+                                      : IOWorkerPool::LEAST_LOADED);
+    if (sendBudgetKb > 0) {
+        networkServer->setSendBudget(sendBudgetKb * 1024);
+    }
+    networkServer->setDBExecutor(dbManager->executor());
     if (!networkServer->initialize(userService, workOrderService)) {
         qCritical() << "网络服务器初始化失败";
         return 1;
@@ -142,6 +208,9 @@ int main(int argc, char *argv[])
     QObject::connect(&app, &QCoreApplication::aboutToQuit, [=]() {
         qInfo() << "正在关闭服务器...";
         networkServer->stop();
+        dbManager->executor()->shutdown();
+        dbManager->logStatistics();
+        userService->logStatistics();
         logManager->cleanup();
         qInfo() << "服务器已关闭";
     });
@@ -3,12 +3,20 @@
 #include "logging/network_logger.h"
 #include "../../../common/protocol/protocol.h"
 #include "../business/services/session_service.h"
+#include "server/io_worker.h"
 #include <QDateTime>
+#include <QThread>
+
+// socket内部缓冲超过该值时暂停写入，剩余数据留在可丢帧的出站队列中
+static const qint64 kSocketWriteWatermark = 256 * 1024;
 
 ConnectionManager::ConnectionManager(QObject *parent)
     : QObject(parent)
     , messageRouter_(nullptr)
     , sessionService_(nullptr)
+    , mutex_(QMutex::Recursive)
+    , sendBudgetBytes_(4 * 1024 * 1024)
+    , nextConnectionId_(0)
 {
 }
 
@@ -17,21 +25,28 @@ ConnectionManager::~ConnectionManager()
     disconnectAll();
 }
 
-void ConnectionManager::addConnection(QTcpSocket* socket)
+void ConnectionManager::addConnection(QTcpSocket* socket, IOWorker* worker)
 {
     if (!socket) return;
     
-    QMutexLocker locker(&mutex_);
-    
-    auto* context = new ClientContext(socket);
-    connections_[socket] = context;
-    buffers_[socket] = QByteArray();
-    
-    setupSocketConnections(socket);
-    
+    // socket尚未交给I/O线程，在这里取一次对端地址，之后其他线程只读peerInfo
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
+    
+    {
+        QMutexLocker locker(&mutex_);
+        
+        ClientContextRef context(new ClientContext(socket));
+        context->connectionId = ++nextConnectionId_;
+        context->peerInfo = clientInfo;
+        context->worker = worker;
+        connections_[socket] = context;
+        
+        // 事件在socket所属线程中处理
+        setupSocketConnections(socket, worker ? static_cast<QObject*>(worker) : this);
+    }
+    
     NetworkLogger::connectionEstablished(clientInfo);
 }
 
@@ -39,28 +54,27 @@ void ConnectionManager::removeConnection(QTcpSocket* socket)
 {
     if (!socket) return;
     
-    QMutexLocker locker(&mutex_);
+    // 连接可能已被disconnectAll清理（此时socket已由I/O线程释放）
+    if (!cleanupConnection(socket)) return;
     
-    cleanupConnection(socket);
-    socket->deleteLater();
+    socket->deleteLater();  // 在socket所属线程中释放
 }
 
 void ConnectionManager::disconnectAll()
 {
     QMutexLocker locker(&mutex_);
     
+    // I/O线程中的socket由线程池关闭时释放，这里只处理主线程中的socket
     for (auto it = connections_.begin(); it != connections_.end(); ++it) {
         QTcpSocket* socket = it.key();
-        if (socket) {
+        if (socket && !it.value()->worker) {
             socket->disconnectFromHost();
         }
     }
     
-    // 清理所有连接
-    qDeleteAll(connections_);
+    // 清理所有连接（I/O线程仍在使用的上下文在其用完后释放）
     connections_.clear();
     userSockets_.clear();
-    buffers_.clear();
     rooms_.clear();
     
     NetworkLogger::info("Connection Manager", "All connections disconnected");
@@ -68,12 +82,52 @@ void ConnectionManager::disconnectAll()
 
 QTcpSocket* ConnectionManager::getSocket(const QString& username)
 {
+    QMutexLocker locker(&mutex_);
     return userSockets_.value(username, nullptr);
 }
 
 ClientContext* ConnectionManager::getContext(QTcpSocket* socket)
 {
-    return connections_.value(socket, nullptr);
+    QMutexLocker locker(&mutex_);
+    return connections_.value(socket).data();
+}
+
+ClientContextRef ConnectionManager::getContextRef(QTcpSocket* socket) const
+{
+    QMutexLocker locker(&mutex_);
+    return connections_.value(socket);
+}
+
+quint64 ConnectionManager::getConnectionId(QTcpSocket* socket) const
+{
+    QMutexLocker locker(&mutex_);
+    ClientContext* context = connections_.value(socket).data();
+    return context ? context->connectionId : 0;
+}
+
+ClientSnapshot ConnectionManager::getClientSnapshot(QTcpSocket* socket) const
+{
+    ClientSnapshot snapshot;
+    QMutexLocker locker(&mutex_);
+    ClientContext* context = connections_.value(socket).data();
+    if (context) {
+        snapshot.found = true;
+        snapshot.isAuthenticated = context->isAuthenticated;
+        snapshot.currentRoom = context->currentRoom;
+        snapshot.peerInfo = context->peerInfo;
+    }
+    return snapshot;
+}
+
+void ConnectionManager::setAuthentication(QTcpSocket* socket, const QString& username, int userId, bool authenticated)
+{
+    QMutexLocker locker(&mutex_);
+    ClientContext* context = connections_.value(socket).data();
+    if (!context) return;
+    
+    context->isAuthenticated = authenticated;
+    context->username = authenticated ? username : QString();
+    context->userId = authenticated ? userId : -1;
 }
 
 ClientContext* ConnectionManager::getContext(const QString& username)
@@ -82,10 +136,28 @@ ClientContext* ConnectionManager::getContext(const QString& username)
     return socket ? getContext(socket) : nullptr;
 }
 
+void ConnectionManager::setProtocolVersion(QTcpSocket* socket, int version)
+{
+    QMutexLocker locker(&mutex_);
+    ClientContext* context = connections_.value(socket).data();
+    if (context) {
+        context->protocolVersion = version;
+    }
+}
+
+int ConnectionManager::getProtocolVersion(QTcpSocket* socket) const
+{
+    QMutexLocker locker(&mutex_);
+    ClientContext* context = connections_.value(socket).data();
+    return context ? context->protocolVersion : ProtocolConstants::PROTOCOL_VERSION_LEGACY;
+}
+
 void ConnectionManager::joinRoom(QTcpSocket* socket, const QString& roomId)
 {
     if (!socket || roomId.isEmpty()) return;
     
+    QMutexLocker locker(&mutex_);
+    
     ClientContext* context = getContext(socket);
     if (!context) return;
     
@@ -103,6 +175,8 @@ void ConnectionManager::leaveRoom(QTcpSocket* socket)
 {
     if (!socket) return;
     
+    QMutexLocker locker(&mutex_);
+    
     ClientContext* context = getContext(socket);
     if (!context || context->currentRoom.isEmpty()) return;
     
@@ -121,6 +195,7 @@ void ConnectionManager::leaveRoom(QTcpSocket* socket)
 QString ConnectionManager::getCurrentRoom(QTcpSocket* socket)
 {
     if(!socket)return QString();
+    QMutexLocker locker(&mutex_);
     ClientContext* context = getContext(socket);
     if(!context)return QString();
     return context->currentRoom;
@@ -128,37 +203,101 @@ QString ConnectionManager::getCurrentRoom(QTcpSocket* socket)
 
 QList<QTcpSocket*> ConnectionManager::getRoomMembers(const QString& roomId)
 {
+    QMutexLocker locker(&mutex_);
     return rooms_.value(roomId, QList<QTcpSocket*>());
 }
 
 void ConnectionManager::broadcastToRoom(const QString& roomId, const QByteArray& data, QTcpSocket* except)
 {
     QList<QTcpSocket*> members = getRoomMembers(roomId);
+    const quint64 originId = except ? getConnectionId(except) : 0;
     
     for (QTcpSocket* socket : members) {
         if (socket != except) {
-            sendToClient(socket, data);
+            sendToClient(socket, data, originId);
         }
     }
     
     NetworkLogger::roomBroadcast(roomId, members.size(), data.size());
 }
 
-void ConnectionManager::sendToClient(QTcpSocket* socket, const QByteArray& data)
+void ConnectionManager::sendToClient(QTcpSocket* socket, const QByteArray& data, quint64 originId)
 {
     if (!socket || data.isEmpty()) return;
     
-    qint64 bytesWritten = socket->write(data);
-    if (bytesWritten != data.size()) {
-        QString clientInfo = QString("%1:%2")
-                            .arg(socket->peerAddress().toString())
-                            .arg(socket->peerPort());
+    IOWorker* worker = nullptr;
+    quint64 connectionId = 0;
+    {
+        QMutexLocker locker(&mutex_);
+        ClientContext* context = connections_.value(socket).data();
+        if (!context) return;
+        worker = context->worker;
+        connectionId = context->connectionId;
+    }
+    
+    // 交给socket所属的I/O线程写出（跨线程时经无锁邮箱转交）
+    if (worker) {
+        worker->send(socket, connectionId, data, originId);
+    } else {
+        writeToSocket(socket, connectionId, data, originId);
+    }
+}
+
+void ConnectionManager::writeToSocket(QTcpSocket* socket, quint64 connectionId, const QByteArray& data, quint64 originId)
+{
+    if (!socket || data.isEmpty()) return;
+    
+    // 持有引用：写出期间主线程可能清理该连接
+    ClientContextRef context = getContextRef(socket);
+    if (!context || context->connectionId != connectionId) return;
+    
+    // 慢速客户端积压超出预算时丢弃过期视频帧，避免无限占用内存
+    int dropped = context->sendQueue.enqueue(data, socket->bytesToWrite(), sendBudgetBytes_, originId);
+    if (dropped > 0) {
+        SendQueueStats stats = context->sendQueue.stats();
         NetworkLogger::warning("Connection Manager", 
-                              QString("Failed to send complete data: %1/%2 bytes")
-                              .arg(bytesWritten).arg(data.size()));
+                              QString("Client %1 is lagging, dropped %2 video frames (total %3, %4 bytes)")
+                              .arg(context->username.isEmpty() ? socket->peerAddress().toString() : context->username)
+                              .arg(dropped)
+                              .arg(stats.droppedVideoFrames)
+                              .arg(stats.droppedBytes));
+    }
+    
+    flushSendQueue(socket, context.data());
+}
+
+void ConnectionManager::flushSendQueue(QTcpSocket* socket, ClientContext* context)
+{
+    SendQueue& queue = context->sendQueue;
+    while (!queue.isEmpty() && socket->bytesToWrite() < kSocketWriteWatermark) {
+        const QByteArray& data = queue.front();
+        qint64 bytesWritten = socket->write(data);
+        if (bytesWritten != data.size()) {
+            NetworkLogger::warning("Connection Manager", 
+                                  QString("Failed to send complete data: %1/%2 bytes")
+                                  .arg(bytesWritten).arg(data.size()));
+        }
+        queue.popFront();
     }
 }
 
+void ConnectionManager::setSendBudget(qint64 bytes)
+{
+    sendBudgetBytes_ = bytes;
+}
+
+qint64 ConnectionManager::getSendBudget() const
+{
+    return sendBudgetBytes_;
+}
+
+SendQueueStats ConnectionManager::getSendQueueStats(QTcpSocket* socket) const
+{
+    QMutexLocker locker(&mutex_);
+    ClientContext* context = connections_.value(socket).data();
+    return context ? context->sendQueue.stats() : SendQueueStats();
+}
+
 void ConnectionManager::sendToClient(const QString& username, const QByteArray& data)
 {
     QTcpSocket* socket = getSocket(username);
@@ -170,6 +309,7 @@ void ConnectionManager::sendToClient(const QString& username, const QByteArray&
 void ConnectionManager::addUserSocket(const QString& username, QTcpSocket* socket)
 {
     if (!username.isEmpty() && socket) {
+        QMutexLocker locker(&mutex_);
         userSockets_[username] = socket;
     }
 }
@@ -177,17 +317,20 @@ void ConnectionManager::addUserSocket(const QString& username, QTcpSocket* socke
 void ConnectionManager::removeUserSocket(const QString& username)
 {
     if (!username.isEmpty()) {
+        QMutexLocker locker(&mutex_);
         userSockets_.remove(username);
     }
 }
 
 int ConnectionManager::getConnectionCount() const
 {
+    QMutexLocker locker(&mutex_);
     return connections_.size();
 }
 
 int ConnectionManager::getRoomMemberCount(const QString& roomId) const
 {
+    QMutexLocker locker(&mutex_);
     return rooms_.value(roomId).size();
 }
 
@@ -196,24 +339,39 @@ void ConnectionManager::setMessageRouter(MessageRouter* router)
     messageRouter_ = router;
 }
 
-void ConnectionManager::setupSocketConnections(QTcpSocket* socket)
+void ConnectionManager::setupSocketConnections(QTcpSocket* socket, QObject* receiver)
 {
-    connect(socket, &QTcpSocket::readyRead, this, &ConnectionManager::onReadyRead);
-    connect(socket, &QTcpSocket::disconnected, this, &ConnectionManager::onDisconnected);
+    // receiver与socket同属一个线程，处理函数直接在该线程中执行
+    connect(socket, &QTcpSocket::readyRead, receiver, [this, socket]() {
+        handleReadyRead(socket);
+    });
+    connect(socket, &QTcpSocket::disconnected, receiver, [this, socket]() {
+        handleDisconnected(socket);
+    });
     connect(socket, QOverload<QAbstractSocket::SocketError>::of(&QTcpSocket::error),
-            this, &ConnectionManager::onError);
+            receiver, [this, socket](QAbstractSocket::SocketError) {
+        handleError(socket);
+    });
+    connect(socket, &QTcpSocket::bytesWritten, receiver, [this, socket](qint64) {
+        handleBytesWritten(socket);
+    });
 }
 
-void ConnectionManager::cleanupConnection(QTcpSocket* socket)
+bool ConnectionManager::cleanupConnection(QTcpSocket* socket)
 {
-    if (!socket) return;
+    if (!socket) return false;
     
-    ClientContext* context = getContext(socket);
-    if (context) {
-        // 过期会话
-        if (!context->sessionId.isEmpty()) {
-            expireSession(socket);
-        }
+    // 锁内只摘除连接表中的登记；会话过期写数据库和日志在锁外进行，不阻塞I/O线程
+    ClientContextRef context;
+    QString sessionId;
+    {
+        QMutexLocker locker(&mutex_);
+        
+        context = connections_.value(socket);
+        if (!context) return false;
+        
+        sessionId = context->sessionId;
+        context->sessionId.clear();
         
         // 离开房间
         leaveRoom(socket);
@@ -223,54 +381,62 @@ void ConnectionManager::cleanupConnection(QTcpSocket* socket)
             userSockets_.remove(context->username);
         }
         
-        QString clientInfo = QString("%1:%2")
-                            .arg(socket->peerAddress().toString())
-                            .arg(socket->peerPort());
-        NetworkLogger::connectionClosed(clientInfo, "User disconnected");
-        
-        delete context;
+        // 释放连接表的引用；I/O线程仍持有引用时在其用完后释放
+        connections_.remove(socket);
+    }
+    
+    // 过期会话
+    if (sessionService_ && !sessionId.isEmpty()) {
+        sessionService_->expireSession(sessionId);
     }
     
-    connections_.remove(socket);
-    buffers_.remove(socket);
+    NetworkLogger::connectionClosed(context->peerInfo, "User disconnected");
+    
+    SendQueueStats stats = context->sendQueue.stats();
+    if (stats.droppedVideoFrames > 0) {
+        NetworkLogger::info("Connection Manager", 
+                           QString("Client %1 dropped %2 video frames (%3 bytes) during the session")
+                           .arg(context->peerInfo).arg(stats.droppedVideoFrames).arg(stats.droppedBytes));
+    }
+    return true;
 }
 
 void ConnectionManager::updateLastActivity(QTcpSocket* socket)
 {
+    QMutexLocker locker(&mutex_);
     ClientContext* context = getContext(socket);
     if (context) {
         context->lastActivity = QDateTime::currentDateTime();
     }
 }
 
-void ConnectionManager::onReadyRead()
+void ConnectionManager::handleReadyRead(QTcpSocket* socket)
 {
-    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
-    if (!socket) return;
+    ClientContextRef context = getContextRef(socket);
+    if (!context) return;
     
     updateLastActivity(socket);
     
     // 更新会话活动
     updateSessionActivity(socket);
     
-    QByteArray& buffer = buffers_[socket];
-    QByteArray newData = socket->readAll();
+    // 拆包器只由socket所属线程访问，无需加锁；数据直接读入拆包缓冲
+    PacketFramer& framer = context->framer;
+    qint64 received = framer.readFrom(socket);
     
-    if (!newData.isEmpty()) {
-        buffer.append(newData);
-        
+    if (received > 0) {
         QString clientInfo = QString("%1:%2")
                             .arg(socket->peerAddress().toString())
                             .arg(socket->peerPort());
-        NetworkLogger::debug("Connection Manager", 
+        NETWORK_LOG_DEBUG("Connection Manager", 
                             QString("Received %1 bytes from %2, buffer size: %3")
-                            .arg(newData.size())
+                            .arg(received)
                             .arg(clientInfo)
-                            .arg(buffer.size()));
+                            .arg(framer.bufferedBytes()));
         
-        // 解析数据包
+        // 解析数据包（转发模式：保留原始包块，媒体帧跳过JSON解析）
         QVector<Packet> packets;
-        if (drainPackets(buffer, packets)) {
+        if (framer.drain(packets)) {
             for (const Packet& packet : packets) {
                 if (messageRouter_) {
                     messageRouter_->handleMessage(socket, packet);
@@ -280,21 +446,41 @@ void ConnectionManager::onReadyRead()
             }
         }
     }
+    
+    // 包长度非法：数据流无法再对齐，或对端企图让接收缓冲无限增长，直接断开
+    if (framer.hasError()) {
+        NetworkLogger::warning("Connection Manager",
+                              QString("Invalid packet length from %1:%2, closing connection")
+                              .arg(socket->peerAddress().toString())
+                              .arg(socket->peerPort()));
+        socket->abort();
+    }
 }
 
-void ConnectionManager::onDisconnected()
+void ConnectionManager::handleDisconnected(QTcpSocket* socket)
 {
-    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
-    if (!socket) return;
+    // 会话过期等数据库操作统一在主线程执行；排在该socket已投递的消息之后
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, [this, socket]() {
+            removeConnection(socket);
+        }, Qt::QueuedConnection);
+        return;
+    }
     
-    cleanupConnection(socket);
+    removeConnection(socket);
 }
 
-void ConnectionManager::onError(QAbstractSocket::SocketError error)
+void ConnectionManager::handleBytesWritten(QTcpSocket* socket)
+{
+    // socket缓冲回落后继续写出队列中的数据
+    ClientContextRef context = getContextRef(socket);
+    if (context) {
+        flushSendQueue(socket, context.data());
+    }
+}
+
+void ConnectionManager::handleError(QTcpSocket* socket)
 {
-    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
-    if (!socket) return;
-    
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
@@ -313,14 +499,11 @@ bool ConnectionManager::createSessionForUser(QTcpSocket* socket, int userId, con
         return false;
     }
     
-    QMutexLocker locker(&mutex_);
-    
-    ClientContext* context = getContext(socket);
-    if (!context) {
+    if (!getContext(socket)) {
         return false;
     }
     
-    // 创建会话
+    // 创建会话（数据库写入不持有连接表的锁，避免阻塞I/O线程）
     QString sessionId = sessionService_->createSession(userId, roomId);
     if (sessionId.isEmpty()) {
         NetworkLogger::error("Connection Manager", "Failed to create session for user");
@@ -328,6 +511,11 @@ bool ConnectionManager::createSessionForUser(QTcpSocket* socket, int userId, con
     }
     
     // 更新客户端上下文
+    QMutexLocker locker(&mutex_);
+    ClientContext* context = getContext(socket);
+    if (!context) {
+        return false;
+    }
     context->sessionId = sessionId;
     context->currentRoom = roomId;
     
@@ -343,16 +531,56 @@ bool ConnectionManager::updateSessionActivity(QTcpSocket* socket)
         return false;
     }
     
-    QMutexLocker locker(&mutex_);
+    QString sessionId;
+    {
+        QMutexLocker locker(&mutex_);
+        ClientContext* context = getContext(socket);
+        if (!context || context->sessionId.isEmpty() || context->activityRefreshPending) {
+            return false;
+        }
+        sessionId = context->sessionId;
+    }
+    
+    // 快速路径：只更新内存表，可在任意I/O线程执行
+    if (sessionService_->touchSessionActivity(sessionId)) {
+        return true;
+    }
     
+    // 会话未登记或已过期，需要访问数据库，转到主线程处理
+    if (QThread::currentThread() != thread()) {
+        {
+            QMutexLocker locker(&mutex_);
+            ClientContext* context = getContext(socket);
+            if (!context) {
+                return false;
+            }
+            context->activityRefreshPending = true;
+        }
+        QMetaObject::invokeMethod(this, [this, socket, sessionId]() {
+            refreshSessionActivity(socket, sessionId);
+        }, Qt::QueuedConnection);
+        return true;
+    }
+    
+    return refreshSessionActivity(socket, sessionId);
+}
+
+bool ConnectionManager::refreshSessionActivity(QTcpSocket* socket, const QString& sessionId)
+{
+    bool success = sessionService_->updateSessionActivity(sessionId);
+    
+    QMutexLocker locker(&mutex_);
     ClientContext* context = getContext(socket);
-    if (!context || context->sessionId.isEmpty()) {
+    if (!context) {
         return false;
     }
     
-    bool success = sessionService_->updateSessionActivity(context->sessionId);
+    context->activityRefreshPending = false;
     if (success) {
         context->lastActivity = QDateTime::currentDateTime();
+    } else if (context->sessionId == sessionId) {
+        // 会话已失效，不再为后续数据包重复查询
+        context->sessionId.clear();
     }
     
     return success;
@@ -364,20 +592,22 @@ bool ConnectionManager::expireSession(QTcpSocket* socket)
         return false;
     }
     
-    QMutexLocker locker(&mutex_);
-    
-    ClientContext* context = getContext(socket);
-    if (!context || context->sessionId.isEmpty()) {
-        return false;
-    }
-    
-    bool success = sessionService_->expireSession(context->sessionId);
-    if (success) {
+    // 锁内取出并清除会话ID，数据库写入在锁外进行（同 createSessionForUser）
+    QString sessionId;
+    {
+        QMutexLocker locker(&mutex_);
+        
+        ClientContext* context = getContext(socket);
+        if (!context || context->sessionId.isEmpty()) {
+            return false;
+        }
+        
+        sessionId = context->sessionId;
         context->sessionId.clear();
         context->currentRoom.clear();
     }
     
-    return success;
+    return sessionService_->expireSession(sessionId);
 }
 
 bool ConnectionManager::isSessionValid(QTcpSocket* socket)
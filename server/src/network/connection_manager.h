@@ -8,24 +8,47 @@
 #include <QString>
 #include <QDateTime>
 #include <QMutex>
+#include <QSharedPointer>
+#include "server/send_queue.h"
+#include "../../../common/protocol/serialization/packet_framer.h"
 
 class MessageRouter;
+class IOWorker;
 
 // 客户端上下文结构
 struct ClientContext {
     QTcpSocket* socket = nullptr;
+    quint64 connectionId = 0;    // 连接序号：socket释放后地址可能被新连接复用，按序号区分
+    QString peerInfo;            // "地址:端口"，登记时生成，之后只读，可在任意线程使用
     QString username;
     int userId = -1;  // 添加用户ID
     QString currentRoom;
     QString sessionId;  // 添加会话ID
     bool isAuthenticated = false;
+    int protocolVersion = 1;  // 登录时协商的协议版本
     QDateTime connectedAt;
     QDateTime lastActivity;
+    IOWorker* worker = nullptr;  // 所属I/O线程，为空表示在主线程处理
+    PacketFramer framer;         // 增量拆包器（转发模式），仅由所属线程访问
+    SendQueue sendQueue;         // 出站队列，仅由所属线程访问
+    bool activityRefreshPending = false;
     
-    ClientContext(QTcpSocket* sock) : socket(sock), connectedAt(QDateTime::currentDateTime()) {}
+    ClientContext(QTcpSocket* sock) : socket(sock), connectedAt(QDateTime::currentDateTime()), framer(true) {}
 };
 
+// 上下文中跨线程读取字段的快照，由 getClientSnapshot 在锁内复制
+struct ClientSnapshot {
+    bool found = false;
+    bool isAuthenticated = false;
+    QString currentRoom;
+    QString peerInfo;
+};
+
+// 连接表持有一份引用；I/O线程在锁外使用上下文时另持一份，主线程清理连接不会释放正在使用的上下文
+typedef QSharedPointer<ClientContext> ClientContextRef;
+
 // 连接管理器 - 负责管理所有客户端连接
+// socket的读写在所属I/O线程中进行，连接表与房间表由mutex_保护，可跨线程访问
 class ConnectionManager : public QObject
 {
     Q_OBJECT
@@ -34,7 +57,7 @@ public:
     ~ConnectionManager();
 
     // 连接管理
-    void addConnection(QTcpSocket* socket);
+    void addConnection(QTcpSocket* socket, IOWorker* worker = nullptr);
     void removeConnection(QTcpSocket* socket);
     void disconnectAll();
     
@@ -42,6 +65,14 @@ public:
     QTcpSocket* getSocket(const QString& username);
     ClientContext* getContext(QTcpSocket* socket);
     ClientContext* getContext(const QString& username);
+    ClientContextRef getContextRef(QTcpSocket* socket) const;
+    quint64 getConnectionId(QTcpSocket* socket) const;  // 未登记时返回0
+    ClientSnapshot getClientSnapshot(QTcpSocket* socket) const;  // I/O线程做权限检查时使用
+    void setAuthentication(QTcpSocket* socket, const QString& username, int userId, bool authenticated);
+    
+    // 协议版本（登录时协商）
+    void setProtocolVersion(QTcpSocket* socket, int version);
+    int getProtocolVersion(QTcpSocket* socket) const;
     
     // 房间管理
     void joinRoom(QTcpSocket* socket, const QString& roomId);
@@ -50,10 +81,19 @@ public:
     QList<QTcpSocket*> getRoomMembers(const QString& roomId);
     void broadcastToRoom(const QString& roomId, const QByteArray& data, QTcpSocket* except = nullptr);
     
-    // 消息发送
-    void sendToClient(QTcpSocket* socket, const QByteArray& data);
+    // 消息发送；转发时originId为来源连接的序号
+    void sendToClient(QTcpSocket* socket, const QByteArray& data, quint64 originId = 0);
     void sendToClient(const QString& username, const QByteArray& data);
     
+    // 实际写入socket（只能在socket所属线程调用），经出站队列限速；
+    // connectionId与当前连接不符时说明原连接已关闭，数据丢弃
+    void writeToSocket(QTcpSocket* socket, quint64 connectionId, const QByteArray& data, quint64 originId = 0);
+    
+    // 出站队列设置：每个连接允许积压的字节数（含socket内部缓冲）
+    void setSendBudget(qint64 bytes);
+    qint64 getSendBudget() const;
+    SendQueueStats getSendQueueStats(QTcpSocket* socket) const;
+    
     // 用户映射管理
     void addUserSocket(const QString& username, QTcpSocket* socket);
     void removeUserSocket(const QString& username);
@@ -72,24 +112,29 @@ public:
     bool expireSession(QTcpSocket* socket);
     bool isSessionValid(QTcpSocket* socket);
 
-private slots:
-    void onReadyRead();
-    void onDisconnected();
-    void onError(QAbstractSocket::SocketError error);
-
 private:
-    QHash<QTcpSocket*, ClientContext*> connections_;
+    QHash<QTcpSocket*, ClientContextRef> connections_;
     QHash<QString, QTcpSocket*> userSockets_;
-    QHash<QTcpSocket*, QByteArray> buffers_;
     QHash<QString, QList<QTcpSocket*>> rooms_;
     
     MessageRouter* messageRouter_;
     class SessionService* sessionService_;
-    mutable QMutex mutex_;
+    mutable QMutex mutex_;  // 递归锁：清理连接时会嵌套调用其他加锁方法
+    qint64 sendBudgetBytes_;
+    quint64 nextConnectionId_;
+    
+    // socket事件处理（在socket所属线程中执行）
+    void handleReadyRead(QTcpSocket* socket);
+    void handleDisconnected(QTcpSocket* socket);
+    void handleError(QTcpSocket* socket);
+    void handleBytesWritten(QTcpSocket* socket);
+    
+    void flushSendQueue(QTcpSocket* socket, ClientContext* context);
     
-    void setupSocketConnections(QTcpSocket* socket);
-    void cleanupConnection(QTcpSocket* socket);
+    void setupSocketConnections(QTcpSocket* socket, QObject* receiver);
+    bool cleanupConnection(QTcpSocket* socket);  // 连接未登记时返回false
     void updateLastActivity(QTcpSocket* socket);
+    bool refreshSessionActivity(QTcpSocket* socket, const QString& sessionId);
 };
 
 #endif // CONNECTION_MANAGER_H
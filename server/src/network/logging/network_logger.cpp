@@ -53,6 +53,8 @@ void NetworkLogger::connectionError(const QString &clientInfo, const QString &er
 // 消息处理日志实现
 void NetworkLogger::messageReceived(const QString &clientInfo, quint16 msgType, int dataSize)
 {
+    if (!isDebugEnabled()) return;
+    
     QString message = QString("Message received from %1: Type=%2, Size=%3 bytes")
                      .arg(formatClientInfo(clientInfo))
                      .arg(formatMessageType(msgType))
@@ -62,6 +64,8 @@ void NetworkLogger::messageReceived(const QString &clientInfo, quint16 msgType,
 
 void NetworkLogger::messageSent(const QString &clientInfo, quint16 msgType, int dataSize)
 {
+    if (!isDebugEnabled()) return;
+    
     QString message = QString("Message sent to %1: Type=%2, Size=%3 bytes")
                      .arg(formatClientInfo(clientInfo))
                      .arg(formatMessageType(msgType))
@@ -71,6 +75,8 @@ void NetworkLogger::messageSent(const QString &clientInfo, quint16 msgType, int
 
 void NetworkLogger::messageRouting(const QString &clientInfo, quint16 msgType, const QString &handler)
 {
+    if (!isDebugEnabled()) return;
+    
     QString message = QString("Message routed from %1: Type=%2 -> Handler=%3")
                      .arg(formatClientInfo(clientInfo))
                      .arg(formatMessageType(msgType))
@@ -101,6 +107,8 @@ void NetworkLogger::userLeftRoom(const QString &username, const QString &roomId)
 
 void NetworkLogger::roomBroadcast(const QString &roomId, int memberCount, int dataSize)
 {
+    if (!isDebugEnabled()) return;
+    
     QString message = QString("Broadcast to room '%1': %2 members, %3 bytes")
                      .arg(roomId).arg(memberCount).arg(dataSize);
     LOG_DEBUG(LogModule::NETWORK, LogLayer::NETWORK, "Room Broadcast", message);
@@ -188,6 +196,7 @@ QString NetworkLogger::formatMessageType(quint16 msgType)
         case MSG_LEAVE_WORKORDER: return "LEAVE_WORKORDER";
         case MSG_UPDATE_WORKORDER: return "UPDATE_WORKORDER";
         case MSG_LIST_WORKORDERS: return "LIST_WORKORDERS";
+        case MSG_SEARCH_WORKORDERS: return "SEARCH_WORKORDERS";
         case MSG_DELETE_WORKORDER: return "DELETE_WORKORDER";
         case MSG_TEXT: return "TEXT";
         case MSG_DEVICE_DATA: return "DEVICE_DATA";
@@ -15,6 +15,12 @@ public:
     static void info(const QString &operation, const QString &message);
     static void debug(const QString &operation, const QString &message);
     
+    // 调试级别是否开启，用于跳过热路径上的消息构造
+    static bool isDebugEnabled()
+    {
+        return LogManager::getInstance()->isEnabled(LogModule::NETWORK, LogLayer::NETWORK, LogLevel::DEBUG);
+    }
+    
     // 连接相关日志
     static void connectionEstablished(const QString &clientInfo);
     static void connectionClosed(const QString &clientInfo, const QString &reason = QString());
@@ -62,4 +68,8 @@ private:
     static QString formatRoomInfo(const QString &roomId, int memberCount);
 };
 
+// 网络层惰性调试日志：级别未开启时不求值消息参数
+#define NETWORK_LOG_DEBUG(operation, message) \
+    LOG_DEBUG(LogModule::NETWORK, LogLayer::NETWORK, operation, message)
+
 #endif // NETWORK_LOGGER_H
@@ -1,10 +1,12 @@
 ﻿#include "network_server.h"
 #include "logging/network_logger.h"
 #include "../../../common/protocol/protocol.h"
+#include <QThread>
 
 NetworkServer::NetworkServer(QObject *parent)
     : QObject(parent)
     , tcpServer_(nullptr)
+    , ioWorkerPool_(nullptr)
     , connectionManager_(nullptr)
     , messageRouter_(nullptr)
     , userHandler_(nullptr)
@@ -13,6 +15,10 @@ NetworkServer::NetworkServer(QObject *parent)
     , userService_(nullptr)
     , workOrderService_(nullptr)
     , sessionService_(nullptr)
+    , ioThreadCount_(QThread::idealThreadCount())
+    , ioBalancePolicy_(IOWorkerPool::LEAST_LOADED)
+    , sendBudgetBytes_(4 * 1024 * 1024)
+    , dbExecutor_(nullptr)
 {
 }
 
@@ -25,10 +31,31 @@ NetworkServer::~NetworkServer()
     delete workOrderHandler_;
     delete userHandler_;
     delete messageRouter_;
+    delete ioWorkerPool_;
     delete connectionManager_;
     delete tcpServer_;
 }
 
+void NetworkServer::setIOThreadCount(int count)
+{
+    ioThreadCount_ = qMax(0, count);
+}
+
+void NetworkServer::setIOBalancePolicy(IOWorkerPool::BalancePolicy policy)
+{
+    ioBalancePolicy_ = policy;
+}
+
+void NetworkServer::setSendBudget(qint64 bytes)
+{
+    sendBudgetBytes_ = bytes;
+}
+
+void NetworkServer::setDBExecutor(DBExecutor* executor)
+{
+    dbExecutor_ = executor;
+}
+
 bool NetworkServer::initialize(UserService* userService, WorkOrderService* workOrderService)
 {
     if (!userService || !workOrderService) {
@@ -46,11 +73,24 @@ bool NetworkServer::initialize(UserService* userService, WorkOrderService* workO
     tcpServer_ = new TCPServer(this);
     connectionManager_ = new ConnectionManager(this);
     messageRouter_ = new MessageRouter(this);
+    connectionManager_->setSendBudget(sendBudgetBytes_);
+    
+    // 创建I/O线程池：每个线程拥有一部分连接，在各自的事件循环中收发
+    if (ioThreadCount_ > 0) {
+        ioWorkerPool_ = new IOWorkerPool(connectionManager_, this);
+        ioWorkerPool_->setBalancePolicy(ioBalancePolicy_);
+        if (!ioWorkerPool_->start(ioThreadCount_)) {
+            NetworkLogger::error("Network Server", "Failed to start I/O worker threads");
+            return false;
+        }
+    }
     
     // 创建协议处理器
     userHandler_ = new UserHandler(userService_, this);
     workOrderHandler_ = new WorkOrderHandler(workOrderService_, userService_, this);
     chatHandler_ = new ChatHandler(workOrderService_,this);
+    userHandler_->setDBExecutor(dbExecutor_);
+    workOrderHandler_->setDBExecutor(dbExecutor_);
     
     // 设置组件间的连接
     setupConnections();
@@ -92,6 +132,14 @@ void NetworkServer::stop()
         tcpServer_->stop();
         NetworkLogger::info("Network Server", "Network server stopped");
     }
+    
+    // 先在各I/O线程中关闭socket，再清理连接表
+    if (ioWorkerPool_ && ioWorkerPool_->isRunning()) {
+        ioWorkerPool_->stop();
+        if (connectionManager_) {
+            connectionManager_->disconnectAll();
+        }
+    }
 }
 
 bool NetworkServer::isRunning() const
@@ -132,6 +180,7 @@ void NetworkServer::registerMessageHandlers()
     messageRouter_->registerHandler(MSG_LEAVE_WORKORDER, workOrderHandler_);
     messageRouter_->registerHandler(MSG_UPDATE_WORKORDER, workOrderHandler_);
     messageRouter_->registerHandler(MSG_LIST_WORKORDERS, workOrderHandler_);
+    messageRouter_->registerHandler(MSG_SEARCH_WORKORDERS, workOrderHandler_);
     messageRouter_->registerHandler(MSG_GET_WORKORDER, workOrderHandler_);
     messageRouter_->registerHandler(MSG_DELETE_WORKORDER, workOrderHandler_);
     
@@ -142,6 +191,8 @@ void NetworkServer::registerMessageHandlers()
     messageRouter_->registerHandler(MSG_SCREENSHOT, chatHandler_);
     messageRouter_->registerHandler(MSG_VIDEO_FRAME, chatHandler_);
     messageRouter_->registerHandler(MSG_AUDIO_FRAME, chatHandler_);
+    messageRouter_->registerHandler(MSG_VIDEO_FRAME_BIN, chatHandler_);
+    messageRouter_->registerHandler(MSG_AUDIO_FRAME_BIN, chatHandler_);
     messageRouter_->registerHandler(MSG_VIDEO_CONTROL, chatHandler_);
     messageRouter_->registerHandler(MSG_AUDIO_CONTROL, chatHandler_);
     messageRouter_->registerHandler(MSG_CONTROL, chatHandler_);
@@ -159,6 +210,7 @@ void NetworkServer::setupConnections()
     
     // 设置TCP服务器和连接管理器的连接
     tcpServer_->setConnectionManager(connectionManager_);
+    tcpServer_->setWorkerPool(ioWorkerPool_);
     
     // 设置连接管理器和消息路由器的连接
     connectionManager_->setMessageRouter(messageRouter_);
@@ -186,6 +238,6 @@ void NetworkServer::onServerStopped()
 
 void NetworkServer::onConnectionCountChanged()
 {
-    NetworkLogger::debug("Network Server", 
+    NETWORK_LOG_DEBUG("Network Server", 
                          QString("Connection count changed: %1").arg(getConnectionCount()));
 }
@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QHostAddress>
 #include "server/tcp_server.h"
+#include "server/io_worker_pool.h"
 #include "connection_manager.h"
 #include "protocol/message_router.h"
 #include "protocol/protocol_handlers/user_handler.h"
@@ -21,6 +22,16 @@ public:
     explicit NetworkServer(QObject *parent = nullptr);
     ~NetworkServer();
 
+    // I/O线程配置（需在initialize之前设置，0表示所有连接留在主线程）
+    void setIOThreadCount(int count);
+    void setIOBalancePolicy(IOWorkerPool::BalancePolicy policy);
+    
+    // 每个连接的出站积压预算（字节），需在initialize之前设置
+    void setSendBudget(qint64 bytes);
+    
+    // 数据库执行器，设置后登录、创建和列表查询在数据库线程执行（需在initialize之前设置）
+    void setDBExecutor(DBExecutor* executor);
+    
     // 初始化网络服务器
     bool initialize(UserService* userService, WorkOrderService* workOrderService);
     
@@ -41,6 +52,7 @@ public:
 
 private:
     TCPServer* tcpServer_;
+    IOWorkerPool* ioWorkerPool_;
     ConnectionManager* connectionManager_;
     MessageRouter* messageRouter_;
     
@@ -54,6 +66,12 @@ private:
     WorkOrderService* workOrderService_;
     SessionService* sessionService_;
     
+    // I/O线程配置
+    int ioThreadCount_;
+    IOWorkerPool::BalancePolicy ioBalancePolicy_;
+    qint64 sendBudgetBytes_;
+    DBExecutor* dbExecutor_;
+    
     // 注册消息处理器
     void registerMessageHandlers();
     
@@ -1,6 +1,7 @@
 #include "message_router.h"
 #include "protocol_handler.h"
 #include "../logging/network_logger.h"
+#include <QThread>
 
 MessageRouter::MessageRouter(QObject *parent)
     : QObject(parent)
@@ -44,10 +45,20 @@ void MessageRouter::handleMessage(QTcpSocket* socket, const Packet& packet)
     
     ProtocolHandler* handler = getHandler(packet.type);
     if (handler) {
-        QString clientInfo = QString("%1:%2")
-                            .arg(socket->peerAddress().toString())
-                            .arg(socket->peerPort());
-        NetworkLogger::messageRouting(clientInfo, packet.type, handler->metaObject()->className());
+        // 业务处理器依赖主线程的数据库连接，按到达顺序排队到主线程执行
+        if (QThread::currentThread() != thread() && !handler->isThreadSafe(packet.type)) {
+            QMetaObject::invokeMethod(this, [this, socket, packet]() {
+                handleMessage(socket, packet);
+            }, Qt::QueuedConnection);
+            return;
+        }
+        
+        if (NetworkLogger::isDebugEnabled()) {
+            QString clientInfo = QString("%1:%2")
+                                .arg(socket->peerAddress().toString())
+                                .arg(socket->peerPort());
+            NetworkLogger::messageRouting(clientInfo, packet.type, handler->metaObject()->className());
+        }
         
         handler->handleMessage(socket, packet);
     } else {
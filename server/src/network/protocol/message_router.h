@@ -20,7 +20,7 @@ public:
     void registerHandler(quint16 msgType, ProtocolHandler* handler);
     void unregisterHandler(quint16 msgType);
     
-    // 处理消息
+    // 处理消息（可在I/O线程调用，非线程安全的处理器会被转到路由器所在线程执行）
     void handleMessage(QTcpSocket* socket, const Packet& packet);
     
     // 获取处理器
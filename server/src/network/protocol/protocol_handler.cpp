@@ -6,6 +6,7 @@
 ProtocolHandler::ProtocolHandler(QObject *parent)
     : QObject(parent)
     , connectionManager_(nullptr)
+    , dbExecutor_(nullptr)
 {
 }
 
@@ -13,6 +14,12 @@ ProtocolHandler::~ProtocolHandler()
 {
 }
 
+bool ProtocolHandler::isThreadSafe(quint16 msgType) const
+{
+    Q_UNUSED(msgType);
+    return false;
+}
+
 void ProtocolHandler::setConnectionManager(ConnectionManager* manager)
 {
     connectionManager_ = manager;
@@ -23,6 +30,11 @@ ConnectionManager* ProtocolHandler::getConnectionManager() const
     return connectionManager_;
 }
 
+void ProtocolHandler::setDBExecutor(DBExecutor* executor)
+{
+    dbExecutor_ = executor;
+}
+
 void ProtocolHandler::sendResponse(QTcpSocket* socket, const QJsonObject& response)
 {
     // 没有填写具体消息类型的默认情况，使用MSG_SERVER_EVENT发送响应
@@ -39,22 +51,19 @@ void ProtocolHandler::sendResponse(QTcpSocket* socket, quint16 msgType, const QJ
     QByteArray packetData = buildPacket(msgType, response);
     connectionManager_->sendToClient(socket, packetData);
     
-    QString clientInfo = QString("%1:%2")
-                        .arg(socket->peerAddress().toString())
-                        .arg(socket->peerPort());
+    QString clientInfo = getClientInfo(socket);
     NetworkLogger::messageSent(clientInfo, msgType, packetData.size());
 }
 
-void ProtocolHandler::sendErrorResponse(QTcpSocket* socket, quint16 msgType, int errorCode, const QString& message)
+void ProtocolHandler::sendErrorResponse(QTcpSocket* socket, quint16 msgType, int errorCode, const QString& message,
+                                        const QJsonObject& data)
 {
     // 使用MessageBuilder构建错误响应
-    QJsonObject response = MessageBuilder::buildErrorResponse(errorCode, message);
+    QJsonObject response = MessageBuilder::buildErrorResponse(errorCode, message, data);
     
     sendResponse(socket, msgType, response);
     
-    QString clientInfo = QString("%1:%2")
-                        .arg(socket->peerAddress().toString())
-                        .arg(socket->peerPort());
+    QString clientInfo = getClientInfo(socket);
     NetworkLogger::protocolError(clientInfo, "Error Response", QString("%1 - %2").arg(errorCode).arg(message));
 }
 
@@ -65,10 +74,8 @@ void ProtocolHandler::sendSuccessResponse(QTcpSocket* socket, quint16 msgType, c
     
     sendResponse(socket, msgType, response);
     
-    QString clientInfo = QString("%1:%2")
-                        .arg(socket->peerAddress().toString())
-                        .arg(socket->peerPort());
-    NetworkLogger::debug("Protocol Handler", 
+    QString clientInfo = getClientInfo(socket);
+    NETWORK_LOG_DEBUG("Protocol Handler", 
                          QString("Sent success response to %1: %2")
                          .arg(clientInfo)
                          .arg(message));
@@ -83,18 +90,34 @@ struct ClientContext* ProtocolHandler::getClientContext(QTcpSocket* socket)
     return connectionManager_->getContext(socket);
 }
 
+quint64 ProtocolHandler::getConnectionId(QTcpSocket* socket) const
+{
+    if (!connectionManager_) {
+        return 0;
+    }
+
+    return connectionManager_->getConnectionId(socket);
+}
+
+QString ProtocolHandler::getClientInfo(QTcpSocket* socket) const
+{
+    if (!connectionManager_) {
+        return QString();
+    }
+
+    return connectionManager_->getClientSnapshot(socket).peerInfo;
+}
+
 bool ProtocolHandler::checkAuthentication(QTcpSocket* socket)
 {
     if (!connectionManager_) {
         return false;
     }
     
-    ClientContext* context = connectionManager_->getContext(socket);
-    if (!context || !context->isAuthenticated) {
-        QString clientInfo = QString("%1:%2")
-                            .arg(socket->peerAddress().toString())
-                            .arg(socket->peerPort());
-        NetworkLogger::authenticationFailed(clientInfo, "Authentication required");
+    // 在I/O线程调用：上下文字段只能在锁内读取，socket属于其他线程，对端地址取登记时的快照
+    ClientSnapshot client = connectionManager_->getClientSnapshot(socket);
+    if (!client.found || !client.isAuthenticated) {
+        NetworkLogger::authenticationFailed(client.peerInfo, "Authentication required");
         sendErrorResponse(socket, MSG_ERROR, 403, "Authentication required. Please login first.");
         return false;
     }
@@ -108,12 +131,9 @@ bool ProtocolHandler::checkRoomMembership(QTcpSocket* socket)
         return false;
     }
     
-    ClientContext* context = connectionManager_->getContext(socket);
-    if (!context || context->currentRoom.isEmpty()) {
-        QString clientInfo = QString("%1:%2")
-                            .arg(socket->peerAddress().toString())
-                            .arg(socket->peerPort());
-        NetworkLogger::authorizationFailed(clientInfo, "Room Membership", "Please join a room first");
+    ClientSnapshot client = connectionManager_->getClientSnapshot(socket);
+    if (!client.found || client.currentRoom.isEmpty()) {
+        NetworkLogger::authorizationFailed(client.peerInfo, "Room Membership", "Please join a room first");
         sendErrorResponse(socket, MSG_ERROR, 403, "Please join a room first.");
         return false;
     }
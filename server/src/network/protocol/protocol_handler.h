@@ -5,6 +5,7 @@
 #include <QTcpSocket>
 #include <QJsonObject>
 #include "../../../common/protocol/protocol.h"
+#include "../../data/base/db_executor.h"
 
 class ConnectionManager;
 
@@ -19,28 +20,60 @@ public:
     // 处理消息的虚函数，子类必须实现
     virtual void handleMessage(QTcpSocket* socket, const Packet& packet) = 0;
     
+    // 该类型消息能否直接在I/O线程处理（不访问数据库等主线程资源），默认否
+    virtual bool isThreadSafe(quint16 msgType) const;
+    
     // 设置连接管理器
     void setConnectionManager(ConnectionManager* manager);
     
     // 获取连接管理器
     ConnectionManager* getConnectionManager() const;
+    
+    // 设置数据库执行器，未设置时数据库操作在处理器线程同步执行
+    void setDBExecutor(DBExecutor* executor);
 
 protected:
     // 发送响应的辅助方法
     void sendResponse(QTcpSocket* socket, const QJsonObject& response);
     void sendResponse(QTcpSocket* socket, quint16 msgType, const QJsonObject& response);
-    void sendErrorResponse(QTcpSocket* socket, quint16 msgType, int errorCode, const QString& message);
+    void sendErrorResponse(QTcpSocket* socket, quint16 msgType, int errorCode, const QString& message,
+                           const QJsonObject& data = QJsonObject());
     void sendSuccessResponse(QTcpSocket* socket, quint16 msgType, const QString& message, const QJsonObject& data = QJsonObject());
     
     // 获取客户端上下文的辅助方法
     struct ClientContext* getClientContext(QTcpSocket* socket);
+    // 连接编号，socket 未登记时为0；socket 指针可能被新连接复用，编号不会
+    quint64 getConnectionId(QTcpSocket* socket) const;
+    // 日志用的"地址:端口"，取登记时的快照，不访问其他线程的socket
+    QString getClientInfo(QTcpSocket* socket) const;
     
     // 认证检查的辅助方法
     bool checkAuthentication(QTcpSocket* socket);
     bool checkRoomMembership(QTcpSocket* socket);
+    
+    // 在数据库执行器上运行 task，结果回到处理器线程交给 done；
+    // 期间客户端已断开（或 socket 已被新连接复用）则丢弃结果。task 中只能访问业务服务，不能访问socket和连接上下文
+    template <typename Task, typename Done>
+    void runAsync(QTcpSocket* socket, Task task, Done done)
+    {
+        const quint64 connectionId = getConnectionId(socket);
+        auto finish = [this, socket, connectionId, done](decltype(task()) result) mutable {
+            if (connectionId == 0 || getConnectionId(socket) != connectionId) {
+                return;
+            }
+            done(result);
+        };
+        
+        if (!dbExecutor_) {
+            finish(task());
+            return;
+        }
+        dbExecutor_->submit(this, std::move(task), std::move(finish));
+    }
 
 private:
     ConnectionManager* connectionManager_;
+    DBExecutor* dbExecutor_;
 };
 
 #endif // PROTOCOL_HANDLER_H
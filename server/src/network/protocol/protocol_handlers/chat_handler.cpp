@@ -4,23 +4,17 @@
 #include "../../../common/protocol/protocol.h"
 #include "../services/workorder_service.h"
 
-ForwardTask::ForwardTask(QTcpSocket* target,const QByteArray& data):m_target(target),m_data(data){}
-void ForwardTask::run()
-{
-    if(m_target&&m_target->state()==QAbstractSocket::ConnectedState)
-    {
-        m_target->write(m_data);
-    }
-}
 ChatHandler::ChatHandler(WorkOrderService* workOrderService, QObject *parent): ProtocolHandler(parent), m_workOrderService(workOrderService)
 {
-    // 初始化线程池，设置合适的线程数量
-    m_threadPool.setMaxThreadCount(QThread::idealThreadCount() * 2);
 }
 
 ChatHandler::~ChatHandler()
 {
-    m_threadPool.waitForDone();
+}
+
+bool ChatHandler::isThreadSafe(quint16 msgType) const
+{
+    return isRelayMediaType(msgType);
 }
 
 void ChatHandler::handleMessage(QTcpSocket* socket, const Packet& packet)
@@ -51,6 +45,8 @@ void ChatHandler::handleMessage(QTcpSocket* socket, const Packet& packet)
         // 实时媒体流采用专用处理路径
         case MSG_VIDEO_FRAME:   
         case MSG_AUDIO_FRAME:
+        case MSG_VIDEO_FRAME_BIN:
+        case MSG_AUDIO_FRAME_BIN:
             handleRealTimeMedia(socket,packet);
             break;
         case MSG_VIDEO_CONTROL:
@@ -93,26 +89,25 @@ void ChatHandler::handleTextMessage(QTcpSocket* socket, const Packet& packet)
     
     // 广播到房间
     // 检查是否在正确的房间
-    QString currentRoom = connectionManager_-> getCurrentRoom(socket);
+    QString currentRoom = getConnectionManager()->getCurrentRoom(socket);
         if (currentRoom != roomId) {
             sendErrorResponse(socket, MSG_TEXT, 400, "Not in the correct room for this message");
             return;
         }
     // 构建数据包并转发到房间
-    QByteArray packetData = buildPacket(packet.type, packet.json, packet.bin);
-            forwardToRoomParticipants(roomId, packetData, socket);
+    forwardToRoomParticipants(roomId, wireBytes(packet), socket);
     
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("Text message broadcasted from %1")
                          .arg(clientInfo));
 }
 
 void ChatHandler::handleRealTimeMedia(QTcpSocket *socket, const Packet &packet)
 {
-    QString roomId = connectionManager_-> getCurrentRoom(socket);
+    QString roomId = getConnectionManager()->getCurrentRoom(socket);
     if(roomId.isEmpty())
     {
         sendErrorResponse(socket, MSG_ERROR, 400, "Not in a room");
@@ -120,41 +115,94 @@ void ChatHandler::handleRealTimeMedia(QTcpSocket *socket, const Packet &packet)
     }
 
     // 极简验证 - 只验证必要字段以降低延迟
-    if(packet.bin.isEmpty())
+    // 转发模式下负载保留在原始包块中，直接读取长度而不拆包
+    int mediaSize = packet.raw.isEmpty() ? packet.bin.size() : rawPacketBinSize(packet.raw);
+    if(isBinaryMediaType(packet.type))
+    {
+        // 二进制帧头不计入媒体数据
+        mediaSize -= ProtocolConstants::MEDIA_HEADER_SIZE;
+    }
+    if(mediaSize <= 0)
     {
         sendErrorResponse(socket, MSG_ERROR, 400, "Media data cannot be empty");
         return;
     }
 
-    QByteArray packetData = buildPacket(packet.type, packet.json, packet.bin);
-    forwardToRoomParticipants(roomId,packetData,socket);
+    // 窥探到的roomId必须与当前房间一致
+    const QString packetRoom = packet.json.value("roomId").toString();
+    if(!packetRoom.isEmpty() && packetRoom != roomId)
+    {
+        sendErrorResponse(socket, MSG_ERROR, 400, "Not in the correct room for this message");
+        return;
+    }
+
+    if(isBinaryMediaType(packet.type))
+    {
+        forwardBinaryMedia(roomId, wireBytes(packet), socket);
+    }
+    else
+    {
+        forwardToRoomParticipants(roomId, wireBytes(packet), socket);
+    }
 
     // 记录日志
     QString clientInfo = QString("%1,%2").arg(socket->peerAddress().toString()).arg(socket->peerPort());
-    NetworkLogger::debug("RealTime Media",
+    NETWORK_LOG_DEBUG("RealTime Media",
                          QString("Media data from %1 forwarded to room %2 (%3 bytes)")
-                         .arg(clientInfo).arg(roomId).arg(packet.bin.size()));
+                         .arg(clientInfo).arg(roomId).arg(mediaSize));
 }
 
 void ChatHandler::forwardToRoomParticipants(const QString &roomId, const QByteArray &data, QTcpSocket *excludeSocket)
 {
-    if(!m_roomMembers.contains(roomId))
+    const QList<QTcpSocket*> roomSockets = getConnectionManager()->getRoomMembers(roomId);
+    if(roomSockets.isEmpty())
     {
         NetworkLogger::warning("Chat Handler",
                                QString("Attempted to forward to non-existent room: %1").arg(roomId));
         return;
     }
-    QSet<QTcpSocket*>roomSockets = m_roomMembers[roomId];
+    // 由各目标socket所属的I/O线程写出：同线程直接写，跨线程经邮箱投递
+    // 带上来源连接序号，目标的出站队列按来源区分各路视频流
+    const quint64 originId = excludeSocket ? getConnectionManager()->getConnectionId(excludeSocket) : 0;
+    for(QTcpSocket* targetSocket:roomSockets)
+    {
+        if(targetSocket==excludeSocket)continue;
+        getConnectionManager()->sendToClient(targetSocket, data, originId);
+    }
+}
+
+void ChatHandler::forwardBinaryMedia(const QString &roomId, const QByteArray &data, QTcpSocket *excludeSocket)
+{
+    // 协议版本2的成员直接转发原始包；旧版成员需要JSON帧头，只在房间中确有旧版成员时转换一次
+    QByteArray legacyData;
+    const QList<QTcpSocket*> roomSockets = getConnectionManager()->getRoomMembers(roomId);
+    const quint64 originId = excludeSocket ? getConnectionManager()->getConnectionId(excludeSocket) : 0;
     for(QTcpSocket* targetSocket:roomSockets)
     {
         if(targetSocket==excludeSocket)continue;
-        if(targetSocket&&targetSocket->state()==QAbstractSocket::ConnectedState)
+        if(getConnectionManager()->getProtocolVersion(targetSocket) >= ProtocolConstants::PROTOCOL_VERSION_BINARY_MEDIA)
         {
-            ForwardTask* task = new ForwardTask(targetSocket,data);
-            m_threadPool.start(task);
+            getConnectionManager()->sendToClient(targetSocket, data, originId);
+            continue;
         }
+        if(legacyData.isEmpty())
+        {
+            legacyData = mediaPacketToLegacy(data, roomId);
+            if(legacyData.isEmpty())return;
+        }
+        getConnectionManager()->sendToClient(targetSocket, legacyData, originId);
+    }
+}
+
+QByteArray ChatHandler::wireBytes(const Packet& packet) const
+{
+    // 原始包块在拆包时已拷贝一次，各接收方共享这一份，转发时不再做JSON编码和重新打包
+    if (!packet.raw.isEmpty()) {
+        return packet.raw;
     }
+    return buildPacket(packet.type, packet.json, packet.bin);
 }
+
 void ChatHandler::handleDeviceData(QTcpSocket* socket, const Packet& packet)
 {
     // 使用MessageValidator验证设备数据消息
@@ -174,20 +222,19 @@ void ChatHandler::handleDeviceData(QTcpSocket* socket, const Packet& packet)
     }
     
     // 检查是否在正确的房间
-        QString currentRoom = connectionManager_-> getCurrentRoom(socket);
+        QString currentRoom = getConnectionManager()->getCurrentRoom(socket);
         if (currentRoom != roomId) {
             sendErrorResponse(socket, MSG_DEVICE_DATA, 400, "Not in the correct room for this message");
             return;
         }
 
         // 构建数据包并转发到房间
-        QByteArray packetData = buildPacket(packet.type, packet.json, packet.bin);
-        forwardToRoomParticipants(roomId, packetData, socket);
+        forwardToRoomParticipants(roomId, wireBytes(packet), socket);
     
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("Device data broadcasted from %1")
                          .arg(clientInfo));
 }
@@ -222,7 +269,7 @@ void ChatHandler::handleVideoFrame(QTcpSocket* socket, const Packet& packet)
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("Video frame broadcasted from %1 (%2 bytes)")
                          .arg(clientInfo)
                          .arg(packet.bin.size()));
@@ -258,7 +305,7 @@ void ChatHandler::handleAudioFrame(QTcpSocket* socket, const Packet& packet)
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("Audio frame broadcasted from %1 (%2 bytes)")
                          .arg(clientInfo)
                          .arg(packet.bin.size()));
@@ -278,7 +325,7 @@ void ChatHandler::handleFileTransfer(QTcpSocket* socket, const Packet& packet)
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("File transfer broadcasted from %1 (%2 bytes)")
                          .arg(clientInfo)
                          .arg(packet.bin.size()));
@@ -298,7 +345,7 @@ void ChatHandler::handleScreenshot(QTcpSocket* socket, const Packet& packet)
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("Screenshot broadcasted from %1 (%2 bytes)")
                          .arg(clientInfo)
                          .arg(packet.bin.size()));
@@ -318,7 +365,7 @@ void ChatHandler::handleVideoControl(QTcpSocket* socket, const Packet& packet)
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("Video control broadcasted from %1")
                          .arg(clientInfo));
 }
@@ -337,7 +384,7 @@ void ChatHandler::handleAudioControl(QTcpSocket* socket, const Packet& packet)
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("Audio control broadcasted from %1")
                          .arg(clientInfo));
 }
@@ -356,7 +403,7 @@ void ChatHandler::handleDeviceControl(QTcpSocket* socket, const Packet& packet)
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("Device control broadcasted from %1")
                          .arg(clientInfo));
 }
@@ -375,7 +422,7 @@ void ChatHandler::handleSystemControl(QTcpSocket* socket, const Packet& packet)
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("System control broadcasted from %1")
                          .arg(clientInfo));
 }
@@ -399,20 +446,19 @@ void ChatHandler::handleControl(QTcpSocket* socket, const Packet& packet)
     }
     
     // 检查是否在正确的房间
-        QString currentRoom = connectionManager_-> getCurrentRoom(socket);
+        QString currentRoom = getConnectionManager()->getCurrentRoom(socket);
         if (currentRoom != roomId) {
             sendErrorResponse(socket, MSG_CONTROL, 400, "Not in the correct room for this message");
             return;
         }
 
         // 构建数据包并转发到房间
-        QByteArray packetData = buildPacket(packet.type, packet.json, packet.bin);
-        forwardToRoomParticipants(roomId, packetData, socket);
+        forwardToRoomParticipants(roomId, wireBytes(packet), socket);
     
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("Chat Handler", 
+    NETWORK_LOG_DEBUG("Chat Handler", 
                          QString("Control message '%1' broadcasted from %2")
                          .arg(controlType)
                          .arg(clientInfo));
@@ -420,15 +466,12 @@ void ChatHandler::handleControl(QTcpSocket* socket, const Packet& packet)
 
 void ChatHandler::broadcastToRoom(QTcpSocket* socket, const Packet& packet)
 {
-    QString roomId = connectionManager_-> getCurrentRoom(socket);
+    QString roomId = getConnectionManager()->getCurrentRoom(socket);
     if(roomId.isEmpty())
     {
         sendErrorResponse(socket, MSG_ERROR, 400, "Not in a room");
         return;
     }
-    // 构建数据包
-    QByteArray packetData = buildPacket(packet.type, packet.json, packet.bin);
-    
     // 广播到房间内其他成员
-    forwardToRoomParticipants(roomId,packetData,socket);
+    forwardToRoomParticipants(roomId, wireBytes(packet), socket);
 }
@@ -4,22 +4,10 @@
 #include "../protocol_handler.h"
 #include <QObject>
 #include <QTcpSocket>
-#include <QThreadPool>
-#include <QRunnable>
 #include "../../connection_manager.h"
 
 class WorkOrderService;
 
-class ForwardTask:public QRunnable
-{
-public:
-    ForwardTask(QTcpSocket* target,const QByteArray& data);
-    void run() override;
-private:
-    QTcpSocket* m_target;
-    QByteArray m_data;
-};
-
 // 聊天协议处理器 - 处理聊天相关的消息
 class ChatHandler : public ProtocolHandler
 {
@@ -30,6 +18,9 @@ public:
 
     // 实现基类的消息处理方法
     void handleMessage(QTcpSocket* socket, const Packet& packet) override;
+    
+    // 实时媒体帧只做房间内转发，直接在收包的I/O线程处理
+    bool isThreadSafe(quint16 msgType) const override;
 
     void joinRoom(QTcpSocket* socket, const QString& roomId);
     void leaveRoom(QTcpSocket* socket);
@@ -51,14 +42,12 @@ private:
     void broadcastToRoom(QTcpSocket* socket, const Packet& packet);
     void forwardToRoomParticipants(const QString& roomId, const QByteArray& data, QTcpSocket* excludeSocket = nullptr);
     void handleRealTimeMedia(QTcpSocket* socket, const Packet& packet);
-
-    // 房间管理
-    QMap<QTcpSocket*, QString> m_roomMemberships; //  socket -> roomId
-    QMap<QString, QSet<QTcpSocket*>> m_roomMembers; // roomId -> sockets
+    void forwardBinaryMedia(const QString& roomId, const QByteArray& data, QTcpSocket* excludeSocket);
+    
+    // 取得转发用的线路数据：有原始包块时直接复用，否则重新打包
+    QByteArray wireBytes(const Packet& packet) const;
 
     WorkOrderService* m_workOrderService;
-    QThreadPool m_threadPool;
-    ConnectionManager* connectionManager_;
 };
 
 #endif // CHAT_HANDLER_H
@@ -4,6 +4,14 @@
 #include "../../../common/protocol/protocol.h"
 #include <QDateTime>
 
+namespace {
+// 在数据库线程完成的登录校验结果
+struct LoginResult {
+    bool success = false;
+    int userId = -1;
+};
+}
+
 UserHandler::UserHandler(UserService* userService, QObject *parent)
     : ProtocolHandler(parent)
     , userService_(userService)
@@ -59,16 +67,42 @@ void UserHandler::handleLogin(QTcpSocket* socket, const QJsonObject& data)
         return;
     }
     
-    // 调用业务服务进行认证
-    bool success = userService_->authenticateUser(username, password, userType);
+    // 认证在数据库线程执行，结果回到本线程后再更新连接状态
+    const int clientVersion = data.value("protocolVersion").toInt(ProtocolConstants::PROTOCOL_VERSION_LEGACY);
+    UserService* userService = userService_;
+    runAsync(socket, [userService, username, password, userType]() {
+        LoginResult result;
+        result.success = userService->authenticateUser(username, password, userType);
+        if (result.success) {
+            result.userId = userService->getUserId(username);
+        }
+        return result;
+    }, [this, socket, username, password, userType, clientVersion](const LoginResult& result) {
+        finishLogin(socket, username, password, userType, clientVersion, result.success, result.userId);
+    });
+}
+
+void UserHandler::finishLogin(QTcpSocket* socket, const QString& username, const QString& password,
+                              int userType, int clientVersion, bool success, int userId)
+{
+    // 同一连接并发提交的登录请求只接受第一个
+    ClientContext* context = getClientContext(socket);
+    if (context && context->isAuthenticated) {
+        sendErrorResponse(socket, MSG_LOGIN, 400, "Already logged in");
+        return;
+    }
     
     if (success) {
-        // 获取用户ID
-        int userId = userService_->getUserId(username);
-        
         // 更新客户端认证状态
         updateClientAuthentication(socket, username, userId, true);
         
+        // 协商协议版本：未声明版本的旧客户端按版本1处理
+        int protocolVersion = qBound(ProtocolConstants::PROTOCOL_VERSION_LEGACY, clientVersion,
+                                     ProtocolConstants::PROTOCOL_VERSION);
+        if (getConnectionManager()) {
+            getConnectionManager()->setProtocolVersion(socket, protocolVersion);
+        }
+        
         // 创建用户会话（临时房间，后续加入工单时会更新）
         QString tempRoomId = QString("temp_%1").arg(userId);
         if (getConnectionManager()) {
@@ -77,6 +111,7 @@ void UserHandler::handleLogin(QTcpSocket* socket, const QJsonObject& data)
         
         // 使用MessageBuilder构建成功响应，包含用户ID
         QJsonObject responseData = MessageBuilder::buildLoginMessage(username, password, userType, userId);
+        responseData["protocolVersion"] = protocolVersion;
         sendSuccessResponse(socket, MSG_LOGIN, "Login successful", responseData);
         
         QString clientInfo = QString("%1:%2")
@@ -126,7 +161,7 @@ void UserHandler::handleHeartbeat(QTcpSocket* socket, const QJsonObject& data)
     QString clientInfo = QString("%1:%2")
                         .arg(socket->peerAddress().toString())
                         .arg(socket->peerPort());
-    NetworkLogger::debug("User Handler", 
+    NETWORK_LOG_DEBUG("User Handler", 
                         QString("Heartbeat from %1")
                         .arg(clientInfo));
 }
@@ -182,11 +217,9 @@ void UserHandler::updateClientAuthentication(QTcpSocket* socket, const QString&
         return;
     }
     
-    ClientContext* context = manager->getContext(socket);
-    if (context) {
-        context->isAuthenticated = authenticated;
-        context->username = authenticated ? username : QString();
-        context->userId = authenticated ? userId : -1;
+    if (manager->getContext(socket)) {
+        // 认证状态会被I/O线程上的权限检查读取，经管理器在锁内修改
+        manager->setAuthentication(socket, username, userId, authenticated);
         
         if (authenticated) {
             // 将用户添加到用户映射中
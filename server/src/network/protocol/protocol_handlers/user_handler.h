@@ -24,6 +24,10 @@ private:
     void handleLogout(QTcpSocket* socket, const QJsonObject& data);
     void handleHeartbeat(QTcpSocket* socket, const QJsonObject& data);
     
+    // 认证完成后更新连接状态并回复（处理器线程）
+    void finishLogin(QTcpSocket* socket, const QString& username, const QString& password,
+                     int userType, int clientVersion, bool success, int userId);
+    
     // 辅助方法
     void updateClientAuthentication(QTcpSocket* socket, const QString& username, int userId, bool authenticated);
 };
@@ -7,6 +7,15 @@
 #include "../../../common/protocol/types/enums.h"
 #include "../../../business/services/workorder_service.h"
 
+namespace {
+// 在数据库线程完成的处理结果：code为0表示成功，否则为错误码
+struct DBTaskResult {
+    int code = 0;
+    QString message;
+    QJsonObject data;
+};
+}
+
 WorkOrderHandler::WorkOrderHandler(WorkOrderService* workOrderService, UserService* userService, QObject *parent)
     : ProtocolHandler(parent)
     , workOrderService_(workOrderService)
@@ -41,6 +50,9 @@ void WorkOrderHandler::handleMessage(QTcpSocket* socket, const Packet& packet)
         case MSG_LIST_WORKORDERS:
             handleListWorkOrders(socket, packet.json);
             break;
+        case MSG_SEARCH_WORKORDERS:
+            handleSearchWorkOrders(socket, packet.json);
+            break;
         case MSG_GET_WORKORDER:
             handleGetWorkOrderDetail(socket, packet.json);
             break;
@@ -93,29 +105,34 @@ void WorkOrderHandler::handleCreateWorkOrder(QTcpSocket* socket, const QJsonObje
     QString priorityString = convertPriorityToString(priority);
     NetworkLogger::info("Work Order Handler", QString("Priority converted: %1 -> %2").arg(priority).arg(priorityString));
     
-    // 调用业务服务创建工单
+    // 调用业务服务创建工单（数据库线程）
     NetworkLogger::info("Work Order Handler", "Calling work order service to create work order");
-    QString generatedTicketId;
-    bool success = workOrderService_->createWorkOrder(title, description, creatorId, priorityString, category, expertUsername, generatedTicketId);
-    
-    if (success) {
-        QJsonObject responseData = MessageBuilder::buildWorkOrderCreatedResponse(
-            generatedTicketId, title, priorityString, category);
-        sendSuccessResponse(socket, MSG_CREATE_WORKORDER, "Work order created successfully", responseData);
+    WorkOrderService* workOrderService = workOrderService_;
+    UserService* userService = userService_;
+    runAsync(socket, [workOrderService, userService, title, description, creatorId, priorityString, category, expertUsername]() {
+        DBTaskResult result;
+        QString generatedTicketId;
+        bool success = workOrderService->createWorkOrder(title, description, creatorId, priorityString, category, expertUsername, generatedTicketId);
+        
+        if (success) {
+            result.data = MessageBuilder::buildWorkOrderCreatedResponse(
+                generatedTicketId, title, priorityString, category);
+            NetworkLogger::info("Work Order Handler", 
+                               QString("Work order '%1' created successfully by user %2, assigned to expert %3")
+                               .arg(generatedTicketId).arg(creatorId).arg(expertUsername));
+            return result;
+        }
         
-        NetworkLogger::info("Work Order Handler", 
-                           QString("Work order '%1' created successfully by user %2, assigned to expert %3")
-                           .arg(generatedTicketId).arg(creatorId).arg(expertUsername));
-    } else {
         NetworkLogger::error("Work Order Handler", QString("Work order creation failed for user %1").arg(creatorId));
         
         // 检查是否是专家不存在导致的失败
-        UserModel expert = userService_->getUserInfo(expertUsername);
+        UserModel expert = userService->getUserInfo(expertUsername);
         if (!expert.isValid() || expert.userType != USER_TYPE_EXPERT) {
             NetworkLogger::error("Work Order Handler", 
                                 QString("Expert validation failed - Username: %1, Valid: %2, UserType: %3")
                                 .arg(expertUsername).arg(expert.isValid()).arg(expert.userType));
-            sendErrorResponse(socket, MSG_CREATE_WORKORDER, 404, QString("Expert not found: %1").arg(expertUsername));
+            result.code = 404;
+            result.message = QString("Expert not found: %1").arg(expertUsername);
             NetworkLogger::error("Work Order Handler", 
                                 QString("Failed to create work order for user %1: Expert %2 not found")
                                 .arg(creatorId).arg(expertUsername));
@@ -123,12 +140,20 @@ void WorkOrderHandler::handleCreateWorkOrder(QTcpSocket* socket, const QJsonObje
             NetworkLogger::error("Work Order Handler", 
                                 QString("Work order creation failed for unknown reason - Expert exists: %1")
                                 .arg(expertUsername));
-            sendErrorResponse(socket, MSG_CREATE_WORKORDER, 500, "Failed to create work order");
+            result.code = 500;
+            result.message = "Failed to create work order";
             NetworkLogger::error("Work Order Handler", 
                                 QString("Failed to create work order for user %1")
                                 .arg(creatorId));
         }
-    }
+        return result;
+    }, [this, socket](const DBTaskResult& result) {
+        if (result.code != 0) {
+            sendErrorResponse(socket, MSG_CREATE_WORKORDER, result.code, result.message);
+            return;
+        }
+        sendSuccessResponse(socket, MSG_CREATE_WORKORDER, "Work order created successfully", result.data);
+    });
 }
 
 void WorkOrderHandler::handleJoinWorkOrder(QTcpSocket* socket, const QJsonObject& data)
@@ -269,7 +294,7 @@ void WorkOrderHandler::handleGetWorkOrderList(QTcpSocket* socket, const QJsonObj
     int limit = data.value("limit").toInt(50);
     int offset = data.value("offset").toInt(0);
     
-    QList<WorkOrderModel> workOrders;
+    QList<WorkOrderSummary> workOrders;
     
     if (!status.isEmpty()) {
         workOrders = workOrderService_->getWorkOrdersByStatus(status, limit, offset);
@@ -278,7 +303,7 @@ void WorkOrderHandler::handleGetWorkOrderList(QTcpSocket* socket, const QJsonObj
     }
     
     QJsonArray workOrderArray;
-    for (const WorkOrderModel& workOrder : workOrders) {
+    for (const WorkOrderSummary& workOrder : workOrders) {
         workOrderArray.append(workOrder.toJson());
     }
     
@@ -399,70 +424,160 @@ void WorkOrderHandler::handleUpdateWorkOrder(QTcpSocket* socket, const QJsonObje
 
 void WorkOrderHandler::handleListWorkOrders(QTcpSocket* socket, const QJsonObject& data)
 {
+    // 客户端请求序号，原样带回（包括错误响应）以便客户端丢弃过期响应
+    const int requestSeq = data.value("request_seq").toInt();
+    const QJsonObject seqData{{"request_seq", requestSeq}};
+    
     // 使用MessageValidator验证获取工单列表消息
     QString validationError;
     if (!MessageValidator::validateListWorkOrdersMessage(data, validationError)) {
-        sendErrorResponse(socket, MSG_LIST_WORKORDERS, 400, validationError);
+        sendErrorResponse(socket, MSG_LIST_WORKORDERS, 400, validationError, seqData);
         return;
     }
     
     // 使用MessageParser解析获取工单列表消息
-    QString status;
-    int limit, offset;
-    if (!MessageParser::parseListWorkOrdersMessage(data, status, limit, offset)) {
-        sendErrorResponse(socket, MSG_LIST_WORKORDERS, 400, "Invalid list work orders message format");
+    QString status, cursor;
+    int limit;
+    if (!MessageParser::parseListWorkOrdersMessage(data, status, cursor, limit)) {
+        sendErrorResponse(socket, MSG_LIST_WORKORDERS, 400, "Invalid list work orders message format", seqData);
         return;
     }
     
     int userId = getUserIdFromContext(socket);
     if (userId <= 0) {
-        sendErrorResponse(socket, MSG_LIST_WORKORDERS, 400, "Invalid user context");
+        sendErrorResponse(socket, MSG_LIST_WORKORDERS, 400, "Invalid user context", seqData);
         return;
     }
     
-    // 获取用户信息以确定用户类型
-    UserModel user = userService_->getUserInfo(userId);
-    if (!user.isValid()) {
-        sendErrorResponse(socket, MSG_LIST_WORKORDERS, 400, "User not found");
+    // 查询与序列化都在数据库线程完成
+    WorkOrderService* workOrderService = workOrderService_;
+    UserService* userService = userService_;
+    runAsync(socket, [workOrderService, userService, userId, cursor, limit]() {
+        DBTaskResult result;
+        
+        // 获取用户信息以确定用户类型
+        UserModel user = userService->getUserInfo(userId);
+        if (!user.isValid()) {
+            result.code = 400;
+            result.message = "User not found";
+            return result;
+        }
+        
+        // 根据用户类型获取不同的工单列表（按页返回，客户端凭 next_cursor 继续获取）
+        WorkOrderPage page;
+        int totalCount = 0;
+        QString listType;
+        
+        if (user.userType == USER_TYPE_EXPERT) {
+            // 专家用户：获取指派给自己的工单
+            page = workOrderService->getWorkOrderPageByAssignee(userId, cursor, limit);
+            totalCount = workOrderService->getWorkOrderCountByAssignee(userId);
+            listType = "created";
+            NetworkLogger::info("Work Order Handler", QString("Retrieving assigned work orders for expert user %1").arg(userId));
+        } else {
+            // 普通用户（工厂端）：获取自己创建的工单
+            page = workOrderService->getWorkOrderPageByCreator(userId, cursor, limit);
+            totalCount = workOrderService->getWorkOrderCountByCreator(userId);
+            listType = "created";
+            NetworkLogger::info("Work Order Handler", QString("Retrieving created work orders for factory user %1").arg(userId));
+        }
+        
+        QJsonArray workOrderArray;
+        for (const auto& workOrder : page.items) {
+            workOrderArray.append(workOrder.toJson());
+        }
+        
+        result.data = MessageBuilder::buildWorkOrderListResponse(
+            workOrderArray, totalCount, page.nextCursor, page.hasMore);
+        
+        // 添加列表类型信息
+        result.data["list_type"] = listType;
+        result.data["user_type"] = user.userType;
+        
+        NetworkLogger::info("Work Order Handler", 
+                           QString("Retrieved %1/%2 %3 work orders for user %4 (type: %5, has more: %6)")
+                           .arg(workOrderArray.size())
+                           .arg(totalCount)
+                           .arg(listType)
+                           .arg(userId)
+                           .arg(user.userType)
+                           .arg(page.hasMore));
+        return result;
+    }, [this, socket, requestSeq, seqData](const DBTaskResult& result) {
+        if (result.code != 0) {
+            sendErrorResponse(socket, MSG_LIST_WORKORDERS, result.code, result.message, seqData);
+            return;
+        }
+        QJsonObject responseData = result.data;
+        responseData["request_seq"] = requestSeq;
+        sendSuccessResponse(socket, MSG_LIST_WORKORDERS, "Work orders retrieved successfully", responseData);
+    });
+}
+
+void WorkOrderHandler::handleSearchWorkOrders(QTcpSocket* socket, const QJsonObject& data)
+{
+    const int requestSeq = data.value("request_seq").toInt();
+    const QJsonObject seqData{{"request_seq", requestSeq}};
+    
+    QString validationError;
+    if (!MessageValidator::validateSearchWorkOrdersMessage(data, validationError)) {
+        sendErrorResponse(socket, MSG_SEARCH_WORKORDERS, 400, validationError, seqData);
         return;
     }
     
-    // 根据用户类型获取不同的工单列表
-    QList<WorkOrderModel> workOrders;
-    QString listType;
-    
-    if (user.userType == USER_TYPE_EXPERT) {
-        // 专家用户：获取指派给自己的工单
-        workOrders = workOrderService_->getWorkOrdersByAssignee(userId);
-        listType = "created";
-        NetworkLogger::info("Work Order Handler", QString("Retrieving assigned work orders for expert user %1").arg(userId));
-    } else {
-        // 普通用户（工厂端）：获取自己创建的工单
-        workOrders = workOrderService_->getWorkOrdersByCreator(userId);
-        listType = "created";
-        NetworkLogger::info("Work Order Handler", QString("Retrieving created work orders for factory user %1").arg(userId));
+    QString text, cursor;
+    int limit;
+    if (!MessageParser::parseSearchWorkOrdersMessage(data, text, cursor, limit)) {
+        sendErrorResponse(socket, MSG_SEARCH_WORKORDERS, 400, "Invalid search work orders message format", seqData);
+        return;
     }
     
-    QJsonArray workOrderArray;
-    for (const auto& workOrder : workOrders) {
-        workOrderArray.append(workOrder.toJson());
+    int userId = getUserIdFromContext(socket);
+    if (userId <= 0) {
+        sendErrorResponse(socket, MSG_SEARCH_WORKORDERS, 400, "Invalid user context", seqData);
+        return;
     }
     
-    QJsonObject responseData = MessageBuilder::buildWorkOrderListResponse(
-        workOrderArray, workOrderArray.size());
-    
-    // 添加列表类型信息
-    responseData["list_type"] = listType;
-    responseData["user_type"] = user.userType;
-    
-    sendSuccessResponse(socket, MSG_LIST_WORKORDERS, "Work orders retrieved successfully", responseData);
-    
-    NetworkLogger::info("Work Order Handler", 
-                       QString("Retrieved %1 %2 work orders for user %3 (type: %4)")
-                       .arg(workOrderArray.size())
-                       .arg(listType)
-                       .arg(userId)
-                       .arg(user.userType));
+    // 搜索范围与工单列表一致：专家搜索指派给自己的工单，普通用户搜索自己创建的工单
+    WorkOrderService* workOrderService = workOrderService_;
+    UserService* userService = userService_;
+    runAsync(socket, [workOrderService, userService, userId, text, cursor, limit]() {
+        DBTaskResult result;
+        
+        UserModel user = userService->getUserInfo(userId);
+        if (!user.isValid()) {
+            result.code = 400;
+            result.message = "User not found";
+            return result;
+        }
+        
+        WorkOrderPage page = user.userType == USER_TYPE_EXPERT
+                           ? workOrderService->searchWorkOrdersByAssignee(text, userId, cursor, limit)
+                           : workOrderService->searchWorkOrdersByCreator(text, userId, cursor, limit);
+        
+        QJsonArray workOrderArray;
+        for (const auto& workOrder : page.items) {
+            workOrderArray.append(workOrder.toJson());
+        }
+        
+        result.data = MessageBuilder::buildWorkOrderSearchResponse(workOrderArray, text, page.nextCursor, page.hasMore);
+        
+        NetworkLogger::info("Work Order Handler", 
+                           QString("Search '%1' matched %2 work orders for user %3 (has more: %4)")
+                           .arg(text)
+                           .arg(workOrderArray.size())
+                           .arg(userId)
+                           .arg(page.hasMore));
+        return result;
+    }, [this, socket, requestSeq, seqData](const DBTaskResult& result) {
+        if (result.code != 0) {
+            sendErrorResponse(socket, MSG_SEARCH_WORKORDERS, result.code, result.message, seqData);
+            return;
+        }
+        QJsonObject responseData = result.data;
+        responseData["request_seq"] = requestSeq;
+        sendSuccessResponse(socket, MSG_SEARCH_WORKORDERS, "Work orders searched successfully", responseData);
+    });
 }
 
 void WorkOrderHandler::handleDeleteWorkOrder(QTcpSocket* socket, const QJsonObject& data)
@@ -26,6 +26,7 @@ private:
     void handleLeaveWorkOrder(QTcpSocket* socket, const QJsonObject& data);
     void handleUpdateWorkOrder(QTcpSocket* socket, const QJsonObject& data);
     void handleListWorkOrders(QTcpSocket* socket, const QJsonObject& data);
+    void handleSearchWorkOrders(QTcpSocket* socket, const QJsonObject& data);
     void handleGetWorkOrderDetail(QTcpSocket* socket, const QJsonObject& data);
     void handleGetWorkOrderInfo(QTcpSocket* socket, const QJsonObject& data);
     void handleUpdateWorkOrderStatus(QTcpSocket* socket, const QJsonObject& data);
@@ -0,0 +1,192 @@
+#include "io_worker.h"
+#include "../connection_manager.h"
+#include "../logging/network_logger.h"
+#include <QThread>
+
+// ---------------- SendMailbox ----------------
+
+SendMailbox::SendMailbox()
+    : head_(&stub_)
+    , tail_(&stub_)
+{
+}
+
+SendMailbox::~SendMailbox()
+{
+    Item item;
+    while (pop(item)) {
+    }
+}
+
+void SendMailbox::push(QTcpSocket* socket, quint64 connectionId, const QByteArray& data, quint64 originId)
+{
+    Node* node = new Node;
+    node->item.socket = socket;
+    node->item.connectionId = connectionId;
+    node->item.originId = originId;
+    node->item.data = data;
+    pushNode(node);
+}
+
+void SendMailbox::pushNode(Node* node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+bool SendMailbox::pop(Item& item)
+{
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+
+    // 跳过哨兵节点
+    if (tail == &stub_) {
+        if (!next) {
+            return false;
+        }
+        tail_ = next;
+        tail = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next) {
+        tail_ = next;
+        item = std::move(tail->item);
+        delete tail;
+        return true;
+    }
+
+    // 生产者正在链接新节点，稍后再取
+    if (tail != head_.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    // 队列只剩最后一个节点：重新放入哨兵后再取出它
+    pushNode(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+        tail_ = next;
+        item = std::move(tail->item);
+        delete tail;
+        return true;
+    }
+
+    return false;
+}
+
+// ---------------- IOWorker ----------------
+
+IOWorker::IOWorker(int index, ConnectionManager* connectionManager, QObject *parent)
+    : QObject(parent)
+    , index_(index)
+    , connectionManager_(connectionManager)
+    , wakePending_(false)
+    , connectionCount_(0)
+{
+}
+
+IOWorker::~IOWorker()
+{
+    // 正常情况下shutdown()已在工作线程中释放socket
+    qDeleteAll(sockets_);
+    sockets_.clear();
+}
+
+void IOWorker::adoptDescriptor(qintptr socketDescriptor)
+{
+    // 先计数，保证连续接入时最少连接策略能看到尚未建立完成的连接
+    connectionCount_.fetch_add(1, std::memory_order_relaxed);
+
+    QMetaObject::invokeMethod(this, [this, socketDescriptor]() {
+        acceptDescriptor(socketDescriptor);
+    }, Qt::QueuedConnection);
+}
+
+void IOWorker::send(QTcpSocket* socket, quint64 connectionId, const QByteArray& data, quint64 originId)
+{
+    if (!socket || data.isEmpty()) return;
+
+    if (isCurrentThread()) {
+        if (sockets_.contains(socket)) {
+            connectionManager_->writeToSocket(socket, connectionId, data, originId);
+        }
+        return;
+    }
+
+    mailbox_.push(socket, connectionId, data, originId);
+    wakeUp();
+}
+
+bool IOWorker::isCurrentThread() const
+{
+    return QThread::currentThread() == thread();
+}
+
+void IOWorker::shutdown()
+{
+    // 断开信号后直接释放，避免关闭过程中再向主线程投递清理请求
+    for (QTcpSocket* socket : sockets_) {
+        socket->disconnect();
+        socket->abort();
+        delete socket;
+    }
+    sockets_.clear();
+    connectionCount_.store(0, std::memory_order_relaxed);
+
+    SendMailbox::Item item;
+    while (mailbox_.pop(item)) {
+    }
+
+    NetworkLogger::info("IO Worker", QString("Worker %1 shut down").arg(index_));
+}
+
+void IOWorker::drainMailbox()
+{
+    // 先清除唤醒标记，之后投递的数据会触发新一轮唤醒
+    wakePending_.store(false, std::memory_order_release);
+
+    SendMailbox::Item item;
+    while (mailbox_.pop(item)) {
+        // socket可能已在投递后断开，其地址也可能已分配给新连接，由连接序号区分
+        if (sockets_.contains(item.socket)) {
+            connectionManager_->writeToSocket(item.socket, item.connectionId, item.data, item.originId);
+        }
+    }
+}
+
+void IOWorker::acceptDescriptor(qintptr socketDescriptor)
+{
+    // socket在工作线程中创建，其读写事件都由本线程的事件循环处理
+    QTcpSocket* socket = new QTcpSocket;
+    if (!socket->setSocketDescriptor(socketDescriptor)) {
+        NetworkLogger::error("IO Worker",
+                             QString("Worker %1 failed to adopt socket: %2")
+                             .arg(index_).arg(socket->errorString()));
+        delete socket;
+        connectionCount_.fetch_sub(1, std::memory_order_relaxed);
+        return;
+    }
+
+    sockets_.insert(socket);
+    connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+        onSocketDisconnected(socket);
+    });
+
+    connectionManager_->addConnection(socket, this);
+}
+
+void IOWorker::onSocketDisconnected(QTcpSocket* socket)
+{
+    if (sockets_.remove(socket)) {
+        connectionCount_.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+void IOWorker::wakeUp()
+{
+    // 合并唤醒：邮箱未被处理前只投递一次事件
+    if (!wakePending_.exchange(true, std::memory_order_acq_rel)) {
+        QMetaObject::invokeMethod(this, "drainMailbox", Qt::QueuedConnection);
+    }
+}
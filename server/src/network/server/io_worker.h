@@ -0,0 +1,91 @@
+#ifndef IO_WORKER_H
+#define IO_WORKER_H
+
+#include <QObject>
+#include <QTcpSocket>
+#include <QByteArray>
+#include <QSet>
+#include <atomic>
+
+class ConnectionManager;
+
+// 发送邮箱 - 多生产者单消费者的无锁队列（Vyukov侵入式队列）
+// 任意线程投递待发送数据，只由所属I/O线程取出并写入socket
+class SendMailbox
+{
+public:
+    struct Item {
+        QTcpSocket* socket = nullptr;
+        quint64 connectionId = 0;   // 投递时的连接序号，取出时核对，防止socket地址被新连接复用
+        quint64 originId = 0;       // 转发来源的连接序号，出站队列按来源区分视频流
+        QByteArray data;
+    };
+
+    SendMailbox();
+    ~SendMailbox();
+
+    // 投递（任意线程）
+    void push(QTcpSocket* socket, quint64 connectionId, const QByteArray& data, quint64 originId);
+
+    // 取出（仅所属线程），队列为空时返回false
+    bool pop(Item& item);
+
+private:
+    struct Node {
+        std::atomic<Node*> next;
+        Item item;
+        Node() : next(nullptr) {}
+    };
+
+    void pushNode(Node* node);
+
+    std::atomic<Node*> head_;  // 生产者端
+    Node* tail_;               // 消费者端
+    Node stub_;
+
+    SendMailbox(const SendMailbox&) = delete;
+    SendMailbox& operator=(const SendMailbox&) = delete;
+};
+
+// I/O工作线程 - 拥有一部分客户端socket，在自己的事件循环中完成读写
+class IOWorker : public QObject
+{
+    Q_OBJECT
+public:
+    explicit IOWorker(int index, ConnectionManager* connectionManager, QObject *parent = nullptr);
+    ~IOWorker();
+
+    // 接管一个新连接（任意线程调用，socket在工作线程中创建）
+    void adoptDescriptor(qintptr socketDescriptor);
+
+    // 发送数据（任意线程调用）：本线程直接写，其他线程经邮箱转交
+    void send(QTcpSocket* socket, quint64 connectionId, const QByteArray& data, quint64 originId = 0);
+
+    // 是否运行在本工作线程中
+    bool isCurrentThread() const;
+
+    // 统计信息
+    int index() const { return index_; }
+    int connectionCount() const { return connectionCount_.load(std::memory_order_relaxed); }
+
+public slots:
+    // 关闭并释放本线程拥有的所有socket（在工作线程中执行）
+    void shutdown();
+
+private slots:
+    void drainMailbox();
+
+private:
+    void acceptDescriptor(qintptr socketDescriptor);
+    void onSocketDisconnected(QTcpSocket* socket);
+    void wakeUp();
+
+    int index_;
+    ConnectionManager* connectionManager_;
+    QSet<QTcpSocket*> sockets_;      // 仅在工作线程中访问
+    SendMailbox mailbox_;
+    std::atomic<bool> wakePending_;
+    std::atomic<int> connectionCount_;
+};
+
+#endif // IO_WORKER_H
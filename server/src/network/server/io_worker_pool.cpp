@@ -0,0 +1,122 @@
+#include "io_worker_pool.h"
+#include "../connection_manager.h"
+#include "../logging/network_logger.h"
+
+IOWorkerPool::IOWorkerPool(ConnectionManager* connectionManager, QObject *parent)
+    : QObject(parent)
+    , connectionManager_(connectionManager)
+    , balancePolicy_(LEAST_LOADED)
+    , nextIndex_(0)
+{
+}
+
+IOWorkerPool::~IOWorkerPool()
+{
+    stop();
+}
+
+bool IOWorkerPool::start(int threadCount)
+{
+    if (isRunning()) {
+        NetworkLogger::warning("IO Worker Pool", "Worker pool is already running");
+        return true;
+    }
+
+    if (threadCount <= 0 || !connectionManager_) {
+        NetworkLogger::error("IO Worker Pool", QString("Invalid worker pool configuration: %1 threads").arg(threadCount));
+        return false;
+    }
+
+    for (int i = 0; i < threadCount; ++i) {
+        // 工作对象不设父对象，移入各自线程后由线程池负责释放
+        IOWorker* worker = new IOWorker(i, connectionManager_);
+        QThread* thread = new QThread;
+        thread->setObjectName(QString("io-worker-%1").arg(i));
+        worker->moveToThread(thread);
+        thread->start();
+
+        workers_.append(worker);
+        threads_.append(thread);
+    }
+
+    nextIndex_ = 0;
+    NetworkLogger::info("IO Worker Pool", QString("Started %1 I/O worker threads").arg(threadCount));
+    return true;
+}
+
+void IOWorkerPool::stop()
+{
+    if (!isRunning()) {
+        return;
+    }
+
+    for (int i = 0; i < workers_.size(); ++i) {
+        IOWorker* worker = workers_[i];
+        QThread* thread = threads_[i];
+
+        // socket必须在所属线程中释放
+        if (thread->isRunning()) {
+            QMetaObject::invokeMethod(worker, "shutdown", Qt::BlockingQueuedConnection);
+            thread->quit();
+            thread->wait();
+        }
+
+        delete worker;
+        delete thread;
+    }
+
+    workers_.clear();
+    threads_.clear();
+
+    NetworkLogger::info("IO Worker Pool", "All I/O worker threads stopped");
+}
+
+bool IOWorkerPool::isRunning() const
+{
+    return !workers_.isEmpty();
+}
+
+IOWorker* IOWorkerPool::nextWorker()
+{
+    if (workers_.isEmpty()) {
+        return nullptr;
+    }
+
+    if (balancePolicy_ == LEAST_LOADED) {
+        IOWorker* best = workers_.first();
+        for (IOWorker* worker : workers_) {
+            if (worker->connectionCount() < best->connectionCount()) {
+                best = worker;
+            }
+        }
+        return best;
+    }
+
+    IOWorker* worker = workers_[nextIndex_];
+    nextIndex_ = (nextIndex_ + 1) % workers_.size();
+    return worker;
+}
+
+void IOWorkerPool::setBalancePolicy(BalancePolicy policy)
+{
+    balancePolicy_ = policy;
+}
+
+IOWorkerPool::BalancePolicy IOWorkerPool::getBalancePolicy() const
+{
+    return balancePolicy_;
+}
+
+int IOWorkerPool::workerCount() const
+{
+    return workers_.size();
+}
+
+QList<int> IOWorkerPool::connectionDistribution() const
+{
+    QList<int> counts;
+    for (IOWorker* worker : workers_) {
+        counts.append(worker->connectionCount());
+    }
+    return counts;
+}
@@ -0,0 +1,49 @@
+#ifndef IO_WORKER_POOL_H
+#define IO_WORKER_POOL_H
+
+#include <QObject>
+#include <QList>
+#include <QThread>
+#include "io_worker.h"
+
+class ConnectionManager;
+
+// I/O线程池 - 创建N个各自运行事件循环的工作线程，并为新连接选择所属线程
+class IOWorkerPool : public QObject
+{
+    Q_OBJECT
+public:
+    // 连接分配策略
+    enum BalancePolicy {
+        ROUND_ROBIN,    // 轮询
+        LEAST_LOADED    // 当前连接数最少
+    };
+
+    explicit IOWorkerPool(ConnectionManager* connectionManager, QObject *parent = nullptr);
+    ~IOWorkerPool();
+
+    // 启动/停止工作线程
+    bool start(int threadCount);
+    void stop();
+    bool isRunning() const;
+
+    // 为新连接选择工作线程（在接受连接的线程中调用）
+    IOWorker* nextWorker();
+
+    // 分配策略
+    void setBalancePolicy(BalancePolicy policy);
+    BalancePolicy getBalancePolicy() const;
+
+    // 统计信息
+    int workerCount() const;
+    QList<int> connectionDistribution() const;
+
+private:
+    ConnectionManager* connectionManager_;
+    QList<IOWorker*> workers_;
+    QList<QThread*> threads_;
+    BalancePolicy balancePolicy_;
+    int nextIndex_;
+};
+
+#endif // IO_WORKER_POOL_H
@@ -0,0 +1,136 @@
+#include "send_queue.h"
+#include "../../../../common/protocol/protocol.h"
+#include <QHash>
+
+SendQueue::SendQueue()
+    : queuedBytes_(0)
+    , queuedPackets_(0)
+    , droppedVideoFrames_(0)
+    , droppedBytes_(0)
+{
+}
+
+int SendQueue::enqueue(const QByteArray& data, qint64 pendingSocketBytes, qint64 byteBudget, quint64 originId)
+{
+    if (data.isEmpty()) return 0;
+
+    Entry entry;
+    entry.data = data;
+    entry.type = rawPacketType(data);
+    entry.stream = StreamKey(originId, entry.type);
+    if (isVideo(entry)) {
+        if (entry.type == MSG_VIDEO_FRAME_BIN) {
+            MediaFrameHeader header;
+            entry.keyFrame = readMediaPacketHeader(data, header) && header.isKeyFrame();
+        } else {
+            // 未声明keyFrame的帧视为可独立解码（如逐帧JPEG）
+            entry.keyFrame = peekRawJsonField(data, "keyFrame") != "false";
+        }
+
+        if (!entry.keyFrame && waitingForKeyFrame_.contains(entry.stream)) {
+            countDrop(data.size());
+            return 1;
+        }
+        if (entry.keyFrame) {
+            waitingForKeyFrame_.remove(entry.stream);
+        }
+    }
+
+    entries_.append(entry);
+    queuedBytes_.fetch_add(data.size(), std::memory_order_relaxed);
+    queuedPackets_.fetch_add(1, std::memory_order_relaxed);
+
+    if (byteBudget > 0 && pendingSocketBytes + queuedBytes_.load(std::memory_order_relaxed) > byteBudget) {
+        return dropStaleVideoFrames();
+    }
+    return 0;
+}
+
+bool SendQueue::isEmpty() const
+{
+    return entries_.isEmpty();
+}
+
+const QByteArray& SendQueue::front() const
+{
+    return entries_.first().data;
+}
+
+void SendQueue::popFront()
+{
+    if (entries_.isEmpty()) return;
+
+    queuedBytes_.fetch_sub(entries_.first().data.size(), std::memory_order_relaxed);
+    queuedPackets_.fetch_sub(1, std::memory_order_relaxed);
+    entries_.removeFirst();
+}
+
+void SendQueue::clear()
+{
+    entries_.clear();
+    queuedBytes_.store(0, std::memory_order_relaxed);
+    queuedPackets_.store(0, std::memory_order_relaxed);
+    waitingForKeyFrame_.clear();
+}
+
+SendQueueStats SendQueue::stats() const
+{
+    SendQueueStats s;
+    s.queuedBytes = queuedBytes_.load(std::memory_order_relaxed);
+    s.queuedPackets = queuedPackets_.load(std::memory_order_relaxed);
+    s.droppedVideoFrames = droppedVideoFrames_.load(std::memory_order_relaxed);
+    s.droppedBytes = droppedBytes_.load(std::memory_order_relaxed);
+    return s;
+}
+
+bool SendQueue::isVideo(const Entry& entry) const
+{
+    return entry.type == MSG_VIDEO_FRAME || entry.type == MSG_VIDEO_FRAME_BIN;
+}
+
+int SendQueue::dropStaleVideoFrames()
+{
+    // 每路流找到队列中最新的关键帧，它之前的同一路流视频帧都已过期
+    QHash<StreamKey, int> latestKey;
+    QSet<StreamKey> streams;
+    for (int i = entries_.size() - 1; i >= 0; --i) {
+        const Entry& entry = entries_[i];
+        if (!isVideo(entry)) continue;
+
+        streams.insert(entry.stream);
+        if (entry.keyFrame && !latestKey.contains(entry.stream)) {
+            latestKey.insert(entry.stream, i);
+        }
+    }
+
+    // 没有关键帧的流：队列中的差分帧无法再解码，全部丢弃并等待该流的下一个关键帧
+    for (const StreamKey& stream : streams) {
+        if (!latestKey.contains(stream)) {
+            waitingForKeyFrame_.insert(stream);
+        }
+    }
+
+    int dropped = 0;
+    for (int i = entries_.size() - 1; i >= 0; --i) {
+        const Entry& entry = entries_[i];
+        if (!isVideo(entry)) continue;
+
+        const auto key = latestKey.constFind(entry.stream);
+        if (key != latestKey.constEnd() && i >= key.value()) continue;
+
+        const int size = entry.data.size();
+        queuedBytes_.fetch_sub(size, std::memory_order_relaxed);
+        queuedPackets_.fetch_sub(1, std::memory_order_relaxed);
+        countDrop(size);
+        entries_.removeAt(i);
+        dropped++;
+    }
+
+    return dropped;
+}
+
+void SendQueue::countDrop(qint64 bytes)
+{
+    droppedVideoFrames_.fetch_add(1, std::memory_order_relaxed);
+    droppedBytes_.fetch_add(bytes, std::memory_order_relaxed);
+}
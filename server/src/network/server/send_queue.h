@@ -0,0 +1,63 @@
+#ifndef SEND_QUEUE_H
+#define SEND_QUEUE_H
+
+#include <QByteArray>
+#include <QList>
+#include <QPair>
+#include <QSet>
+#include <atomic>
+
+// 发送队列统计
+struct SendQueueStats {
+    qint64 queuedBytes = 0;
+    int queuedPackets = 0;
+    qint64 droppedVideoFrames = 0;
+    qint64 droppedBytes = 0;
+};
+
+// 单个连接的出站队列 - 只在socket所属线程中读写，统计值可跨线程读取
+// 超出字节预算时只丢弃过期的视频帧（每路流保留最新关键帧），音频与控制消息从不丢弃
+class SendQueue
+{
+public:
+    SendQueue();
+
+    // 入队；pendingSocketBytes为socket内部缓冲尚未写出的字节数，originId为转发来源的连接序号
+    // 返回本次因拥塞丢弃的视频帧数
+    int enqueue(const QByteArray& data, qint64 pendingSocketBytes, qint64 byteBudget, quint64 originId = 0);
+
+    bool isEmpty() const;
+    const QByteArray& front() const;
+    void popFront();
+    void clear();
+
+    SendQueueStats stats() const;
+
+private:
+    // 视频流：来源连接 + 消息类型。差分帧只依赖同一路流的前帧
+    typedef QPair<quint64, quint16> StreamKey;
+
+    struct Entry {
+        QByteArray data;
+        quint16 type = 0;
+        bool keyFrame = false;
+        StreamKey stream;
+    };
+
+    bool isVideo(const Entry& entry) const;
+    int dropStaleVideoFrames();
+    void countDrop(qint64 bytes);
+
+    QList<Entry> entries_;
+    QSet<StreamKey> waitingForKeyFrame_;  // 已丢弃参考帧的流，在该流下一个关键帧到来前丢弃其差分帧
+
+    std::atomic<qint64> queuedBytes_;
+    std::atomic<int> queuedPackets_;
+    std::atomic<qint64> droppedVideoFrames_;
+    std::atomic<qint64> droppedBytes_;
+
+    SendQueue(const SendQueue&) = delete;
+    SendQueue& operator=(const SendQueue&) = delete;
+};
+
+#endif // SEND_QUEUE_H
@@ -1,10 +1,17 @@
 #include "tcp_server.h"
 #include "../connection_manager.h"
 #include "../logging/network_logger.h"
+#include "io_worker_pool.h"
+
+void TCPListener::incomingConnection(qintptr socketDescriptor)
+{
+    emit socketDescriptorReady(socketDescriptor);
+}
 
 TCPServer::TCPServer(QObject *parent)
     : QObject(parent)
     , connectionManager_(nullptr)
+    , workerPool_(nullptr)
 {
     setupConnections();
 }
@@ -70,23 +77,40 @@ void TCPServer::setConnectionManager(ConnectionManager* manager)
     connectionManager_ = manager;
 }
 
+void TCPServer::setWorkerPool(IOWorkerPool* pool)
+{
+    workerPool_ = pool;
+}
+
 void TCPServer::setupConnections()
 {
-    connect(&server_, &QTcpServer::newConnection, 
+    connect(&server_, &TCPListener::socketDescriptorReady, 
             this, &TCPServer::onNewConnection);
 }
 
-void TCPServer::onNewConnection()
+void TCPServer::onNewConnection(qintptr socketDescriptor)
 {
-    while (server_.hasPendingConnections()) {
-        QTcpSocket* socket = server_.nextPendingConnection();
-        
-        if (connectionManager_) {
-            connectionManager_->addConnection(socket);
-        } else {
-            NetworkLogger::error("TCP Server", "Connection manager not set, cannot handle new connection");
-            socket->close();
-            socket->deleteLater();
-        }
+    if (!connectionManager_) {
+        NetworkLogger::error("TCP Server", "Connection manager not set, cannot handle new connection");
+        QTcpSocket socket;
+        socket.setSocketDescriptor(socketDescriptor);
+        socket.abort();
+        return;
+    }
+    
+    // 按分配策略交给某个I/O线程，socket在该线程中创建
+    IOWorker* worker = workerPool_ ? workerPool_->nextWorker() : nullptr;
+    if (worker) {
+        worker->adoptDescriptor(socketDescriptor);
+        return;
+    }
+    
+    // 未启用I/O线程池：在主线程中处理
+    QTcpSocket* socket = new QTcpSocket;
+    if (!socket->setSocketDescriptor(socketDescriptor)) {
+        NetworkLogger::error("TCP Server", QString("Failed to accept connection: %1").arg(socket->errorString()));
+        delete socket;
+        return;
     }
+    connectionManager_->addConnection(socket);
 }
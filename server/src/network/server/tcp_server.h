@@ -7,6 +7,21 @@
 #include <QString>
 
 class ConnectionManager;
+class IOWorkerPool;
+
+// 监听套接字 - 只取出已接受连接的描述符，由I/O线程在自己的线程中创建socket
+class TCPListener : public QTcpServer
+{
+    Q_OBJECT
+public:
+    using QTcpServer::QTcpServer;
+
+signals:
+    void socketDescriptorReady(qintptr socketDescriptor);
+
+protected:
+    void incomingConnection(qintptr socketDescriptor) override;
+};
 
 // TCP服务器类 - 负责监听端口和接受新连接
 class TCPServer : public QObject
@@ -31,13 +46,17 @@ public:
     
     // 设置连接管理器
     void setConnectionManager(ConnectionManager* manager);
+    
+    // 设置I/O线程池（未设置时连接留在主线程处理）
+    void setWorkerPool(IOWorkerPool* pool);
 
 private slots:
-    void onNewConnection();
+    void onNewConnection(qintptr socketDescriptor);
 
 private:
-    QTcpServer server_;
+    TCPListener server_;
     ConnectionManager* connectionManager_;
+    IOWorkerPool* workerPool_;
     
     void setupConnections();
 };
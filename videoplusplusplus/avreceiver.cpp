@@ -14,6 +14,9 @@ AVReceiver::AVReceiver(QLabel* videoDisplayLabel, QObject* parent)
     : QObject(parent)
     , m_videoDisplayLabel(videoDisplayLabel)
     , m_audioPlayer(new AudioPlayer(this))
+    , m_recorder(nullptr)
+    , m_videoWorker(new FrameDecodeWorker(StreamType::REMOTE_VIDEO, "远程用户视频", this))
+    , m_screenWorker(new FrameDecodeWorker(StreamType::REMOTE_SCREEN, "远程屏幕共享", this))
     , m_isReceiving(false)
     , m_audioEnabled(true)
     , m_videoEnabled(true)
@@ -30,10 +33,24 @@ AVReceiver::AVReceiver(QLabel* videoDisplayLabel, QObject* parent)
     m_displayTimer = new QTimer(this);
     m_displayTimer->setInterval(1000); // 1秒更新一次显示
     connect(m_displayTimer, &QTimer::timeout, this, &AVReceiver::updateDisplay);
+
+    // 解码线程发出的通知排队到界面线程，界面线程只取最新一帧显示
+    connect(m_videoWorker, &FrameDecodeWorker::frameReady, this, &AVReceiver::onVideoFrameDecoded);
+    connect(m_screenWorker, &FrameDecodeWorker::frameReady, this, &AVReceiver::onScreenFrameDecoded);
+    m_videoWorker->start();
+    m_screenWorker->start();
 }
 
 AVReceiver::~AVReceiver() {
     stopReceiving();
+    m_videoWorker->stop();
+    m_screenWorker->stop();
+}
+
+void AVReceiver::setRecorder(VideoRecorder* recorder) {
+    m_recorder = recorder;
+    m_videoWorker->setRecorder(recorder);
+    m_screenWorker->setRecorder(recorder);
 }
 
 void AVReceiver::startReceiving(uint32_t roomId) {
@@ -51,6 +68,9 @@ void AVReceiver::startReceiving(uint32_t roomId) {
     m_lastStatsUpdateTime = QDateTime::currentMSecsSinceEpoch();
     m_lastVideoFrameCount = 0;
     m_lastScreenFrameCount = 0;
+    m_videoWorker->reset();
+    m_screenWorker->reset();
+    m_lastFrame = QImage();
 
     m_displayTimer->start();
 
@@ -73,8 +93,9 @@ void AVReceiver::stopReceiving() {
     m_displayTimer->stop();
     m_audioPlayer->stopPlayback();
 
-    QMutexLocker locker(&m_queueMutex);
-    m_videoFrameQueue.clear();
+    m_videoWorker->reset();
+    m_screenWorker->reset();
+    m_lastFrame = QImage();
 
     if (m_videoDisplayLabel) {
         m_videoDisplayLabel->setText("音视频流已停止");
@@ -156,6 +177,23 @@ void AVReceiver::processReceivedData(const QByteArray& data) {
     }
 }
 
+FrameDecodeJob AVReceiver::makeDecodeJob(const QJsonObject& jsonData, const QByteArray& binaryData,
+                                         uint32_t roomId, uint64_t timestamp, int width, int height,
+                                         const std::string& format) const {
+    FrameDecodeJob job;
+    job.data = binaryData;
+    ProtocolPackager::parseVideoCodecInfo(jsonData, job.codec, job.keyFrame);
+    job.anyImageFormat = (job.codec == VideoCodec::JPEG && format != "jpeg" && format != "jpg");
+    job.frameSize = QSize(width, height);
+    // 控件大小只能在界面线程读取，随任务带给解码线程
+    if (m_videoDisplayLabel) {
+        job.displaySize = m_videoDisplayLabel->size();
+    }
+    job.roomId = roomId;
+    job.timestamp = timestamp;
+    return job;
+}
+
 void AVReceiver::processVideoFrame(const QJsonObject& jsonData, const QByteArray& binaryData) {
     uint32_t roomId;
     uint64_t timestamp;
@@ -169,37 +207,13 @@ void AVReceiver::processVideoFrame(const QJsonObject& jsonData, const QByteArray
             return;
         }
 
-        QImage frame;
-        if (format == "jpeg" || format == "jpg") {
-            frame.loadFromData(binaryData, "JPEG");
-        } else {
-            frame.loadFromData(binaryData);
+        if (fps > 0) {
+            m_videoFps = fps;
         }
+        m_receivedVideoFrameCount++;
 
-        if (!frame.isNull()) {
-            QMutexLocker locker(&m_queueMutex);
-
-            if (fps > 0) {
-                m_videoFps = fps;
-            }
-
-            m_videoFrameQueue.enqueue(frame);
-            m_receivedVideoFrameCount++;
-
-            if (m_videoFrameQueue.size() > m_videoFps * 2) {
-                m_videoFrameQueue.dequeue();
-            }
-
-            displayFrame(frame);
-            emit videoFrameReceived(frame);
-
-            if (m_recorder && m_recorder->isRecording()) {
-                m_recorder->recordVideoFrame(frame, roomId, timestamp);
-            }
-            if (m_recorder && m_recorder->isRecording()) {
-                        m_recorder->recordRemoteVideoFrame(frame, roomId, timestamp, "远程用户视频", false);
-                    }
-        }
+        // 解码、缩放和录制都在解码线程完成
+        m_videoWorker->submit(makeDecodeJob(jsonData, binaryData, roomId, timestamp, width, height, format));
     }
 }
 
@@ -238,56 +252,28 @@ void AVReceiver::processScreenFrame(const QJsonObject& jsonData, const QByteArra
             return;
         }
 
-        QImage frame;
-        if (format == "jpeg" || format == "jpg") {
-            frame.loadFromData(binaryData, "JPEG");
-        } else {
-            frame.loadFromData(binaryData);
+        if (fps > 0) {
+            m_videoFps = fps;
         }
+        m_receivedScreenFrameCount++;
 
-        if (!frame.isNull()) {
-            QMutexLocker locker(&m_queueMutex);
-
-            if (fps > 0) {
-                m_videoFps = fps;
-            }
-
-            // 在屏幕上添加屏幕共享标识
-            QPainter painter(&frame);
-            painter.setPen(Qt::red);
-            painter.setFont(QFont("Arial", 16));
-            painter.drawText(10, 30, "屏幕共享");
-
-            // 添加模式信息
-            QString modeText;
-            switch (mode) {
-            case ScreenCaptureMode::FULL_SCREEN:
-                modeText = "全屏";
-                break;
-            case ScreenCaptureMode::ACTIVE_WINDOW:
-                modeText = "活动窗口";
-                break;
-            case ScreenCaptureMode::SELECTED_AREA:
-                modeText = QString("区域: %1x%2").arg(area.width()).arg(area.height());
-                break;
-            }
-            painter.drawText(10, 60, modeText);
-            painter.end();
-
-            m_videoFrameQueue.enqueue(frame);
-            m_receivedScreenFrameCount++;
-
-            if (m_videoFrameQueue.size() > m_videoFps * 2) {
-                m_videoFrameQueue.dequeue();
-            }
-
-            displayFrame(frame);
-            emit screenFrameReceived(frame);
-            if (m_recorder && m_recorder->isRecording()) {
-                        m_recorder->recordScreenFrame(frame, roomId, timestamp, mode);
-                    }
+        FrameDecodeJob job = makeDecodeJob(jsonData, binaryData, roomId, timestamp, width, height, format);
 
+        // 屏幕共享标识和模式信息，由解码线程绘制在缩放后的画面上（录制内容不含标识）
+        job.overlay << "屏幕共享";
+        switch (mode) {
+        case ScreenCaptureMode::FULL_SCREEN:
+            job.overlay << "全屏";
+            break;
+        case ScreenCaptureMode::ACTIVE_WINDOW:
+            job.overlay << "活动窗口";
+            break;
+        case ScreenCaptureMode::SELECTED_AREA:
+            job.overlay << QString("区域: %1x%2").arg(area.width()).arg(area.height());
+            break;
         }
+
+        m_screenWorker->submit(job);
     }
 }
 
@@ -319,16 +305,40 @@ void AVReceiver::processTextMessage(const QJsonObject& jsonData, MsgType type) {
     }
 }
 
-void AVReceiver::displayFrame(const QImage& frame) {
-    if (!m_videoDisplayLabel || frame.isNull()) {
+void AVReceiver::onVideoFrameDecoded() {
+    DecodedFrame frame;
+    if (!m_videoWorker->takeLatest(frame) || !m_isReceiving || !m_videoEnabled) {
         return;
     }
 
-    QImage scaledFrame = frame.scaled(m_videoDisplayLabel->size(),
-                                    Qt::KeepAspectRatio,
-                                    Qt::SmoothTransformation);
+    m_lastFrame = frame.image;
+    m_lastSourceSize = frame.sourceSize;
+    displayFrame(m_lastFrame, m_lastSourceSize);
+    emit videoFrameReceived(frame.image);
+}
+
+void AVReceiver::onScreenFrameDecoded() {
+    DecodedFrame frame;
+    if (!m_screenWorker->takeLatest(frame) || !m_isReceiving || !m_videoEnabled) {
+        return;
+    }
+
+    m_lastFrame = frame.image;
+    m_lastSourceSize = frame.sourceSize;
+    displayFrame(m_lastFrame, m_lastSourceSize);
+    emit screenFrameReceived(frame.image);
+}
+
+void AVReceiver::displayFrame(const QImage& frame, const QSize& sourceSize) {
+    if (!m_videoDisplayLabel || frame.isNull()) {
+        return;
+    }
 
-    QPixmap pixmap = QPixmap::fromImage(scaledFrame);
+    // 画面已按提交时的控件大小缩放，只有控件大小随后变化时才需要再缩放
+    const QSize target = frame.size().scaled(m_videoDisplayLabel->size(), Qt::KeepAspectRatio);
+    QPixmap pixmap = QPixmap::fromImage(frame.size() == target || target.isEmpty()
+                                        ? frame
+                                        : frame.scaled(target, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
 
     // 在图像上绘制统计信息
     QPainter painter(&pixmap);
@@ -344,8 +354,8 @@ void AVReceiver::displayFrame(const QImage& frame) {
                   .arg(m_receivedVideoFrameCount + m_receivedScreenFrameCount)
                   .arg(m_receivedAudioFrameCount)
                   .arg(m_receivedTextMessageCount)
-                  .arg(frame.width())
-                  .arg(frame.height());
+                  .arg(sourceSize.width())
+                  .arg(sourceSize.height());
 
     painter.drawText(10, 20, info);
     painter.end();
@@ -354,9 +364,9 @@ void AVReceiver::displayFrame(const QImage& frame) {
 }
 
 void AVReceiver::updateDisplay() {
-    QMutexLocker locker(&m_queueMutex);
-    if (!m_videoFrameQueue.isEmpty()) {
-        displayFrame(m_videoFrameQueue.last());
+    // 只刷新统计信息，画面复用最近一次的缩放结果
+    if (!m_lastFrame.isNull()) {
+        displayFrame(m_lastFrame, m_lastSourceSize);
     }
 
     // 更新统计信息
@@ -9,12 +9,11 @@
 #include <QObject>
 #include <QLabel>
 #include <QTimer>
-#include <QQueue>
-#include <QMutex>
 #include <QImage>
 #include "protocol.h"
 #include "audioplayer.h"
 #include "videorecorder.h"
+#include "framedecoder.h"
 
 class AVReceiver : public QObject
 {
@@ -39,12 +38,14 @@ public:
     // 视频控制
     void setVideoEnabled(bool enabled);
     bool isVideoEnabled() const { return m_videoEnabled; }
-    void setRecorder(VideoRecorder* recorder) { m_recorder = recorder; }
+    // 解码线程使用录制器；返回后解码线程不再访问旧录制器。
+    // 销毁录制器前须先 setRecorder(nullptr)，或保证录制器比接收端存活更久
+    void setRecorder(VideoRecorder* recorder);
     VideoRecorder* recorder() const { return m_recorder; }
 
 
 signals:
-    // 视频相关信号
+    // 视频相关信号，画面已缩放到显示大小
     void videoFrameReceived(const QImage& frame);
     void screenFrameReceived(const QImage& frame);
 
@@ -63,6 +64,8 @@ signals:
 
 private slots:
     void updateDisplay();
+    void onVideoFrameDecoded();
+    void onScreenFrameDecoded();
 
 private:
     // 显示控件
@@ -76,9 +79,13 @@ private:
 
     VideoRecorder* m_recorder;
 
-    // 视频帧队列
-    QQueue<QImage> m_videoFrameQueue;
-    QMutex m_queueMutex;
+    // 解码线程，摄像头和屏幕共享各一个，各自保存帧间参考
+    FrameDecodeWorker* m_videoWorker;
+    FrameDecodeWorker* m_screenWorker;
+
+    // 最近一次显示的画面（已缩放），定时刷新统计信息时复用
+    QImage m_lastFrame;
+    QSize m_lastSourceSize;
 
     // 状态标志
     bool m_isReceiving;
@@ -100,7 +107,10 @@ private:
     int m_lastScreenFrameCount;
 
     // 私有方法
-    void displayFrame(const QImage& frame);
+    void displayFrame(const QImage& frame, const QSize& sourceSize);
+    FrameDecodeJob makeDecodeJob(const QJsonObject& jsonData, const QByteArray& binaryData,
+                                 uint32_t roomId, uint64_t timestamp, int width, int height,
+                                 const std::string& format) const;
     void processVideoFrame(const QJsonObject& jsonData, const QByteArray& binaryData);
     void processAudioFrame(const QJsonObject& jsonData, const QByteArray& binaryData);
     void processScreenFrame(const QJsonObject& jsonData, const QByteArray& binaryData);
@@ -4,7 +4,6 @@
 // ===============================================
 
 #include "avsender.h"
-#include <QBuffer>
 #include <QDateTime>
 #include <QDebug>
 
@@ -14,6 +13,8 @@ AVSender::AVSender(QObject* parent)
     , m_imageCapture(nullptr)
     , m_audioCapture(new AudioCapture(this))
     , m_screenCapture(new ScreenCapture(this))
+    , m_videoEncoder(VideoCodecFactory::createEncoder(VideoCodec::TILE_DELTA))
+    , m_keyFrameInterval(0)
     , m_isStreaming(false)
     , m_isScreenSharing(false)
     , m_roomId(0)
@@ -31,6 +32,7 @@ AVSender::AVSender(QObject* parent)
     connect(m_audioCapture, &AudioCapture::errorOccurred, this, &AVSender::onAudioError);
 
     connect(m_screenCapture, &ScreenCapture::screenFramePackaged, this, &AVSender::onScreenFramePackaged);
+    connect(m_screenCapture, &ScreenCapture::screenFrameEncoded, this, &AVSender::onScreenFrameEncoded);
     connect(m_screenCapture, &ScreenCapture::errorOccurred, this, &AVSender::onScreenError);
     connect(m_screenCapture, &ScreenCapture::fpsChanged, this, &AVSender::screenFpsChanged);
 }
@@ -55,10 +57,27 @@ void AVSender::setVideoFps(int fps) {
         if (m_isStreaming) {
             m_videoTimer->setInterval(1000 / m_videoFps);
         }
+        // 未指定关键帧间隔时约每4秒一个关键帧
+        if (m_keyFrameInterval <= 0) {
+            m_videoEncoder->setKeyFrameInterval(m_videoFps * 4);
+        }
         emit videoFpsChanged(m_videoFps);
     }
 }
 
+void AVSender::setVideoCodec(VideoCodec codec) {
+    if (m_videoEncoder->codec() == codec) {
+        return;
+    }
+    m_videoEncoder.reset(VideoCodecFactory::createEncoder(codec));
+    m_videoEncoder->setKeyFrameInterval(m_keyFrameInterval > 0 ? m_keyFrameInterval : m_videoFps * 4);
+}
+
+void AVSender::setKeyFrameInterval(int frames) {
+    m_keyFrameInterval = frames;
+    m_videoEncoder->setKeyFrameInterval(m_keyFrameInterval > 0 ? m_keyFrameInterval : m_videoFps * 4);
+}
+
 void AVSender::setAudioSampleRate(int sampleRate) {
     if (sampleRate >= 8000 && sampleRate <= 48000) {
         m_audioSampleRate = sampleRate;
@@ -102,6 +121,10 @@ bool AVSender::startStreaming(uint32_t roomId, int videoFps, int audioSampleRate
     m_lastFpsTime = QDateTime::currentMSecsSinceEpoch();
     m_actualVideoFps = 0;
 
+    // 新推流从关键帧开始
+    m_videoEncoder->setKeyFrameInterval(m_keyFrameInterval > 0 ? m_keyFrameInterval : m_videoFps * 4);
+    m_videoEncoder->requestKeyFrame();
+
     // 启动视频捕获
     m_videoTimer->setInterval(1000 / m_videoFps);
     m_videoTimer->start();
@@ -154,28 +177,32 @@ void AVSender::onImageCaptured(int id, const QImage& image) {
     }
     m_videoFrameCounter++;
 
-    // 打包视频帧
-    QByteArray frameData;
-    QBuffer buffer(&frameData);
-    buffer.open(QIODevice::WriteOnly);
-    image.save(&buffer, "JPEG", 80);
+    // 编码并打包视频帧
+    EncodedVideoFrame encoded;
+    if (!m_videoEncoder->encode(image, encoded)) {
+        emit errorOccurred("视频编码失败");
+        return;
+    }
 
     QByteArray packet = ProtocolPackager::packVideoFrame(
         m_roomId,
-        frameData,
+        encoded.data,
         currentTime,
-        image.width(),
-        image.height(),
-        "jpeg",
-        m_actualVideoFps
+        encoded.width,
+        encoded.height,
+        m_videoEncoder->formatName(),
+        m_actualVideoFps,
+        m_videoEncoder->codec(),
+        encoded.keyFrame
     );
 
-
-
     emit dataPackaged(packet);
 
-    // 录制本地视频帧
-    if (m_recorder && m_recorder->isRecording()) {
+    // 录制本地视频帧：直接写入刚编码的数据，该流还没有参考帧时才用原图补一帧JPEG
+    if (m_recorder && m_recorder->isRecording()
+        && !m_recorder->recordEncodedVideoFrame(encoded.data, m_videoEncoder->codec(), encoded.keyFrame,
+                                                QSize(encoded.width, encoded.height), m_roomId, currentTime,
+                                                StreamType::LOCAL_VIDEO)) {
         m_recorder->recordLocalVideoFrame(image, m_roomId, currentTime, false);
     }
 }
@@ -227,22 +254,16 @@ void AVSender::updateScreenConfig(const ScreenCaptureConfig& config) {
 void AVSender::onScreenFramePackaged(const QByteArray& packet) {
     if (m_isScreenSharing) {
         emit dataPackaged(packet);
+    }
+}
 
-        // 解析包以获取图像数据用于录制
-        MsgType type;
-        QJsonObject jsonData;
-        QByteArray binaryData;
-
-        if (ProtocolPackager::unpackMessage(packet, type, jsonData, binaryData)) {
-            if (type == MsgType::SCREEN_FRAME && m_recorder && m_recorder->isRecording()) {
-                QImage frame;
-                if (frame.loadFromData(binaryData, "JPEG")) {
-                    uint64_t timestamp = jsonData["ts"].toVariant().toULongLong();
-                    uint32_t roomId = static_cast<uint32_t>(jsonData["roomId"].toInt());
-                    m_recorder->recordLocalVideoFrame(frame, roomId, timestamp, true);
-                }
-            }
-        }
+void AVSender::onScreenFrameEncoded(const QImage& frame, const EncodedVideoFrame& encoded, uint64_t timestamp) {
+    // 录制屏幕帧：写入差分数据本身，无需解码或重新编码
+    if (m_isScreenSharing && m_recorder && m_recorder->isRecording()
+        && !m_recorder->recordEncodedVideoFrame(encoded.data, VideoCodec::TILE_DELTA, encoded.keyFrame,
+                                                QSize(encoded.width, encoded.height), m_roomId, timestamp,
+                                                StreamType::LOCAL_SCREEN)) {
+        m_recorder->recordLocalVideoFrame(frame, m_roomId, timestamp, true);
     }
 }
 
@@ -9,7 +9,9 @@
 #include <QTimer>
 #include <QCamera>
 #include <QCameraImageCapture>
+#include <memory>
 #include "protocol.h"
+#include "videocodec.h"
 #include "audiocapture.h"
 #include "screencapture.h"
 #include "videorecorder.h"
@@ -32,6 +34,12 @@ public:
     void setVideoFps(int fps);
     void setAudioSampleRate(int sampleRate);
     void updateScreenConfig(const ScreenCaptureConfig& config);
+
+    // 视频编码设置
+    void setVideoCodec(VideoCodec codec);
+    VideoCodec videoCodec() const { return m_videoEncoder->codec(); }
+    void setKeyFrameInterval(int frames);
+    void requestKeyFrame() { m_videoEncoder->requestKeyFrame(); }
     void setRecorder(VideoRecorder* recorder) { m_recorder = recorder; }
     VideoRecorder* recorder() const { return m_recorder; }
 
@@ -49,6 +57,7 @@ private slots:
     void onImageCaptured(int id, const QImage& image);
     void onAudioPackaged(const QByteArray& packet);
     void onScreenFramePackaged(const QByteArray& packet);
+    void onScreenFrameEncoded(const QImage& frame, const EncodedVideoFrame& encoded, uint64_t timestamp);
     void captureVideoFrame();
     void onAudioError(const QString& error);
     void onScreenError(const QString& error);
@@ -58,6 +67,8 @@ private:
     QCameraImageCapture* m_imageCapture;
     AudioCapture* m_audioCapture;
     ScreenCapture* m_screenCapture;
+    std::unique_ptr<VideoEncoder> m_videoEncoder;
+    int m_keyFrameInterval;
     VideoRecorder* m_recorder;
     QTimer* m_videoTimer;
     bool m_isStreaming;
@@ -0,0 +1,287 @@
+// ===============================================
+// receiver/frame_decoder.cpp
+// 接收端视频解码线程实现
+// ===============================================
+
+#include "framedecoder.h"
+#include <QBuffer>
+#include <QImageReader>
+#include <QPainter>
+#include <QFont>
+#include <QDebug>
+
+FrameDecodeWorker::FrameDecodeWorker(StreamType streamType, const QString& streamName, QObject* parent)
+    : QThread(parent)
+    , m_streamType(streamType)
+    , m_streamName(streamName)
+    , m_recorder(nullptr)
+    , m_busy(false)
+    , m_stopping(false)
+    , m_resetPending(false)
+    , m_hasLatest(false)
+    , m_notified(false)
+    , m_skipped(0)
+{
+    setObjectName("frame-decoder");
+}
+
+FrameDecodeWorker::~FrameDecodeWorker() {
+    stop();
+}
+
+void FrameDecodeWorker::setRecorder(VideoRecorder* recorder) {
+    m_recorder.store(recorder);
+
+    // 替换后开始的批次只会读到新指针，等当前批次结束即可
+    QMutexLocker locker(&m_mutex);
+    while (m_busy) {
+        m_batchDone.wait(&m_mutex);
+    }
+}
+
+void FrameDecodeWorker::submit(const FrameDecodeJob& job) {
+    QMutexLocker locker(&m_mutex);
+    if (m_stopping) {
+        return;
+    }
+    m_jobs.enqueue(job);
+    m_notEmpty.wakeOne();
+}
+
+void FrameDecodeWorker::reset() {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_jobs.clear();
+        // 参考画面只在解码线程访问，下一批开始前丢弃
+        m_resetPending = true;
+    }
+
+    QMutexLocker locker(&m_latestMutex);
+    m_latest = DecodedFrame();
+    m_hasLatest = false;
+}
+
+bool FrameDecodeWorker::takeLatest(DecodedFrame& frame) {
+    QMutexLocker locker(&m_latestMutex);
+    m_notified.store(false);
+    if (!m_hasLatest) {
+        return false;
+    }
+
+    frame = m_latest;
+    m_latest = DecodedFrame();
+    m_hasLatest = false;
+    return true;
+}
+
+void FrameDecodeWorker::stop() {
+    if (isRunning()) {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_stopping = true;
+            m_notEmpty.wakeOne();
+        }
+        wait();
+    }
+}
+
+void FrameDecodeWorker::run() {
+    for (;;) {
+        QQueue<FrameDecodeJob> batch;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_jobs.isEmpty() && !m_stopping) {
+                m_notEmpty.wait(&m_mutex);
+            }
+            if (m_stopping) {
+                break;
+            }
+            if (m_resetPending) {
+                m_decoder.reset();
+                m_canvas = QImage();
+                m_resetPending = false;
+            }
+            batch.swap(m_jobs);
+            m_busy = true;
+        }
+
+        // 最后一个不依赖前帧的帧（JPEG或关键帧）之前的帧不必解码，只录制
+        int firstDecoded = 0;
+        for (int i = batch.size() - 1; i >= 0; --i) {
+            if (batch[i].codec == VideoCodec::JPEG || batch[i].keyFrame) {
+                firstDecoded = i;
+                break;
+            }
+        }
+
+        for (int i = 0; i < batch.size(); ++i) {
+            const FrameDecodeJob& job = batch[i];
+            const bool last = (i == batch.size() - 1);
+
+            if (i < firstDecoded) {
+                recordFrame(job, false);
+                m_skipped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // JPEG帧不作为后续帧的参考，显示时直接按目标大小解码
+            if (last && job.codec == VideoCodec::JPEG && !job.anyImageFormat) {
+                DecodedFrame frame;
+                if (!decodeScaledJpeg(job, frame)) {
+                    recordFrame(job, false);
+                    continue;
+                }
+                FrameDecodeJob recorded = job;
+                if (!recorded.frameSize.isValid()) {
+                    recorded.frameSize = frame.sourceSize;
+                }
+                recordFrame(recorded, false);
+                publish(frame);
+                continue;
+            }
+
+            const bool decoded = decodeFrame(job);
+            recordFrame(job, decoded);
+            if (!decoded) {
+                continue;
+            }
+
+            if (last) {
+                DecodedFrame frame;
+                present(job, frame);
+                publish(frame);
+            } else {
+                m_skipped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        QMutexLocker locker(&m_mutex);
+        m_busy = false;
+        m_batchDone.wakeAll();
+    }
+}
+
+bool FrameDecodeWorker::decodeFrame(const FrameDecodeJob& job) {
+    QImage frame;
+    if (job.codec == VideoCodec::JPEG && job.anyImageFormat) {
+        if (!frame.loadFromData(job.data)) {
+            return false;
+        }
+        m_canvas = frame;
+        return true;
+    }
+
+    if (!m_decoder || m_decoder->codec() != job.codec) {
+        m_decoder.reset(VideoCodecFactory::createDecoder(job.codec));
+        if (!m_decoder) {
+            qDebug() << "Unsupported video codec:" << static_cast<int>(job.codec);
+            return false;
+        }
+    }
+
+    // 先释放对解码器画布的引用，差分块写入画布时就不必整幅拷贝
+    m_canvas = QImage();
+
+    // 中途加入或丢帧时差分帧缺少参考，等待下一个关键帧
+    if (!m_decoder->decode(job.data, job.keyFrame, frame)) {
+        return false;
+    }
+    m_canvas = frame;
+    return true;
+}
+
+bool FrameDecodeWorker::decodeScaledJpeg(const FrameDecodeJob& job, DecodedFrame& frame) {
+    QBuffer buffer;
+    buffer.setData(job.data);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer, "JPEG");
+    const QSize source = reader.size();
+    if (!source.isValid()) {
+        return false;
+    }
+
+    const QSize target = job.displaySize.isEmpty()
+                       ? source : source.scaled(job.displaySize, Qt::KeepAspectRatio);
+    // 缩小时由JPEG解码器在DCT阶段按1/2、1/4、1/8降采样，再平滑缩放余下部分
+    if (target.width() < source.width()) {
+        reader.setScaledSize(target);
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return false;
+    }
+    if (image.size() != target) {
+        image = image.scaled(target, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    frame.image = image;
+    frame.sourceSize = source;
+    frame.roomId = job.roomId;
+    frame.timestamp = job.timestamp;
+    drawOverlay(job.overlay, frame.image);
+    return true;
+}
+
+void FrameDecodeWorker::recordFrame(const FrameDecodeJob& job, bool decoded) {
+    VideoRecorder* recorder = m_recorder.load();
+    if (!recorder || !recorder->isRecording()) {
+        return;
+    }
+
+    const QSize size = job.frameSize.isValid() ? job.frameSize : m_canvas.size();
+    // 录制中途开始时先用已解码的全尺寸画面补一帧JPEG作为参考
+    if (!recorder->recordEncodedVideoFrame(job.data, job.codec, job.keyFrame, size, job.roomId, job.timestamp,
+                                           m_streamType, m_streamName)
+        && decoded) {
+        recorder->recordRemoteVideoFrame(m_canvas, job.roomId, job.timestamp, m_streamName,
+                                         m_streamType == StreamType::REMOTE_SCREEN);
+    }
+}
+
+void FrameDecodeWorker::present(const FrameDecodeJob& job, DecodedFrame& frame) {
+    frame.sourceSize = m_canvas.size();
+    frame.roomId = job.roomId;
+    frame.timestamp = job.timestamp;
+    frame.image = job.displaySize.isEmpty()
+                ? m_canvas
+                : m_canvas.scaled(job.displaySize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    drawOverlay(job.overlay, frame.image);
+}
+
+void FrameDecodeWorker::drawOverlay(const QStringList& lines, QImage& image) {
+    if (lines.isEmpty()) {
+        return;
+    }
+
+    // 未缩放时画面与参考画面共享，绘制前会自动分离
+    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32) {
+        image = image.convertToFormat(QImage::Format_RGB32);
+    }
+
+    QPainter painter(&image);
+    painter.setPen(Qt::red);
+    painter.setFont(QFont("Arial", 16));
+    int y = 30;
+    for (const QString& line : lines) {
+        painter.drawText(10, y, line);
+        y += 30;
+    }
+    painter.end();
+}
+
+void FrameDecodeWorker::publish(const DecodedFrame& frame) {
+    {
+        QMutexLocker locker(&m_latestMutex);
+        if (m_hasLatest) {
+            m_skipped.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_latest = frame;
+        m_hasLatest = true;
+    }
+
+    if (!m_notified.exchange(true)) {
+        emit frameReady();
+    }
+}
@@ -0,0 +1,108 @@
+// ===============================================
+// receiver/frame_decoder.h
+// 接收端视频解码线程
+// ===============================================
+
+#pragma once
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QByteArray>
+#include <QImage>
+#include <QSize>
+#include <QStringList>
+#include <atomic>
+#include <memory>
+#include "videocodec.h"
+#include "videorecorder.h"
+
+// 一帧收到的编码数据及其显示参数
+struct FrameDecodeJob {
+    QByteArray data;
+    VideoCodec codec = VideoCodec::JPEG;
+    bool keyFrame = true;
+    bool anyImageFormat = false;    // 帧头格式不是JPEG时按内容识别图片格式
+    QSize frameSize;                // 帧头中的原始分辨率，录制用
+    QSize displaySize;              // 提交时显示控件的大小
+    QStringList overlay;            // 缩放后在左上角绘制的标识文字
+    uint32_t roomId = 0;
+    uint64_t timestamp = 0;
+};
+
+// 解码结果，画面已缩放到显示大小
+struct DecodedFrame {
+    QImage image;
+    QSize sourceSize;
+    uint32_t roomId = 0;
+    uint64_t timestamp = 0;
+};
+
+// 接收端解码线程，每一路流一个
+// 界面线程只把编码数据放入队列；解码、缩放、绘制标识和录制都在本线程完成，
+// 只保留最新一帧等界面线程取走，界面来不及刷新时中间帧直接跳过。
+class FrameDecodeWorker : public QThread {
+    Q_OBJECT
+
+public:
+    explicit FrameDecodeWorker(StreamType streamType, const QString& streamName, QObject* parent = nullptr);
+    ~FrameDecodeWorker();
+
+    // 录制器由界面线程设置，录制在本线程按解码顺序写入。
+    // 返回前等待正在处理的一批帧完成，之后本线程不再访问旧录制器，调用方可以安全销毁它
+    void setRecorder(VideoRecorder* recorder);
+
+    // 界面线程调用
+    void submit(const FrameDecodeJob& job);
+
+    // 丢弃排队的帧、参考画面和未取走的结果，用于重新开始接收
+    void reset();
+
+    // 取走最新的结果；没有新结果时返回false
+    bool takeLatest(DecodedFrame& frame);
+
+    // 显示前被新帧覆盖而跳过的帧数
+    quint64 skippedCount() const { return m_skipped.load(std::memory_order_relaxed); }
+
+    void stop();
+
+signals:
+    // 上一次通知的结果被取走之前不会再次发出，界面线程的事件队列不会堆积
+    void frameReady();
+
+protected:
+    void run() override;
+
+private:
+    // 解码一帧到 m_canvas；m_canvas 与解码器画布共享，解码前先释放，失败后为空
+    bool decodeFrame(const FrameDecodeJob& job);
+    // 直接按显示大小读取JPEG，利用解码器的DCT缩放，不生成全尺寸画面
+    bool decodeScaledJpeg(const FrameDecodeJob& job, DecodedFrame& frame);
+    void recordFrame(const FrameDecodeJob& job, bool decoded);
+    void present(const FrameDecodeJob& job, DecodedFrame& frame);
+    static void drawOverlay(const QStringList& lines, QImage& image);
+    void publish(const DecodedFrame& frame);
+
+    const StreamType m_streamType;
+    const QString m_streamName;
+    std::atomic<VideoRecorder*> m_recorder;
+
+    QMutex m_mutex;
+    QWaitCondition m_notEmpty;
+    QWaitCondition m_batchDone;
+    QQueue<FrameDecodeJob> m_jobs;
+    bool m_busy;            // 正在处理一批帧，期间可能持有旧的录制器指针
+    bool m_stopping;
+    bool m_resetPending;
+
+    // 仅解码线程访问
+    std::unique_ptr<VideoDecoder> m_decoder;
+    QImage m_canvas;
+
+    QMutex m_latestMutex;
+    DecodedFrame m_latest;
+    bool m_hasLatest;
+    std::atomic<bool> m_notified;
+    std::atomic<quint64> m_skipped;
+};
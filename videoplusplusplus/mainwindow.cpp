@@ -106,6 +106,8 @@ MainWindow::~MainWindow()
     onStopCamera();
     onStopScreenSharing();
     onStopReceiver();
+    // 录制器先于接收端析构，先等解码线程放下录制器
+    m_avReceiver->setRecorder(nullptr);
     delete ui;
 }
 
@@ -33,7 +33,9 @@ QByteArray ProtocolPackager::packVideoFrame(uint32_t roomId,
                                           int width,
                                           int height,
                                           const std::string& format,
-                                          int fps) {
+                                          int fps,
+                                          VideoCodec codec,
+                                          bool keyFrame) {
     QJsonObject jsonObj;
     jsonObj["roomId"] = static_cast<int>(roomId);
     jsonObj["ts"] = static_cast<qint64>(timestamp > 0 ? timestamp : QDateTime::currentMSecsSinceEpoch());
@@ -42,6 +44,8 @@ QByteArray ProtocolPackager::packVideoFrame(uint32_t roomId,
     jsonObj["format"] = QString::fromStdString(format);
     jsonObj["frameSize"] = static_cast<int>(frameData.size());
     jsonObj["fps"] = fps;
+    jsonObj["codec"] = static_cast<int>(codec);
+    jsonObj["keyFrame"] = keyFrame;
     jsonObj["type"] = "video";
 
     return packMessage(MsgType::VIDEO_FRAME, jsonObj, frameData);
@@ -255,7 +259,9 @@ QByteArray ProtocolPackager::packScreenFrame(uint32_t roomId,
                                            const std::string& format,
                                            int fps,
                                            ScreenCaptureMode mode,
-                                           const QRect& area) {
+                                           const QRect& area,
+                                           VideoCodec codec,
+                                           bool keyFrame) {
     QJsonObject jsonObj;
     jsonObj["roomId"] = static_cast<int>(roomId);
     jsonObj["ts"] = static_cast<qint64>(timestamp > 0 ? timestamp : QDateTime::currentMSecsSinceEpoch());
@@ -266,6 +272,8 @@ QByteArray ProtocolPackager::packScreenFrame(uint32_t roomId,
     jsonObj["fps"] = fps;
     jsonObj["type"] = "screen";
     jsonObj["mode"] = static_cast<int>(mode);
+    jsonObj["codec"] = static_cast<int>(codec);
+    jsonObj["keyFrame"] = keyFrame;
 
     // 添加区域信息
     if (mode == ScreenCaptureMode::SELECTED_AREA && !area.isNull()) {
@@ -340,6 +348,20 @@ bool ProtocolPackager::parseVideoFrameInfo(const QJsonObject& jsonData,
         return false;
     }
 }
+void ProtocolPackager::parseVideoCodecInfo(const QJsonObject& jsonData,
+                                         VideoCodec& codec,
+                                         bool& keyFrame) {
+    codec = VideoCodec::JPEG;
+    if (jsonData.contains("codec") && jsonData["codec"].isDouble()) {
+        codec = static_cast<VideoCodec>(jsonData["codec"].toInt());
+    }
+
+    keyFrame = true;
+    if (jsonData.contains("keyFrame") && jsonData["keyFrame"].isBool()) {
+        keyFrame = jsonData["keyFrame"].toBool();
+    }
+}
+
 bool ProtocolPackager::parseAudioFrameInfo(const QJsonObject& jsonData,
                                          uint32_t& roomId,
                                          uint64_t& timestamp,
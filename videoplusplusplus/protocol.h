@@ -43,6 +43,12 @@ enum class TextMessageType {
     NOTICE = 2          // 通知消息
 };
 
+// 视频编码器标识（随帧头下发，接收端据此选择解码器）
+enum class VideoCodec : uint8_t {
+    JPEG = 0,           // 逐帧JPEG
+    TILE_DELTA = 1      // 分块差分（帧间编码）
+};
+
 // 屏幕捕获模式
 enum class ScreenCaptureMode {
     FULL_SCREEN = 0,    // 全屏捕获
@@ -94,7 +100,9 @@ public:
                                    int width = 0,
                                    int height = 0,
                                    const std::string& format = "jpeg",
-                                   int fps = 0);
+                                   int fps = 0,
+                                   VideoCodec codec = VideoCodec::JPEG,
+                                   bool keyFrame = true);
 
     // 打包屏幕帧消息
     static QByteArray packScreenFrame(uint32_t roomId,
@@ -105,7 +113,9 @@ public:
                                     const std::string& format = "jpeg",
                                     int fps = 0,
                                     ScreenCaptureMode mode = ScreenCaptureMode::FULL_SCREEN,
-                                    const QRect& area = QRect());
+                                    const QRect& area = QRect(),
+                                    VideoCodec codec = VideoCodec::JPEG,
+                                    bool keyFrame = true);
 
     // 打包音频帧消息
     static QByteArray packAudioFrame(uint32_t roomId,
@@ -150,6 +160,11 @@ public:
                                   int& frameSize,
                                   int& fps);
 
+    // 解析视频/屏幕帧编码信息（缺省为JPEG关键帧，兼容旧版本发送端）
+    static void parseVideoCodecInfo(const QJsonObject& jsonData,
+                                  VideoCodec& codec,
+                                  bool& keyFrame);
+
     // 解析屏幕帧信息
     static bool parseScreenFrameInfo(const QJsonObject& jsonData,
                                    uint32_t& roomId,
@@ -0,0 +1,260 @@
+// ===============================================
+// recorder/record_writer.cpp
+// 录制文件写线程实现
+// ===============================================
+
+#include "recordwriter.h"
+#include "videorecorder.h"
+#include <QElapsedTimer>
+#include <QtEndian>
+#include <QDebug>
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+RecordWriter::RecordWriter(const RecordWriterOptions& options, QObject* parent)
+    : QThread(parent)
+    , m_options(options)
+    , m_lastTimestamp(0)
+    , m_queuedBytes(0)
+    , m_stopping(false)
+    , m_failed(false)
+    , m_droppedTotal(0)
+    , m_bytesWritten(0)
+{
+    m_options.bufferSize = qMax(m_options.bufferSize, int(BLOCK_SIZE));
+    setObjectName("record-writer");
+}
+
+RecordWriter::~RecordWriter() {
+    close();
+}
+
+bool RecordWriter::open(const QString& filePath) {
+    if (isRunning()) {
+        return false;
+    }
+
+    // 自带合并缓冲，关闭QFile的内部缓冲避免二次拷贝
+    m_file.setFileName(filePath);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Unbuffered)) {
+        return false;
+    }
+
+    m_queue.clear();
+    m_index.clear();
+    m_lastTimestamp = 0;
+    m_queuedBytes = 0;
+    m_stopping = false;
+    m_errorString.clear();
+    m_failed.store(false, std::memory_order_release);
+    m_droppedTotal.store(0, std::memory_order_relaxed);
+    m_bytesWritten.store(0, std::memory_order_relaxed);
+
+    start();
+    return true;
+}
+
+void RecordWriter::close() {
+    if (isRunning()) {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_stopping = true;
+            m_notEmpty.wakeOne();
+        }
+        wait();
+    }
+
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+}
+
+bool RecordWriter::enqueue(const QByteArray& record, Priority priority, const RecordIndexEntry* index) {
+    QMutexLocker locker(&m_mutex);
+
+    const qint64 byteLimit = priority == Priority::RELIABLE
+                           ? m_options.maxQueuedBytes * 2 : m_options.maxQueuedBytes;
+    const bool full = m_queuedBytes + record.size() > byteLimit
+                   || (priority == Priority::DROPPABLE && m_queue.size() >= m_options.maxQueuedFrames);
+
+    if (m_stopping || hasError() || full) {
+        m_droppedTotal.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    QueuedRecord queued;
+    queued.data = record;
+    queued.indexed = index != nullptr;
+    if (index) {
+        queued.index = *index;
+    }
+    m_queue.enqueue(queued);
+    m_queuedBytes += record.size();
+    m_notEmpty.wakeOne();
+    return true;
+}
+
+int RecordWriter::queueDepth() const {
+    QMutexLocker locker(&m_mutex);
+    return m_queue.size();
+}
+
+QString RecordWriter::errorString() const {
+    QMutexLocker locker(&m_mutex);
+    return m_errorString;
+}
+
+void RecordWriter::run() {
+    QByteArray buffer;
+    buffer.reserve(m_options.bufferSize + BLOCK_SIZE);
+
+    QElapsedTimer sinceFlush;
+    sinceFlush.start();
+    QElapsedTimer sinceSync;
+    sinceSync.start();
+    bool unsynced = false;
+
+    for (;;) {
+        QQueue<QueuedRecord> batch;
+        bool stopping = false;
+        {
+            QMutexLocker locker(&m_mutex);
+            if (m_queue.isEmpty() && !m_stopping) {
+                // 缓冲有数据时最多等到下一次刷新时间点
+                const qint64 timeout = buffer.isEmpty()
+                                     ? m_options.flushIntervalMs
+                                     : qMax<qint64>(1, m_options.flushIntervalMs - sinceFlush.elapsed());
+                m_notEmpty.wait(&m_mutex, static_cast<unsigned long>(timeout));
+            }
+            batch.swap(m_queue);
+            m_queuedBytes = 0;
+            stopping = m_stopping;
+        }
+
+        for (const QueuedRecord& record : batch) {
+            const int start = buffer.size();
+            buffer.append(record.data);
+            if (record.indexed) {
+                // 之前的数据都已进入文件或缓冲，两者之和即本记录的偏移
+                RecordIndexEntry entry = record.index;
+                entry.offset = quint64(m_bytesWritten.load(std::memory_order_relaxed) + start);
+                // 时间戳按写出顺序修正为不递减，改写的是缓冲中的副本，不影响调用方的记录
+                if (entry.timestamp < m_lastTimestamp) {
+                    entry.timestamp = m_lastTimestamp;
+                    qToLittleEndian<quint64>(entry.timestamp,
+                                             reinterpret_cast<uchar*>(buffer.data()) + start + MtrFormat::TIMESTAMP_OFFSET);
+                }
+                m_lastTimestamp = entry.timestamp;
+                m_index.append(entry);
+            }
+            if (buffer.size() >= m_options.bufferSize) {
+                writeBuffer(buffer, false);
+                unsynced = true;
+            }
+        }
+
+        if (!buffer.isEmpty() && (stopping || sinceFlush.elapsed() >= m_options.flushIntervalMs)) {
+            writeBuffer(buffer, true);
+            sinceFlush.restart();
+            unsynced = true;
+        }
+
+        if (m_options.syncIntervalMs > 0 && unsynced && sinceSync.elapsed() >= m_options.syncIntervalMs) {
+            syncToDisk();
+            sinceSync.restart();
+            unsynced = false;
+        }
+
+        if (stopping) {
+            QMutexLocker locker(&m_mutex);
+            if (m_queue.isEmpty()) {
+                break;
+            }
+        }
+    }
+
+    if (!m_index.isEmpty()) {
+        appendIndex(buffer);
+    }
+    writeBuffer(buffer, true);
+    syncToDisk();
+}
+
+void RecordWriter::appendIndex(QByteArray& buffer) {
+    const quint64 indexOffset = quint64(m_bytesWritten.load(std::memory_order_relaxed) + buffer.size());
+    const int start = buffer.size();
+    buffer.resize(start + m_index.size() * MtrFormat::INDEX_ENTRY_SIZE + MtrFormat::FOOTER_SIZE);
+
+    uchar* p = reinterpret_cast<uchar*>(buffer.data()) + start;
+    for (const RecordIndexEntry& entry : m_index) {
+        qToLittleEndian<quint64>(entry.timestamp, p);
+        qToLittleEndian<quint64>(entry.offset, p + 8);
+        qToLittleEndian<quint16>(entry.type, p + 16);
+        qToLittleEndian<quint16>(entry.streamId, p + 18);
+        p[20] = entry.flags;
+        p[21] = p[22] = p[23] = 0;
+        p += MtrFormat::INDEX_ENTRY_SIZE;
+    }
+
+    qToLittleEndian<quint64>(indexOffset, p);
+    qToLittleEndian<quint32>(quint32(m_index.size()), p + 8);
+    qToLittleEndian<quint32>(MtrFormat::FOOTER_MAGIC, p + 12);
+}
+
+bool RecordWriter::writeBuffer(QByteArray& buffer, bool all) {
+    const int length = all ? buffer.size() : buffer.size() / BLOCK_SIZE * BLOCK_SIZE;
+    if (length == 0) {
+        return true;
+    }
+
+    if (hasError()) {
+        buffer.clear();
+        return false;
+    }
+
+    const qint64 written = m_file.write(buffer.constData(), length);
+    if (written != length) {
+        fail("录制文件写入失败: " + m_file.errorString());
+        buffer.clear();
+        return false;
+    }
+
+    m_bytesWritten.fetch_add(written, std::memory_order_relaxed);
+    buffer.remove(0, length);
+    return true;
+}
+
+void RecordWriter::syncToDisk() {
+    if (hasError() || !m_file.isOpen()) {
+        return;
+    }
+
+    const int fd = m_file.handle();
+#if defined(Q_OS_WIN)
+    const int result = _commit(fd);
+#elif defined(Q_OS_MACOS)
+    const int result = ::fsync(fd);
+#else
+    const int result = ::fdatasync(fd);
+#endif
+    if (result != 0) {
+        qWarning() << "Recording sync failed:" << m_file.fileName();
+    }
+}
+
+void RecordWriter::fail(const QString& error) {
+    {
+        QMutexLocker locker(&m_mutex);
+        m_errorString = error;
+        // 出错后不再接收记录，已排队的也一并丢弃
+        m_droppedTotal.fetch_add(m_queue.size(), std::memory_order_relaxed);
+        m_queue.clear();
+        m_queuedBytes = 0;
+    }
+    m_failed.store(true, std::memory_order_release);
+    qWarning() << error;
+}
@@ -0,0 +1,101 @@
+// ===============================================
+// recorder/record_writer.h
+// 录制文件写线程
+// ===============================================
+
+#pragma once
+
+#include <QThread>
+#include <QFile>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QByteArray>
+#include <QVector>
+#include <atomic>
+
+// 写线程参数
+struct RecordWriterOptions {
+    int maxQueuedFrames = 256;                  // 可丢弃记录（视频帧）的排队上限
+    qint64 maxQueuedBytes = 32 * 1024 * 1024;   // 排队字节上限；必须保留的记录可用到两倍
+    int bufferSize = 1024 * 1024;               // 合并写缓冲，按 BLOCK_SIZE 整块写出
+    int flushIntervalMs = 500;                  // 缓冲不满时最长滞留时间
+    int syncIntervalMs = 0;                     // >0 时按该间隔 fdatasync，0 表示交给系统
+};
+
+// 帧索引项；文件偏移由写线程在记录落入缓冲时填写。
+// 各采集线程取的时间戳入队后可能乱序，写线程按写出顺序把时间戳修正为不递减（同时改写记录帧头），
+// 回放按索引二分查找
+struct RecordIndexEntry {
+    quint64 timestamp = 0;
+    quint64 offset = 0;
+    quint16 type = 0;
+    quint16 streamId = 0xFFFF;
+    quint8 flags = 0;
+};
+
+// 录制文件写线程
+// 调用方只把已序列化的整条记录放入有界队列，文件写入、合并和落盘都在本线程完成，
+// 磁盘卡顿时采集线程和界面线程不会被阻塞。
+class RecordWriter : public QThread {
+    Q_OBJECT
+
+public:
+    // 队列满时的处理方式
+    enum class Priority {
+        DROPPABLE,  // 视频帧：超过上限直接丢弃并计数
+        RELIABLE    // 文件头、音频、文字、结束标记：不受帧数上限限制
+    };
+
+    static const int BLOCK_SIZE = 64 * 1024;
+
+    explicit RecordWriter(const RecordWriterOptions& options = RecordWriterOptions(),
+                          QObject* parent = nullptr);
+    ~RecordWriter();
+
+    // 打开文件并启动写线程
+    bool open(const QString& filePath);
+
+    // 写出剩余记录；有索引项时在文件末尾追加索引块和文件尾，落盘并关闭文件
+    void close();
+
+    // 任意线程；记录被丢弃时返回false。index非空时该记录进入帧索引
+    bool enqueue(const QByteArray& record, Priority priority, const RecordIndexEntry* index = nullptr);
+
+    int queueDepth() const;
+    quint64 droppedCount() const { return m_droppedTotal.load(std::memory_order_relaxed); }
+    qint64 bytesWritten() const { return m_bytesWritten.load(std::memory_order_relaxed); }
+    bool hasError() const { return m_failed.load(std::memory_order_acquire); }
+    QString errorString() const;
+
+protected:
+    void run() override;
+
+private:
+    // 写出缓冲中的整块部分；all为true时连同不足一块的尾部一起写出
+    bool writeBuffer(QByteArray& buffer, bool all);
+    void syncToDisk();
+    void appendIndex(QByteArray& buffer);
+    void fail(const QString& error);
+
+    RecordWriterOptions m_options;
+    QFile m_file;
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_notEmpty;
+    struct QueuedRecord {
+        QByteArray data;
+        RecordIndexEntry index;
+        bool indexed;
+    };
+    QQueue<QueuedRecord> m_queue;
+    QVector<RecordIndexEntry> m_index;     // 仅写线程访问
+    quint64 m_lastTimestamp;               // 仅写线程访问
+    qint64 m_queuedBytes;
+    bool m_stopping;
+    QString m_errorString;
+
+    std::atomic<bool> m_failed;
+    std::atomic<quint64> m_droppedTotal;
+    std::atomic<qint64> m_bytesWritten;
+};
@@ -4,7 +4,6 @@
 // ===============================================
 
 #include "screencapture.h"
-#include <QBuffer>
 #include <QDateTime>
 #include <QDebug>
 #include <QApplication>
@@ -21,6 +20,7 @@ ScreenCapture::ScreenCapture(QObject* parent)
     , m_actualFps(0)
     , m_currentScreen(nullptr)
     , m_activeWindow(nullptr)
+    , m_encoder(64, TileDeltaEncoder::ChangeDetection::CHECKSUM)
 {
     m_captureTimer = new QTimer(this);
     m_captureTimer->setSingleShot(false);
@@ -42,6 +42,10 @@ bool ScreenCapture::startCapture(const ScreenCaptureConfig& config) {
     m_lastFpsTime = QDateTime::currentMSecsSinceEpoch();
     m_actualFps = 0;
 
+    // 约每10秒整屏刷新一次，便于中途加入的接收端恢复画面
+    m_encoder.setKeyFrameInterval(m_config.fps * 10);
+    m_encoder.requestKeyFrame();
+
     // 设置捕获定时器
     m_captureTimer->setInterval(1000 / m_config.fps);
     m_captureTimer->start();
@@ -66,6 +70,8 @@ void ScreenCapture::stopCapture() {
 
 void ScreenCapture::updateConfig(const ScreenCaptureConfig& config) {
     m_config = config;
+    m_encoder.setKeyFrameInterval(m_config.fps * 10);
+    m_encoder.requestKeyFrame();
     if (m_isCapturing) {
         m_captureTimer->setInterval(1000 / m_config.fps);
     }
@@ -106,23 +112,35 @@ void ScreenCapture::captureFrame() {
         }
         m_frameCounter++;
 
-        // 转换为JPEG
-        QByteArray frameData;
-        QBuffer buffer(&frameData);
-        buffer.open(QIODevice::WriteOnly);
-        screenshot.save(&buffer, "JPEG", 80);
+        const QImage image = screenshot.toImage();
+
+        // 只编码变化的块
+        EncodedVideoFrame encoded;
+        if (!m_encoder.encode(image, encoded)) {
+            emit errorOccurred("屏幕帧编码失败");
+            return;
+        }
+
+        // 画面无变化时不发送
+        if (!encoded.keyFrame && encoded.data.size() <= TileDeltaFormat::HEADER_SIZE + 4) {
+            return;
+        }
+
+        emit screenFrameEncoded(image, encoded, static_cast<uint64_t>(currentTime));
 
         // 打包屏幕帧
         QByteArray packet = ProtocolPackager::packScreenFrame(
             m_roomId,
-            frameData,
+            encoded.data,
             currentTime,
-            screenshot.width(),
-            screenshot.height(),
-            "jpeg",
+            encoded.width,
+            encoded.height,
+            m_encoder.formatName(),
             m_actualFps,
             m_config.mode,
-            m_config.captureArea
+            m_config.captureArea,
+            m_encoder.codec(),
+            encoded.keyFrame
         );
 
         emit screenFramePackaged(packet);
@@ -13,6 +13,7 @@
 #include <QWindow>
 #include <QPixmap>
 #include "protocol.h"
+#include "videocodec.h"
 
 class ScreenCapture : public QObject {
     Q_OBJECT
@@ -28,8 +29,13 @@ public:
     void setRoomId(uint32_t roomId) { m_roomId = roomId; }
     void updateConfig(const ScreenCaptureConfig& config);
 
+    // 下一帧发送整屏刷新
+    void requestFullRefresh() { m_encoder.requestKeyFrame(); }
+
 signals:
     void screenFramePackaged(const QByteArray& packet);
+    // 编码完成的屏幕帧（画面无变化的帧不发出），供录制直接写入编码数据
+    void screenFrameEncoded(const QImage& frame, const EncodedVideoFrame& encoded, uint64_t timestamp);
     void captureStarted();
     void captureStopped();
     void errorOccurred(const QString& error);
@@ -49,6 +55,9 @@ private:
     QScreen* m_currentScreen;
     QWindow* m_activeWindow;
 
+    // 分块差分编码：只发送变化的64x64块，定期整屏刷新
+    TileDeltaEncoder m_encoder;
+
     QPixmap captureFullScreen();
     QPixmap captureActiveWindow();
     QPixmap captureSelectedArea();
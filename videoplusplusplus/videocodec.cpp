@@ -0,0 +1,354 @@
+// ===============================================
+// codec/video_codec.cpp
+// 视频编解码器实现
+// ===============================================
+
+#include "videocodec.h"
+#include <QBuffer>
+#include <QDataStream>
+#include <QtMath>
+#include <cstring>
+
+namespace {
+
+QByteArray encodeJpeg(const QImage& image, int quality) {
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    image.save(&buffer, "JPEG", quality);
+    return data;
+}
+
+// 按块复制像素（两幅图均为RGB32），越界部分由调用方裁剪
+void copyTile(const QImage& src, int sx, int sy, QImage& dst, int dx, int dy, int w, int h) {
+    for (int y = 0; y < h; ++y) {
+        const uchar* from = src.constScanLine(sy + y) + sx * 4;
+        uchar* to = dst.scanLine(dy + y) + dx * 4;
+        memcpy(to, from, static_cast<size_t>(w) * 4);
+    }
+}
+
+} // namespace
+
+int TileDeltaFormat::atlasColumns(int tileCount) {
+    return qMax(1, static_cast<int>(qCeil(qSqrt(static_cast<qreal>(tileCount)))));
+}
+
+// ---------------- JPEG ----------------
+
+JpegVideoEncoder::JpegVideoEncoder()
+    : m_quality(80)
+{
+}
+
+bool JpegVideoEncoder::encode(const QImage& image, EncodedVideoFrame& out) {
+    out.data = encodeJpeg(image, m_quality);
+    out.keyFrame = true;
+    out.width = image.width();
+    out.height = image.height();
+    return !out.data.isEmpty();
+}
+
+bool JpegVideoDecoder::decode(const QByteArray& data, bool keyFrame, QImage& out) {
+    Q_UNUSED(keyFrame)
+    return out.loadFromData(data, "JPEG");
+}
+
+// ---------------- 分块差分 ----------------
+
+TileDeltaEncoder::TileDeltaEncoder(int tileSize, ChangeDetection detection)
+    : m_tileSize(qMax(16, (tileSize + 15) / 16 * 16))   // 对齐JPEG的16x16 MCU，图集中的块互不串扰
+    , m_detection(detection)
+    , m_quality(80)
+    , m_keyFrameInterval(60)
+    , m_changeThreshold(6)
+    , m_framesSinceKey(0)
+    , m_forceKeyFrame(true)
+{
+}
+
+void TileDeltaEncoder::setKeyFrameInterval(int frames) {
+    m_keyFrameInterval = qMax(1, frames);
+}
+
+bool TileDeltaEncoder::encode(const QImage& image, EncodedVideoFrame& out) {
+    if (image.isNull()) {
+        return false;
+    }
+
+    const QImage frame = image.format() == QImage::Format_RGB32
+                       ? image : image.convertToFormat(QImage::Format_RGB32);
+    const int width = frame.width();
+    const int height = frame.height();
+    const int cols = (width + m_tileSize - 1) / m_tileSize;
+    const int rows = (height + m_tileSize - 1) / m_tileSize;
+
+    const bool keyFrame = m_forceKeyFrame
+                       || m_referenceSize != frame.size()
+                       || ++m_framesSinceKey >= m_keyFrameInterval;
+
+    QVector<QPoint> changed;
+    QVector<quint64> hashes;
+    QByteArray jpeg;
+
+    if (keyFrame) {
+        jpeg = encodeJpeg(frame, m_quality);
+        if (jpeg.isEmpty()) {
+            return false;
+        }
+        resetReference(frame, cols, rows);
+        m_framesSinceKey = 0;
+        m_forceKeyFrame = false;
+    } else {
+        for (int row = 0; row < rows; ++row) {
+            for (int col = 0; col < cols; ++col) {
+                quint64 hash = 0;
+                if (detectChange(frame, col, row, cols, hash)) {
+                    changed.append(QPoint(col, row));
+                    hashes.append(hash);
+                }
+            }
+        }
+
+        if (!changed.isEmpty()) {
+            const int atlasCols = TileDeltaFormat::atlasColumns(changed.size());
+            const int atlasRows = (changed.size() + atlasCols - 1) / atlasCols;
+            QImage atlas(atlasCols * m_tileSize, atlasRows * m_tileSize, QImage::Format_RGB32);
+            atlas.fill(Qt::black);
+
+            for (int i = 0; i < changed.size(); ++i) {
+                const int x = changed[i].x() * m_tileSize;
+                const int y = changed[i].y() * m_tileSize;
+                copyTile(frame, x, y, atlas,
+                         (i % atlasCols) * m_tileSize, (i / atlasCols) * m_tileSize,
+                         qMin(m_tileSize, width - x), qMin(m_tileSize, height - y));
+            }
+
+            jpeg = encodeJpeg(atlas, m_quality);
+            if (jpeg.isEmpty()) {
+                return false;
+            }
+            commitTiles(frame, changed, hashes, cols);
+        }
+    }
+
+    out.data.clear();
+    out.data.reserve(TileDeltaFormat::HEADER_SIZE + changed.size() * 4 + 4 + jpeg.size());
+    QDataStream ds(&out.data, QIODevice::WriteOnly);
+    ds.setByteOrder(QDataStream::BigEndian);
+
+    ds << TileDeltaFormat::MAGIC
+       << TileDeltaFormat::VERSION
+       << quint8(keyFrame ? TileDeltaFormat::FLAG_KEY_FRAME : 0)
+       << quint16(width) << quint16(height)
+       << quint16(m_tileSize) << quint16(changed.size());
+    for (const QPoint& tile : changed) {
+        ds << quint16(tile.x()) << quint16(tile.y());
+    }
+    ds << quint32(jpeg.size());
+    ds.writeRawData(jpeg.constData(), jpeg.size());
+
+    out.keyFrame = keyFrame;
+    out.width = width;
+    out.height = height;
+    return true;
+}
+
+bool TileDeltaEncoder::detectChange(const QImage& image, int col, int row, int cols, quint64& hash) const {
+    const int x = col * m_tileSize;
+    const int y = row * m_tileSize;
+    const int w = qMin(m_tileSize, image.width() - x);
+    const int h = qMin(m_tileSize, image.height() - y);
+
+    if (m_detection == ChangeDetection::CHECKSUM) {
+        hash = tileChecksum(image, x, y, w, h);
+        return hash != m_tileHashes[row * cols + col];
+    }
+
+    return pixelsChanged(image, x, y, w, h);
+}
+
+void TileDeltaEncoder::commitTiles(const QImage& image, const QVector<QPoint>& changed,
+                                   const QVector<quint64>& hashes, int cols) {
+    for (int i = 0; i < changed.size(); ++i) {
+        const int col = changed[i].x();
+        const int row = changed[i].y();
+
+        if (m_detection == ChangeDetection::CHECKSUM) {
+            m_tileHashes[row * cols + col] = hashes[i];
+            continue;
+        }
+
+        // 参考帧只在块发送后更新，缓慢漂移会累积到阈值后再发送
+        const int x = col * m_tileSize;
+        const int y = row * m_tileSize;
+        copyTile(image, x, y, m_reference, x, y,
+                 qMin(m_tileSize, image.width() - x), qMin(m_tileSize, image.height() - y));
+    }
+}
+
+bool TileDeltaEncoder::pixelsChanged(const QImage& image, int x, int y, int w, int h) const {
+    const int limit = m_changeThreshold * w * h;
+    int diff = 0;
+    for (int i = 0; i < h; ++i) {
+        const QRgb* cur = reinterpret_cast<const QRgb*>(image.constScanLine(y + i)) + x;
+        const QRgb* ref = reinterpret_cast<const QRgb*>(m_reference.constScanLine(y + i)) + x;
+        if (memcmp(cur, ref, static_cast<size_t>(w) * sizeof(QRgb)) == 0) {
+            continue;
+        }
+        for (int j = 0; j < w; ++j) {
+            diff += qAbs(qRed(cur[j]) - qRed(ref[j]))
+                  + qAbs(qGreen(cur[j]) - qGreen(ref[j]))
+                  + qAbs(qBlue(cur[j]) - qBlue(ref[j]));
+        }
+        if (diff > limit) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TileDeltaEncoder::resetReference(const QImage& image, int cols, int rows) {
+    m_referenceSize = image.size();
+
+    if (m_detection == ChangeDetection::PIXEL_DIFF) {
+        m_reference = image.copy();
+        return;
+    }
+
+    m_tileHashes.resize(cols * rows);
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            const int x = col * m_tileSize;
+            const int y = row * m_tileSize;
+            m_tileHashes[row * cols + col] = tileChecksum(image, x, y,
+                                                          qMin(m_tileSize, image.width() - x),
+                                                          qMin(m_tileSize, image.height() - y));
+        }
+    }
+}
+
+quint64 TileDeltaEncoder::tileChecksum(const QImage& image, int x, int y, int w, int h) {
+    // Fletcher式双累加器，按4路交错处理像素；各路互不依赖，便于SIMD展开
+    quint32 a[4] = { 1, 1, 1, 1 };
+    quint32 b[4] = { 0, 0, 0, 0 };
+
+    for (int i = 0; i < h; ++i) {
+        const quint32* p = reinterpret_cast<const quint32*>(image.constScanLine(y + i)) + x;
+        int j = 0;
+        for (; j + 4 <= w; j += 4) {
+            for (int k = 0; k < 4; ++k) {
+                a[k] += p[j + k] & 0x00ffffff;
+                b[k] += a[k];
+            }
+        }
+        for (; j < w; ++j) {
+            a[0] += p[j] & 0x00ffffff;
+            b[0] += a[0];
+        }
+        // 行尾混入行号，避免整行平移得到相同摘要
+        b[i & 3] ^= static_cast<quint32>(i) * 0x9e3779b1u;
+    }
+
+    quint64 hash = 0xcbf29ce484222325ull;
+    for (int k = 0; k < 4; ++k) {
+        hash = (hash ^ a[k]) * 0x100000001b3ull;
+        hash = (hash ^ b[k]) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+bool TileDeltaDecoder::decode(const QByteArray& data, bool keyFrame, QImage& out) {
+    Q_UNUSED(keyFrame)  // 码流自带关键帧标记
+
+    if (data.size() < TileDeltaFormat::HEADER_SIZE) {
+        return false;
+    }
+
+    QDataStream ds(data);
+    ds.setByteOrder(QDataStream::BigEndian);
+
+    quint16 magic = 0, width = 0, height = 0, tileSize = 0, tileCount = 0;
+    quint8 version = 0, flags = 0;
+    ds >> magic >> version >> flags >> width >> height >> tileSize >> tileCount;
+    if (magic != TileDeltaFormat::MAGIC || version != TileDeltaFormat::VERSION || tileSize == 0) {
+        return false;
+    }
+
+    QVector<QPoint> tiles(tileCount);
+    for (int i = 0; i < tileCount; ++i) {
+        quint16 col = 0, row = 0;
+        ds >> col >> row;
+        tiles[i] = QPoint(col, row);
+    }
+
+    quint32 jpegSize = 0;
+    ds >> jpegSize;
+    if (ds.status() != QDataStream::Ok || jpegSize > quint32(data.size() - ds.device()->pos())) {
+        return false;
+    }
+    // 只在本函数内读取，直接引用原数据
+    const QByteArray jpeg = QByteArray::fromRawData(data.constData() + ds.device()->pos(), static_cast<int>(jpegSize));
+
+    if (flags & TileDeltaFormat::FLAG_KEY_FRAME) {
+        QImage frame;
+        if (!frame.loadFromData(jpeg, "JPEG")) {
+            return false;
+        }
+        m_canvas = frame.convertToFormat(QImage::Format_RGB32);
+        out = m_canvas;
+        return true;
+    }
+
+    // 差分帧需要与之匹配的参考帧
+    if (m_canvas.isNull() || m_canvas.width() != width || m_canvas.height() != height) {
+        return false;
+    }
+
+    if (!tiles.isEmpty()) {
+        QImage atlas;
+        if (!atlas.loadFromData(jpeg, "JPEG")) {
+            return false;
+        }
+        atlas = atlas.convertToFormat(QImage::Format_RGB32);
+
+        const int atlasCols = TileDeltaFormat::atlasColumns(tiles.size());
+        const int ts = tileSize;
+        for (int i = 0; i < tiles.size(); ++i) {
+            const int x = tiles[i].x() * ts;
+            const int y = tiles[i].y() * ts;
+            const int ax = (i % atlasCols) * ts;
+            const int ay = (i / atlasCols) * ts;
+            if (x >= width || y >= height || ax + ts > atlas.width() || ay + ts > atlas.height()) {
+                continue;
+            }
+            copyTile(atlas, ax, ay, m_canvas, x, y, qMin(ts, width - x), qMin(ts, height - y));
+        }
+    }
+
+    out = m_canvas;
+    return true;
+}
+
+// ---------------- 工厂 ----------------
+
+VideoEncoder* VideoCodecFactory::createEncoder(VideoCodec codec) {
+    switch (codec) {
+    case VideoCodec::TILE_DELTA:
+        return new TileDeltaEncoder();
+    case VideoCodec::JPEG:
+    default:
+        return new JpegVideoEncoder();
+    }
+}
+
+VideoDecoder* VideoCodecFactory::createDecoder(VideoCodec codec) {
+    switch (codec) {
+    case VideoCodec::TILE_DELTA:
+        return new TileDeltaDecoder();
+    case VideoCodec::JPEG:
+        return new JpegVideoDecoder();
+    default:
+        return nullptr;
+    }
+}
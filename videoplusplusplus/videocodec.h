@@ -0,0 +1,159 @@
+// ===============================================
+// codec/video_codec.h
+// 视频编解码器
+// ===============================================
+
+#pragma once
+
+#include <QByteArray>
+#include <QImage>
+#include <QVector>
+#include <QPoint>
+#include "protocol.h"
+
+// 编码结果
+struct EncodedVideoFrame {
+    QByteArray data;
+    bool keyFrame;
+    int width;
+    int height;
+
+    EncodedVideoFrame() : keyFrame(true), width(0), height(0) {}
+};
+
+// 编码器接口
+class VideoEncoder {
+public:
+    virtual ~VideoEncoder() {}
+
+    virtual VideoCodec codec() const = 0;
+    virtual const char* formatName() const = 0;
+
+    // 编码一帧；返回false表示编码失败
+    virtual bool encode(const QImage& image, EncodedVideoFrame& out) = 0;
+
+    // 下一帧强制输出关键帧
+    virtual void requestKeyFrame() {}
+
+    // 关键帧间隔（帧数），帧内编码器忽略
+    virtual void setKeyFrameInterval(int frames) { Q_UNUSED(frames) }
+    virtual void setQuality(int quality) = 0;
+};
+
+// 解码器接口
+class VideoDecoder {
+public:
+    virtual ~VideoDecoder() {}
+
+    virtual VideoCodec codec() const = 0;
+
+    // 解码一帧；参考帧缺失（如中途加入）时返回false，等待下一个关键帧
+    // out 可能与解码器内部画布隐式共享：调用方在解码下一帧前应释放它，否则写入差分块时整幅拷贝
+    virtual bool decode(const QByteArray& data, bool keyFrame, QImage& out) = 0;
+
+    // 丢弃参考帧
+    virtual void reset() {}
+};
+
+// 逐帧JPEG编码器（原有行为）
+class JpegVideoEncoder : public VideoEncoder {
+public:
+    JpegVideoEncoder();
+
+    VideoCodec codec() const override { return VideoCodec::JPEG; }
+    const char* formatName() const override { return "jpeg"; }
+    bool encode(const QImage& image, EncodedVideoFrame& out) override;
+    void setQuality(int quality) override { m_quality = quality; }
+
+private:
+    int m_quality;
+};
+
+class JpegVideoDecoder : public VideoDecoder {
+public:
+    VideoCodec codec() const override { return VideoCodec::JPEG; }
+    bool decode(const QByteArray& data, bool keyFrame, QImage& out) override;
+};
+
+// 分块差分编码器
+// 关键帧为整帧JPEG；其余帧只发送与参考帧相比发生变化的块，
+// 变化块拼成一张图集后统一JPEG编码，避免每块重复携带JPEG头和码表。
+//
+// 码流格式（大端）：
+//   magic(2) version(1) flags(1) width(2) height(2) tileSize(2) tileCount(2)
+//   tileCount × [col(2) row(2)]
+//   jpegSize(4) jpeg
+class TileDeltaEncoder : public VideoEncoder {
+public:
+    // 变化检测方式
+    enum class ChangeDetection {
+        PIXEL_DIFF,     // 与参考像素比较差异，容忍噪声（摄像头）
+        CHECKSUM        // 比较块校验和，只保存每块的摘要（屏幕内容）
+    };
+
+    explicit TileDeltaEncoder(int tileSize = 32,
+                              ChangeDetection detection = ChangeDetection::PIXEL_DIFF);
+
+    VideoCodec codec() const override { return VideoCodec::TILE_DELTA; }
+    const char* formatName() const override { return "tdelta"; }
+    bool encode(const QImage& image, EncodedVideoFrame& out) override;
+    void requestKeyFrame() override { m_forceKeyFrame = true; }
+    void setKeyFrameInterval(int frames) override;
+    void setQuality(int quality) override { m_quality = quality; }
+
+    // 块内平均每像素差异超过阈值才视为变化，用于滤除摄像头噪声
+    void setChangeThreshold(int threshold) { m_changeThreshold = threshold; }
+
+    // 块校验和：4路独立累加，编译器可自动向量化
+    static quint64 tileChecksum(const QImage& image, int x, int y, int w, int h);
+
+private:
+    // 检测块是否变化，不修改参考数据；CHECKSUM 模式下通过 hash 返回本块校验和
+    bool detectChange(const QImage& image, int col, int row, int cols, quint64& hash) const;
+    // 差分帧编码成功后才把变化块写入参考数据，编码失败时下一帧仍会重发这些块
+    void commitTiles(const QImage& image, const QVector<QPoint>& changed,
+                     const QVector<quint64>& hashes, int cols);
+    bool pixelsChanged(const QImage& image, int x, int y, int w, int h) const;
+    void resetReference(const QImage& image, int cols, int rows);
+
+    int m_tileSize;
+    ChangeDetection m_detection;
+    int m_quality;
+    int m_keyFrameInterval;
+    int m_changeThreshold;
+    int m_framesSinceKey;
+    bool m_forceKeyFrame;
+    QSize m_referenceSize;
+    QImage m_reference;             // 接收端当前显示内容对应的源图像（PIXEL_DIFF）
+    QVector<quint64> m_tileHashes;  // 每块最近一次发送时的校验和（CHECKSUM）
+};
+
+class TileDeltaDecoder : public VideoDecoder {
+public:
+    VideoCodec codec() const override { return VideoCodec::TILE_DELTA; }
+    bool decode(const QByteArray& data, bool keyFrame, QImage& out) override;
+    void reset() override { m_canvas = QImage(); }
+
+    // 以外部画面作为后续差分帧的参考，如录制文件中途开始时补写的JPEG参考帧
+    void setReference(const QImage& image) { m_canvas = image.convertToFormat(QImage::Format_RGB32); }
+
+private:
+    QImage m_canvas;
+};
+
+// 编解码器工厂
+class VideoCodecFactory {
+public:
+    static VideoEncoder* createEncoder(VideoCodec codec);
+    static VideoDecoder* createDecoder(VideoCodec codec);
+};
+
+namespace TileDeltaFormat {
+    const quint16 MAGIC = 0x5444;   // "TD"
+    const quint8 VERSION = 1;
+    const quint8 FLAG_KEY_FRAME = 0x01;
+    const int HEADER_SIZE = 12;
+
+    // 图集排布：按近似正方形排列变化块
+    int atlasColumns(int tileCount);
+}
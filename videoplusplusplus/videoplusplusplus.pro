@@ -24,10 +24,13 @@ SOURCES += \
     avreceiver.cpp \
     avsender.cpp \
     chatmodel.cpp \
+    framedecoder.cpp \
     main.cpp \
     mainwindow.cpp \
     protocol.cpp \
     screencapture.cpp \
+    recordwriter.cpp \
+    videocodec.cpp \
     videorecorder.cpp
 
 HEADERS += \
@@ -36,9 +39,12 @@ HEADERS += \
     avreceiver.h \
     avsender.h \
     chatmodel.h \
+    framedecoder.h \
     mainwindow.h \
     protocol.h \
     screencapture.h \
+    recordwriter.h \
+    videocodec.h \
     videorecorder.h
 
 FORMS += \
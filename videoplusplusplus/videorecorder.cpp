@@ -10,10 +10,13 @@
 #include <QTimer>
 #include <QBuffer>
 #include <QJsonArray>
+#include <QtEndian>
+#include <cstring>
 
 VideoRecorder::VideoRecorder(QObject* parent)
     : QObject(parent)
-    , m_recordFile(nullptr)
+    , m_writer(nullptr)
+    , m_writerErrorReported(false)
     , m_isRecording(false)
     , m_videoFrameCount(0)
     , m_audioFrameCount(0)
@@ -44,15 +47,13 @@ bool VideoRecorder::startRecording(const QString& basePath) {
         filePath = dir.filePath(QFileInfo(filePath).fileName());
     }
 
-    m_recordFile = new QFile(filePath);
-    if (!m_recordFile->open(QIODevice::WriteOnly)) {
+    RecordWriter* writer = new RecordWriter(m_writerOptions);
+    if (!writer->open(filePath)) {
         emit recordingError("无法创建录制文件: " + filePath);
-        delete m_recordFile;
-        m_recordFile = nullptr;
+        delete writer;
         return false;
     }
 
-    m_isRecording = true;
     m_currentFilePath = filePath;
     m_startTime = QDateTime::currentDateTime();
     m_videoFrameCount = 0;
@@ -60,11 +61,26 @@ bool VideoRecorder::startRecording(const QString& basePath) {
     m_screenFrameCount = 0;
     m_textMessageCount = 0;
     m_totalDataSize = 0;
+    m_writerErrorReported = false;
+    {
+        QMutexLocker locker(&m_streamMutex);
+        m_referencedStreams.clear();
+        m_streamIds.clear();
+        m_streamDeclarations = QJsonArray();
+    }
 
-    if (!writeHeader()) {
-        stopRecording();
+    // 文件头必须是第一条记录，写入后才发布写线程并打开录制开关
+    if (!writeHeader(writer)) {
+        writer->close();
+        delete writer;
+        emit recordingError("无法写入录制文件头: " + filePath);
         return false;
     }
+    {
+        QWriteLocker locker(&m_writerLock);
+        m_writer = writer;
+    }
+    m_isRecording.store(true, std::memory_order_release);
 
     m_statsTimer->start();
     emit recordingStarted(filePath);
@@ -74,26 +90,32 @@ bool VideoRecorder::startRecording(const QString& basePath) {
 }
 
 void VideoRecorder::stopRecording() {
-    if (!m_isRecording) return;
+    if (!m_isRecording.exchange(false, std::memory_order_acq_rel)) return;
 
     m_statsTimer->stop();
+    qint64 duration = m_startTime.msecsTo(QDateTime::currentDateTime());
+
+    // 摘下写线程：写锁会等正在 writeFrame 的解码线程放下读锁，之后不会再有人访问它
+    RecordWriter* writer = nullptr;
+    {
+        QWriteLocker locker(&m_writerLock);
+        writer = m_writer;
+        m_writer = nullptr;
+    }
+    if (!writer) return;
 
-    if (m_recordFile) {
-        writeTrailer();
-        m_recordFile->close();
-
-        qint64 duration = recordingDuration();
-        qint64 size = m_recordFile->size();
-
-        delete m_recordFile;
-        m_recordFile = nullptr;
-
-        emit recordingStopped(m_currentFilePath, duration, size);
+    writeTrailer(writer);
+    writer->close();
 
-        qDebug() << "Recording stopped. Duration:" << duration << "ms, Size:" << size << "bytes";
+    qint64 size = writer->bytesWritten();
+    if (writer->droppedCount() > 0) {
+        qDebug() << "Recording dropped" << writer->droppedCount() << "frames";
     }
+    delete writer;
+
+    emit recordingStopped(m_currentFilePath, duration, size);
 
-    m_isRecording = false;
+    qDebug() << "Recording stopped. Duration:" << duration << "ms, Size:" << size << "bytes";
 }
 
 void VideoRecorder::recordVideoFrame(const QImage& frame, uint32_t roomId, uint64_t timestamp) {
@@ -104,11 +126,11 @@ void VideoRecorder::recordVideoFrame(const QImage& frame, uint32_t roomId, uint6
     buffer.open(QIODevice::WriteOnly);
     frame.save(&buffer, "JPEG", 80);
 
-    QJsonObject metadata = createFrameMetadata(roomId, timestamp, frame.size());
-    metadata["type"] = "video";
-    metadata["fps"] = 0; // 将在后期处理时计算
+    const QString name = getStreamName(StreamType::LOCAL_VIDEO);
+    const FrameHeader header = videoFrameHeader(MsgType::VIDEO_FRAME, StreamType::LOCAL_VIDEO, name,
+                                                roomId, timestamp, frame.size());
 
-    if (writeFrame(MsgType::VIDEO_FRAME, frameData, metadata)) {
+    if (writeFrame(header, frameData, RecordWriter::Priority::DROPPABLE)) {
         m_videoFrameCount++;
         m_totalDataSize += frameData.size();
     }
@@ -117,19 +139,21 @@ void VideoRecorder::recordVideoFrame(const QImage& frame, uint32_t roomId, uint6
 void VideoRecorder::recordAudioFrame(const QByteArray& audioData, const AudioFormatInfo& format, uint32_t roomId, uint64_t timestamp) {
     if (!m_isRecording) return;
 
-    QJsonObject metadata = createFrameMetadata(roomId, timestamp);
-    metadata["type"] = "audio";
-    metadata["sampleRate"] = format.sampleRate;
-    metadata["channelCount"] = format.channelCount;
-    metadata["sampleSize"] = format.sampleSize;
+    FrameHeader header;
+    header.type = MsgType::AUDIO_FRAME;
+    header.mediaTimestamp = timestamp;
+    header.roomId = roomId;
+    header.param1 = static_cast<quint32>(format.sampleRate);
+    header.param2 = static_cast<quint32>(format.channelCount) | (static_cast<quint32>(format.sampleSize) << 8);
 
-    if (writeFrame(MsgType::AUDIO_FRAME, audioData, metadata)) {
+    if (writeFrame(header, audioData)) {
         m_audioFrameCount++;
         m_totalDataSize += audioData.size();
     }
 }
 
 void VideoRecorder::recordScreenFrame(const QImage& frame, uint32_t roomId, uint64_t timestamp, ScreenCaptureMode mode) {
+    Q_UNUSED(mode)
     if (!m_isRecording) return;
 
     QByteArray frameData;
@@ -137,12 +161,11 @@ void VideoRecorder::recordScreenFrame(const QImage& frame, uint32_t roomId, uint
     buffer.open(QIODevice::WriteOnly);
     frame.save(&buffer, "JPEG", 80);
 
-    QJsonObject metadata = createFrameMetadata(roomId, timestamp, frame.size());
-    metadata["type"] = "screen";
-    metadata["captureMode"] = static_cast<int>(mode);
-    metadata["fps"] = 0;
+    const QString name = getStreamName(StreamType::LOCAL_SCREEN);
+    const FrameHeader header = videoFrameHeader(MsgType::SCREEN_FRAME, StreamType::LOCAL_SCREEN, name,
+                                                roomId, timestamp, frame.size());
 
-    if (writeFrame(MsgType::SCREEN_FRAME, frameData, metadata)) {
+    if (writeFrame(header, frameData, RecordWriter::Priority::DROPPABLE)) {
         m_screenFrameCount++;
         m_totalDataSize += frameData.size();
     }
@@ -162,7 +185,12 @@ void VideoRecorder::recordTextMessage(const TextMessage& message) {
     QJsonDocument doc(metadata);
     QByteArray jsonData = doc.toJson(QJsonDocument::Compact);
 
-    if (writeFrame(MsgType::TEXT_MESSAGE, jsonData)) {
+    FrameHeader header;
+    header.type = MsgType::TEXT_MESSAGE;
+    header.mediaTimestamp = static_cast<quint64>(message.timestamp.toMSecsSinceEpoch());
+    header.roomId = message.roomId;
+
+    if (writeFrame(header, jsonData)) {
         m_textMessageCount++;
         m_totalDataSize += jsonData.size();
     }
@@ -173,9 +201,9 @@ QString VideoRecorder::generateFileName() const {
     return QString("meeting_recording_%1.mtr").arg(timestamp);
 }
 
-bool VideoRecorder::writeHeader() {
+bool VideoRecorder::writeHeader(RecordWriter* writer) {
     QJsonObject header;
-        header["version"] = "2.0";
+        header["version"] = "3.0";   // 3.0: 二进制帧头，文件末尾带帧索引，见 MtrFormat
         header["format"] = "Multi-Stream Meeting Recording";
         header["startTime"] = static_cast<qint64>(m_startTime.toMSecsSinceEpoch());
         header["creator"] = "AV Chat System";
@@ -185,76 +213,76 @@ bool VideoRecorder::writeHeader() {
     QByteArray headerData = doc.toJson(QJsonDocument::Compact);
 
     // 写入头部长度和头部数据
-    quint32 headerLength = static_cast<quint32>(headerData.size());
-    QByteArray lengthData(reinterpret_cast<const char*>(&headerLength), sizeof(headerLength));
-
-    QMutexLocker locker(&m_fileMutex);
-    if (m_recordFile->write(lengthData) != sizeof(headerLength) ||
-        m_recordFile->write(headerData) != headerData.size()) {
-        return false;
-    }
+    QByteArray record(sizeof(quint32), Qt::Uninitialized);
+    qToLittleEndian<quint32>(static_cast<quint32>(headerData.size()), reinterpret_cast<uchar*>(record.data()));
+    record.append(headerData);
 
-    return true;
+    return writer->enqueue(record, RecordWriter::Priority::RELIABLE);
 }
 
-bool VideoRecorder::writeFrame(MsgType type, const QByteArray& data, const QJsonObject& metadata) {
-    QMutexLocker locker(&m_fileMutex);
-
-    // 写入帧类型
-    quint16 frameType = static_cast<quint16>(type);
-    if (m_recordFile->write(reinterpret_cast<const char*>(&frameType), sizeof(frameType)) != sizeof(frameType)) {
-        return false;
-    }
-
-    // 写入时间戳
-    quint64 timestamp = QDateTime::currentMSecsSinceEpoch();
-    if (m_recordFile->write(reinterpret_cast<const char*>(&timestamp), sizeof(timestamp)) != sizeof(timestamp)) {
-        return false;
-    }
-
-    // 写入元数据（如果有）
-    QByteArray metaData;
-    if (!metadata.isEmpty()) {
-        QJsonDocument doc(metadata);
-        metaData = doc.toJson(QJsonDocument::Compact);
-    }
-
-    quint32 metaSize = static_cast<quint32>(metaData.size());
-    if (m_recordFile->write(reinterpret_cast<const char*>(&metaSize), sizeof(metaSize)) != sizeof(metaSize)) {
-        return false;
-    }
-
-    if (metaSize > 0 && m_recordFile->write(metaData) != metaData.size()) {
-        return false;
-    }
-
-    // 写入数据长度和数据
-    quint32 dataSize = static_cast<quint32>(data.size());
-    if (m_recordFile->write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize)) != sizeof(dataSize)) {
-        return false;
-    }
+QByteArray VideoRecorder::serializeFrame(const FrameHeader& header, const QByteArray& data,
+                                         RecordIndexEntry& index) {
+    // 帧头和数据拼成一条记录，写线程整条写出
+    QByteArray record(MtrFormat::FRAME_HEADER_SIZE + data.size(), Qt::Uninitialized);
+    uchar* p = reinterpret_cast<uchar*>(record.data());
+    const quint64 timestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch());
+
+    qToLittleEndian<quint16>(static_cast<quint16>(header.type), p);
+    qToLittleEndian<quint64>(timestamp, p + MtrFormat::TIMESTAMP_OFFSET);
+    qToLittleEndian<quint16>(header.streamId, p + 10);
+    p[12] = header.flags;
+    p[13] = header.codec;
+    qToLittleEndian<quint64>(header.mediaTimestamp, p + 14);
+    qToLittleEndian<quint32>(header.roomId, p + 22);
+    qToLittleEndian<quint32>(header.param1, p + 26);
+    qToLittleEndian<quint32>(header.param2, p + 30);
+    qToLittleEndian<quint32>(static_cast<quint32>(data.size()), p + 34);
+    memcpy(p + MtrFormat::FRAME_HEADER_SIZE, data.constData(), static_cast<size_t>(data.size()));
+
+    index.timestamp = timestamp;
+    index.type = static_cast<quint16>(header.type);
+    index.streamId = header.streamId;
+    index.flags = header.flags;
+    return record;
+}
 
-    if (m_recordFile->write(data) != data.size()) {
-        return false;
-    }
+bool VideoRecorder::writeFrame(const FrameHeader& header, const QByteArray& data,
+                               RecordWriter::Priority priority) {
+    RecordIndexEntry index;
+    const QByteArray record = serializeFrame(header, data, index);
 
-    return true;
+    // 读锁期间 stopRecording 无法摘下并删除写线程
+    QReadLocker locker(&m_writerLock);
+    if (!m_writer) return false;
+    return m_writer->enqueue(record, priority, &index);
 }
 
-bool VideoRecorder::writeTrailer() {
+bool VideoRecorder::writeTrailer(RecordWriter* writer) {
     QJsonObject trailer;
     trailer["endTime"] = static_cast<qint64>(QDateTime::currentDateTime().toMSecsSinceEpoch());
     trailer["totalSize"] = static_cast<qint64>(m_totalDataSize);
+    trailer["droppedFrames"] = static_cast<qint64>(writer->droppedCount());
+    {
+        QMutexLocker locker(&m_streamMutex);
+        trailer["streams"] = m_streamDeclarations;
+    }
 
     // 添加流统计信息
     QJsonObject streamStats;
-    QMutexLocker locker(&m_statsMutex);
-    for (auto it = m_streamStats.constBegin(); it != m_streamStats.constEnd(); ++it) {
-        streamStats[it.key()] = it.value();
+    {
+        QMutexLocker locker(&m_statsMutex);
+        for (auto it = m_streamStats.constBegin(); it != m_streamStats.constEnd(); ++it) {
+            streamStats[it.key()] = it.value();
+        }
     }
     trailer["streamStats"] = streamStats;
 
-    return writeFrame(MsgType::RECORD_STOP, QByteArray(), trailer);
+    // 帧索引和文件尾由写线程在关闭时追加到结束帧之后
+    FrameHeader header;
+    header.type = MsgType::RECORD_STOP;
+    RecordIndexEntry index;
+    const QByteArray record = serializeFrame(header, QJsonDocument(trailer).toJson(QJsonDocument::Compact), index);
+    return writer->enqueue(record, RecordWriter::Priority::RELIABLE, &index);
 }
 
 qint64 VideoRecorder::recordingDuration() const {
@@ -269,17 +297,68 @@ qint64 VideoRecorder::recordedSize() const {
 void VideoRecorder::updateStats() {
     emit recordingStatsUpdated(recordingDuration(), m_totalDataSize,
                              m_videoFrameCount + m_screenFrameCount, m_audioFrameCount);
+
+    // m_writer 只在本线程替换，这里读取无需加锁
+    if (!m_writer) return;
+    emit writerStatsUpdated(m_writer->queueDepth(), m_writer->droppedCount());
+
+    // 写线程无法发信号到调用方线程，出错由统计定时器在本线程上报一次
+    if (m_writer->hasError() && !m_writerErrorReported) {
+        m_writerErrorReported = true;
+        emit recordingError(m_writer->errorString());
+    }
 }
 
-QJsonObject VideoRecorder::createFrameMetadata(uint32_t roomId, uint64_t timestamp, const QSize& size) {
-    QJsonObject metadata;
-    metadata["roomId"] = static_cast<int>(roomId);
-    metadata["timestamp"] = static_cast<qint64>(timestamp);
-    if (size.isValid()) {
-        metadata["width"] = size.width();
-        metadata["height"] = size.height();
+int VideoRecorder::writerQueueDepth() const {
+    return m_writer ? m_writer->queueDepth() : 0;
+}
+
+quint64 VideoRecorder::droppedFrameCount() const {
+    return m_writer ? m_writer->droppedCount() : 0;
+}
+
+VideoRecorder::FrameHeader VideoRecorder::videoFrameHeader(MsgType type, StreamType streamType,
+                                                           const QString& name, uint32_t roomId,
+                                                           uint64_t timestamp, const QSize& size) {
+    FrameHeader header;
+    header.type = type;
+    header.streamId = streamIdFor(streamType, name);
+    header.mediaTimestamp = timestamp;
+    header.roomId = roomId;
+    header.param1 = static_cast<quint32>(qMax(0, size.width()));
+    header.param2 = static_cast<quint32>(qMax(0, size.height()));
+    header.flags = MtrFormat::FLAG_KEY_FRAME;
+    if (streamType == StreamType::LOCAL_SCREEN || streamType == StreamType::REMOTE_SCREEN) {
+        header.flags |= MtrFormat::FLAG_SCREEN;
+    }
+    header.codec = static_cast<quint8>(VideoCodec::JPEG);
+    return header;
+}
+
+quint16 VideoRecorder::streamIdFor(StreamType streamType, const QString& name) {
+    QMutexLocker locker(&m_streamMutex);
+
+    auto it = m_streamIds.constFind(name);
+    if (it != m_streamIds.constEnd()) {
+        return it.value();
     }
-    return metadata;
+
+    const quint16 id = static_cast<quint16>(m_streamIds.size());
+    m_streamIds.insert(name, id);
+
+    QJsonObject declaration;
+    declaration["id"] = id;
+    declaration["name"] = name;
+    declaration["streamType"] = static_cast<int>(streamType);
+    declaration["isScreen"] = (streamType == StreamType::LOCAL_SCREEN || streamType == StreamType::REMOTE_SCREEN);
+    m_streamDeclarations.append(declaration);
+
+    // 持锁写入，保证声明帧排在该流第一帧之前
+    FrameHeader header;
+    header.type = MsgType::RECORD_DATA;
+    header.streamId = id;
+    writeFrame(header, QJsonDocument(declaration).toJson(QJsonDocument::Compact));
+    return id;
 }
 
 void VideoRecorder::recordVideoFrame(const QImage& frame, uint32_t roomId, uint64_t timestamp,
@@ -291,18 +370,61 @@ void VideoRecorder::recordVideoFrame(const QImage& frame, uint32_t roomId, uint6
     buffer.open(QIODevice::WriteOnly);
     frame.save(&buffer, "JPEG", 80);
 
-    QJsonObject metadata = createFrameMetadata(roomId, timestamp, frame.size());
-    metadata["type"] = "video";
-    metadata["streamType"] = static_cast<int>(streamType);
-    metadata["streamName"] = getStreamName(streamType, streamName);
-    metadata["isScreen"] = (streamType == StreamType::LOCAL_SCREEN || streamType == StreamType::REMOTE_SCREEN);
+    const QString name = getStreamName(streamType, streamName);
+    const FrameHeader header = videoFrameHeader(MsgType::VIDEO_FRAME, streamType, name,
+                                                roomId, timestamp, frame.size());
 
-    if (writeFrame(MsgType::VIDEO_FRAME, frameData, metadata)) {
-        updateStreamStats(metadata["streamName"].toString());
+    if (writeFrame(header, frameData, RecordWriter::Priority::DROPPABLE)) {
+        // JPEG帧即是回放端该流的完整画面，之后的差分帧可以直接写入
+        {
+            QMutexLocker locker(&m_streamMutex);
+            m_referencedStreams.insert(name);
+        }
+
+        updateStreamStats(name);
         m_totalDataSize += frameData.size();
     }
 }
 
+bool VideoRecorder::recordEncodedVideoFrame(const QByteArray& data, VideoCodec codec, bool keyFrame,
+                                            const QSize& size, uint32_t roomId, uint64_t timestamp,
+                                            StreamType streamType, const QString& streamName) {
+    if (!m_isRecording || data.isEmpty()) return false;
+
+    const QString name = getStreamName(streamType, streamName);
+    const bool selfContained = keyFrame || codec == VideoCodec::JPEG;
+
+    FrameHeader header = videoFrameHeader(MsgType::VIDEO_FRAME, streamType, name, roomId, timestamp, size);
+    header.codec = static_cast<quint8>(codec);
+    if (!selfContained) {
+        header.flags = static_cast<quint8>(header.flags & ~MtrFormat::FLAG_KEY_FRAME);
+    }
+
+    // 同一路流的帧只来自一个线程，判断与写入之间不会插入该流的其它帧
+    {
+        QMutexLocker locker(&m_streamMutex);
+        if (!selfContained && !m_referencedStreams.contains(name)) {
+            return false;
+        }
+    }
+
+    if (!writeFrame(header, data, RecordWriter::Priority::DROPPABLE)) {
+        // 丢帧后该流的差分链已断开，等下一帧参考帧重新开始
+        QMutexLocker locker(&m_streamMutex);
+        m_referencedStreams.remove(name);
+        return false;
+    }
+
+    if (selfContained) {
+        QMutexLocker locker(&m_streamMutex);
+        m_referencedStreams.insert(name);
+    }
+
+    updateStreamStats(name);
+    m_totalDataSize += data.size();
+    return true;
+}
+
 void VideoRecorder::recordRemoteVideoFrame(const QImage& frame, uint32_t roomId, uint64_t timestamp,
                                          const QString& streamName, bool isScreen) {
     StreamType type = isScreen ? StreamType::REMOTE_SCREEN : StreamType::REMOTE_VIDEO;
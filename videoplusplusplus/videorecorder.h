@@ -11,7 +11,34 @@
 #include <QImage>
 #include <QAudioFormat>
 #include <QMutex>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QHash>
+#include <QJsonArray>
+#include <atomic>
 #include "protocol.h"
+#include "recordwriter.h"
+
+// .mtr v3 容器格式（小端）
+//   文件头：headerLength(4) headerJson
+//   帧：type(2) timestamp(8) streamId(2) flags(1) codec(1) mediaTimestamp(8) roomId(4)
+//       param1(4) param2(4) dataSize(4) data
+//       视频 param1/param2 为宽/高；音频 param1 为采样率，param2 为 声道数 | 采样位数 << 8
+//   流声明帧（RECORD_DATA）：数据为 {"id","name","streamType","isScreen"}，流首次出现时写入
+//   结束帧（RECORD_STOP）：数据为结束信息JSON，其中 streams 为全部流声明
+//   索引：entryCount × [timestamp(8) offset(8) type(2) streamId(2) flags(1) reserved(3)]
+//   文件尾：indexOffset(8) entryCount(4) magic(4)
+// v2 的帧为 type(2) timestamp(8) metaSize(4) metaJson dataSize(4) data，回放端仍兼容
+namespace MtrFormat {
+    const quint32 FOOTER_MAGIC = 0x5852544D;    // "MTRX"
+    const int FRAME_HEADER_SIZE = 38;
+    const int TIMESTAMP_OFFSET = 2;             // 帧头中写入时间戳的位置
+    const int INDEX_ENTRY_SIZE = 24;
+    const int FOOTER_SIZE = 16;
+    const quint16 NO_STREAM = 0xFFFF;
+    const quint8 FLAG_KEY_FRAME = 0x01;
+    const quint8 FLAG_SCREEN = 0x02;
+}
 
 // 视频流类型
 enum class StreamType {
@@ -30,7 +57,8 @@ public:
 
     bool startRecording(const QString& basePath = "");
     void stopRecording();
-    bool isRecording() const { return m_isRecording; }
+    // 开始/停止录制只在界面线程调用；各 record* 方法可在解码线程并发调用
+    bool isRecording() const { return m_isRecording.load(std::memory_order_acquire); }
 
     void recordVideoFrame(const QImage& frame, uint32_t roomId, uint64_t timestamp);
     void recordAudioFrame(const QByteArray& audioData, const AudioFormatInfo& format, uint32_t roomId, uint64_t timestamp);
@@ -47,9 +75,21 @@ public:
     void recordLocalVideoFrame(const QImage& frame, uint32_t roomId, uint64_t timestamp,
                               bool isScreen = false);
 
+    // 直接写入收发时已有的编码数据（JPEG或分块差分），不解码也不重新编码。
+    // 差分帧依赖同一路流之前的画面：该流在本次录制中还没有参考帧时不写入并返回false，
+    // 调用方应改用 recordVideoFrame(QImage, ...) 写入一帧JPEG作为参考
+    bool recordEncodedVideoFrame(const QByteArray& data, VideoCodec codec, bool keyFrame,
+                                 const QSize& size, uint32_t roomId, uint64_t timestamp,
+                                 StreamType streamType, const QString& streamName = "");
+
     // 获取录制统计
     QMap<QString, int> getStreamStats() const;
 
+    // 写线程参数，下次开始录制时生效
+    void setWriterOptions(const RecordWriterOptions& options) { m_writerOptions = options; }
+    int writerQueueDepth() const;
+    quint64 droppedFrameCount() const;
+
 
 signals:
     void recordingStarted(const QString& filePath);
@@ -57,13 +97,18 @@ signals:
     void recordingError(const QString& error);
     void recordingStatsUpdated(qint64 duration, qint64 size, int videoFrames, int audioFrames);
     void streamStatsUpdated(const QMap<QString, int>& stats);
+    void writerStatsUpdated(int queueDepth, quint64 droppedFrames);
 private slots:
     void updateStats();
 
 private:
-    QFile* m_recordFile;
-    mutable QMutex m_fileMutex;
-    bool m_isRecording;
+    // 只由界面线程替换（持写锁）；其他线程持读锁写入，停止录制时等它们写完再关闭写线程
+    RecordWriter* m_writer;
+    mutable QReadWriteLock m_writerLock;
+    RecordWriterOptions m_writerOptions;
+    bool m_writerErrorReported;
+    mutable QMutex m_streamMutex;
+    std::atomic<bool> m_isRecording;
     QString m_currentFilePath;
     QDateTime m_startTime;
 
@@ -71,16 +116,39 @@ private:
     int m_audioFrameCount;
     int m_screenFrameCount;
     int m_textMessageCount;
-    qint64 m_totalDataSize;
+    std::atomic<qint64> m_totalDataSize;   // 接收端解码线程也会写入
 
     QTimer* m_statsTimer;
 
+    // 二进制帧头字段（见 MtrFormat）
+    struct FrameHeader {
+        MsgType type = MsgType::RECORD_DATA;
+        quint16 streamId = MtrFormat::NO_STREAM;
+        quint8 flags = 0;
+        quint8 codec = 0;
+        quint64 mediaTimestamp = 0;
+        quint32 roomId = 0;
+        quint32 param1 = 0;
+        quint32 param2 = 0;
+    };
+
     QString generateFileName() const;
-    bool writeHeader();
-    bool writeFrame(MsgType type, const QByteArray& data, const QJsonObject& metadata = QJsonObject());
-    bool writeTrailer();
-    QJsonObject createFrameMetadata(uint32_t roomId, uint64_t timestamp, const QSize& size = QSize());
+    // 文件头和结束帧在写线程发布前/摘下后直接写入，不经过 m_writerLock
+    bool writeHeader(RecordWriter* writer);
+    bool writeTrailer(RecordWriter* writer);
+    // 帧头和数据拼成一条完整记录，并填写帧索引项
+    static QByteArray serializeFrame(const FrameHeader& header, const QByteArray& data, RecordIndexEntry& index);
+    // 序列化后交给当前写线程并登记帧索引；未在录制或队列满丢弃时返回false
+    bool writeFrame(const FrameHeader& header, const QByteArray& data,
+                    RecordWriter::Priority priority = RecordWriter::Priority::RELIABLE);
+    FrameHeader videoFrameHeader(MsgType type, StreamType streamType, const QString& name,
+                                 uint32_t roomId, uint64_t timestamp, const QSize& size);
+    // 返回流编号，流首次出现时先写入流声明帧
+    quint16 streamIdFor(StreamType streamType, const QString& name);
     QMap<QString, int> m_streamStats; // 流统计: 流名称 -> 帧数
+    QSet<QString> m_referencedStreams; // 已写入参考帧的流（受 m_streamMutex 保护）
+    QHash<QString, quint16> m_streamIds; // 流名称 -> 流编号（受 m_streamMutex 保护）
+    QJsonArray m_streamDeclarations;     // 写入结束帧的流声明（受 m_streamMutex 保护）
     mutable QMutex m_statsMutex;
 
     QString getStreamName(StreamType type, const QString& customName = "") const;